@@ -0,0 +1,61 @@
+extends Label
+
+const PRIVATE_KEY = "37e17f7c0e6d14ad7bf694051b84b2572d638d875b0bb745bb151754de838d00"
+
+func _build_tx(nonce: int) -> LegacyTx:
+	var tx = LegacyTx.new()
+	tx.set_nonce(nonce)
+	var gas_price = BigInt.new()
+	gas_price.from_string("20000000000")
+	tx.set_gas_price(gas_price)
+	tx.set_gas_limit(21000)
+	var value = BigInt.new()
+	value.from_string("1000000000000000000")
+	tx.set_value(value)
+	var chain_id = BigInt.new()
+	chain_id.from_string("31337")
+	tx.set_chain_id(chain_id)
+	tx.set_to_address("0x3535353535353535353535353535353535353535")
+	return tx
+
+# The test case
+func test_expected_behavior():
+	print("------> start test batch signer <------")
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var txs = []
+	for i in range(32):
+		txs.append(_build_tx(1000 + i))
+
+	var raws = BatchSigner.sign_transactions(txs, account)
+	assert(raws.size() == 32, "sign_transactions size incorrect")
+	for i in range(32):
+		var expected = _build_tx(1000 + i)
+		assert(expected.sign_tx_by_account(account) == 0, "sign_tx_by_account failed!")
+		assert(raws[i] == expected.signedtx_marshal_binary(), "batch signature differs from single signature")
+		assert(txs[i].signedtx_marshal_binary() == raws[i], "signature not applied to transaction")
+	print("pass: sign_transactions")
+
+	var senders = TransactionDecoder.recover_senders(Array(raws).map(func(raw): return raw.substr(2).hex_decode()))
+	assert(senders[31] == "0x" + account.get_address().hex_encode(), "batch signed sender incorrect")
+	print("pass: batch signed senders")
+
+	print("------> test batch signer done <------")
+	pass
+
+func test_unexpected_behavior():
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var raws = BatchSigner.sign_transactions([LegacyTx.new(), _build_tx(1)], account)
+	assert(raws[0] == "", "transaction without fields should fail")
+	assert(raws[1] != "", "valid transaction should still be signed")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
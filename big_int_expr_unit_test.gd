@@ -0,0 +1,48 @@
+extends Label
+
+# The test case
+func test_expected_behavior():
+	print("------> start test big int expression <------")
+	var expr = BigIntExpr.new()
+	var err = expr.compile("(a * b + c) / d % e")
+	assert(err == OK, "compile failed!")
+	assert(expr.get_variables() == PackedStringArray(["a", "b", "c", "d", "e"]), "variables order failed!")
+
+	var result = expr.evaluate({"a": "12345678901234567890", "b": 1000, "c": 7, "d": 3, "e": "1000000007"})
+	assert(result.get_string() == "938728774", "evaluate failed!")
+	print("pass: evaluate")
+
+	var batch = expr.evaluate_batch([
+		PackedStringArray(["10", "20"]),
+		PackedInt64Array([3, 4]),
+		PackedInt64Array([5, 0]),
+		PackedInt64Array([5, 8]),
+		PackedInt64Array([100, 7]),
+	])
+	assert(batch == PackedStringArray(["7", "3"]), "evaluate_batch failed!")
+	print("pass: evaluate_batch")
+
+	var wrap = BigIntExpr.new()
+	wrap.compile("x - 1", BigIntExpr.MODE_U256)
+	var word = wrap.evaluate_array([0])
+	assert(word.to_hex() == "0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff", "u256 mode failed!")
+	print("pass: u256 mode")
+
+	print("------> test big int expression done <------")
+	pass
+
+func test_unexpected_behavior():
+	var expr = BigIntExpr.new()
+	assert(expr.compile("(a + ") != OK, "invalid expression should fail")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
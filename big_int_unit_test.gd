@@ -34,6 +34,36 @@ func test_expected_behavior():
 	assert(cmp == -1, "cmp operation failed!")
 	print("pass: cmp operation")
 
+	var acc = BigInt.new()
+	acc.set_value(a)
+	acc.add_assign(b)
+	assert(acc.get_string() == "111111111011111111100", "add_assign operation failed!")
+	acc.mul_int_assign(10)
+	acc.sub_int_assign(1000)
+	assert(acc.get_string() == "1111111110111111110000", "int fast path operation failed!")
+	print("pass: in-place operations")
+
+	var ten = BigInt.new()
+	ten.from_string("10")
+	var three = BigInt.new()
+	three.from_string("3")
+	assert(b.mul_div(three, ten).get_string() == "29629629632962962963", "mul_div operation failed!")
+	var seven = BigInt.new()
+	seven.from_string("7")
+	assert(three.pow_mod(ten, seven).get_string() == "4", "pow_mod operation failed!")
+	assert(sub.abs().get_string() == "86419753208641975320", "abs operation failed!")
+	print("pass: mul_div, pow_mod and abs operations")
+
+	var words = BigInt.strings_to_words(PackedStringArray(["1", "12345678901234567890"]))
+	assert(words.size() == 64, "strings_to_words failed!")
+	assert(BigInt.words_to_strings(words) == PackedStringArray(["1", "12345678901234567890"]), "words_to_strings failed!")
+	var numbers = BigInt.unpack_words(words)
+	assert(numbers[1].cmp(a) == 0, "unpack_words failed!")
+	assert(BigInt.pack_words(numbers) == words, "pack_words failed!")
+	assert(BigInt.format_strings(BigInt.parse_strings(PackedStringArray(["-255", "16"])), 16) == PackedStringArray(["-0xff", "0x10"]), "bulk string conversion failed!")
+	assert(a.to_int64() == -6101065172474983726, "to_int64 failed!")
+	print("pass: bulk conversions")
+
 	print("------> test big int operations done <------")
 	pass
 
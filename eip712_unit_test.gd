@@ -0,0 +1,126 @@
+extends Label
+
+# Example of the EIP-712 specification, signed with keccak256("cow").
+const PRIVATE_KEY = "c85ef7d79691fe79573b1a7064c19c1a9819ebdbd1faaab1a8ec92344438aaf4"
+
+const TYPES = {
+	"EIP712Domain": [
+		{"name": "name", "type": "string"},
+		{"name": "version", "type": "string"},
+		{"name": "chainId", "type": "uint256"},
+		{"name": "verifyingContract", "type": "address"},
+	],
+	"Person": [
+		{"name": "name", "type": "string"},
+		{"name": "wallet", "type": "address"},
+	],
+	"Mail": [
+		{"name": "from", "type": "Person"},
+		{"name": "to", "type": "Person"},
+		{"name": "contents", "type": "string"},
+	],
+}
+
+const DOMAIN = {
+	"name": "Ether Mail",
+	"version": "1",
+	"chainId": 1,
+	"verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC",
+}
+
+func _mail(contents: String) -> Dictionary:
+	return {
+		"from": {"name": "Cow", "wallet": "0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"},
+		"to": {"name": "Bob", "wallet": "0xbBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"},
+		"contents": contents,
+	}
+
+# The test case
+func test_expected_behavior():
+	print("------> start test eip712 <------")
+	var encoder = TypedDataEncoder.new()
+	assert(encoder.set_types(TYPES), "set_types failed")
+	assert(encoder.encode_type("Mail") == "Mail(Person from,Person to,string contents)Person(string name,address wallet)", "encode_type incorrect")
+	assert(encoder.type_hash("Mail").hex_encode() == "a0cedeb2dc280ba39b857546d74f5549c3a1d7bdc2dd96bf881f76108e23dac2", "type_hash incorrect")
+	assert(encoder.set_domain(DOMAIN), "set_domain failed")
+	assert(encoder.get_domain_separator().hex_encode() == "f2cee375fa42b42143804025fc449deafd50cc031ca257e0b194a650a912090f", "domain separator incorrect")
+	assert(encoder.hash_struct("Mail", _mail("Hello, Bob!")).hex_encode() == "c52c0ee5d84264471806290a3f2c4cecfc5490626bf912d01f240d7a274b371e", "hash_struct incorrect")
+	var digest = encoder.hash_typed_data("Mail", _mail("Hello, Bob!"))
+	assert(digest.hex_encode() == "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2", "hash_typed_data incorrect")
+	print("pass: eip712 specification example")
+
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var signature = encoder.sign_typed_data("Mail", _mail("Hello, Bob!"), account)
+	assert(signature.hex_encode() == "4355c47d63924e8a72e509b65029052eb6c299d53a04e167c5775fd466751c9d07299936d304c153f6443dfa05f40ff007d72911b6f72307f996231605b9156201", "sign_typed_data incorrect")
+	print("pass: sign_typed_data")
+
+	# domain type derived from the domain fields when not in the types
+	var derived = TypedDataEncoder.new()
+	var types = TYPES.duplicate()
+	types.erase("EIP712Domain")
+	assert(derived.set_types(types) and derived.set_domain(DOMAIN), "derived domain failed")
+	assert(derived.get_domain_separator() == encoder.get_domain_separator(), "derived domain separator differs")
+
+	# batches, large enough to run on the worker pool
+	var messages = []
+	for i in range(32):
+		messages.append(_mail("order " + str(i)))
+	var digests = encoder.hash_typed_data_batch("Mail", messages)
+	var signatures = encoder.sign_typed_data_batch("Mail", messages, account)
+	assert(digests.size() == 32 * 32 and signatures.size() == 32 * 65, "batch sizes incorrect")
+	for i in range(32):
+		var expected = encoder.hash_typed_data("Mail", messages[i])
+		assert(digests.slice(i * 32, i * 32 + 32) == expected, "batch digest differs")
+		assert(signatures.slice(i * 65, i * 65 + 65) == account.sign_hash(expected), "batch signature differs")
+	var signers = Secp256k1Wrapper.recover_addresses_batch(digests, signatures)
+	assert(signers.slice(0, 20) == account.get_address(), "batch signer incorrect")
+	print("pass: hash_typed_data_batch and sign_typed_data_batch")
+
+	# arrays, integers and bytes
+	var encoder2 = TypedDataEncoder.new()
+	assert(encoder2.set_types({"Order": [
+		{"name": "amounts", "type": "uint256[]"},
+		{"name": "delta", "type": "int8"},
+		{"name": "salt", "type": "bytes32"},
+		{"name": "pairs", "type": "address[2][]"},
+		{"name": "data", "type": "bytes"},
+	]}), "set_types with arrays failed")
+	var order = {
+		"amounts": [1, "1000000000000000000000", "0xff"],
+		"delta": -128,
+		"salt": "0x" + "ab".repeat(32),
+		"pairs": [["0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826", "0xbBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"]],
+		"data": PackedByteArray([1, 2, 3]),
+	}
+	assert(encoder2.hash_struct("Order", order).size() == 32, "hash_struct with arrays failed")
+	print("pass: arrays and integers")
+	print("------> test eip712 done <------")
+	pass
+
+func test_unexpected_behavior():
+	var encoder = TypedDataEncoder.new()
+	assert(not encoder.set_types({"Mail": [{"name": "from", "type": "Persn"}]}), "unknown type accepted")
+	assert(not encoder.set_types({"Mail": [{"name": "amount", "type": "uint7"}]}), "bad integer size accepted")
+	assert(encoder.set_types(TYPES) and encoder.set_domain(DOMAIN), "set_types failed")
+	var mail = _mail("Hello, Bob!")
+	mail.erase("contents")
+	assert(encoder.hash_typed_data("Mail", mail).is_empty(), "missing field accepted")
+	assert(encoder.hash_typed_data("Order", _mail("x")).is_empty(), "unknown primary type accepted")
+
+	assert(encoder.set_types({"Order": [{"name": "delta", "type": "int8"}, {"name": "pair", "type": "address[2]"}]}), "set_types failed")
+	assert(encoder.hash_struct("Order", {"delta": 128, "pair": []}).is_empty(), "int8 overflow accepted")
+	assert(encoder.hash_struct("Order", {"delta": 1, "pair": ["0x00"]}).is_empty(), "wrong fixed array length accepted")
+
+	# a bad message leaves its batch entry zero, the others are still hashed
+	encoder.set_types(TYPES)
+	encoder.set_domain(DOMAIN)
+	var digests = encoder.hash_typed_data_batch("Mail", [_mail("a"), {"contents": "b"}])
+	assert(digests.slice(32, 64).count(0) == 32 and digests.slice(0, 32).count(0) != 32, "bad batch entry not zeroed")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
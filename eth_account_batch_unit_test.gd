@@ -0,0 +1,41 @@
+extends Label
+
+# The test case
+func test_expected_behavior():
+	print("------> start test eth account batch <------")
+	# more than one group of 64, so the worker pool is used
+	var count = 200
+	var accounts = EthAccountManager.create_batch(count)
+	var private_keys: PackedByteArray = accounts["private_keys"]
+	var public_keys: PackedByteArray = accounts["public_keys"]
+	var addresses: PackedByteArray = accounts["addresses"]
+	assert(private_keys.size() == count * 32, "create_batch private keys size incorrect")
+	assert(public_keys.size() == count * 33, "create_batch public keys size incorrect")
+	assert(addresses.size() == count * 20, "create_batch addresses size incorrect")
+	for i in range(count):
+		var account = EthAccountManager.privateKeyToAccount(private_keys.slice(i * 32, i * 32 + 32))
+		assert(account.get_public_key() == public_keys.slice(i * 33, i * 33 + 33), "batch public key differs from single derivation")
+		assert(account.get_address() == addresses.slice(i * 20, i * 20 + 20), "batch address differs from single derivation")
+	assert(private_keys.slice(0, 32) != private_keys.slice(32, 64), "create_batch repeated a private key")
+	print("pass: create_batch")
+
+	var entropy = "37e17f7c0e6d14ad7bf694051b84b2572d638d875b0bb745bb151754de838d00".hex_decode()
+	accounts = EthAccountManager.create_batch(3, entropy)
+	assert(accounts["addresses"].size() == 60, "create_batch with entropy size incorrect")
+	assert(EthAccountManager.create_batch(0)["addresses"].is_empty(), "create_batch of nothing not empty")
+	print("pass: create_batch with entropy")
+	print("------> test eth account batch done <------")
+	pass
+
+func test_unexpected_behavior():
+	assert(EthAccountManager.create_batch(-1).is_empty(), "negative count not rejected")
+	assert(EthAccountManager.create_batch(4, PackedByteArray([1, 2, 3])).is_empty(), "short entropy not rejected")
+	assert(EthAccountManager.create_batch(0x7fffffff).is_empty(), "count overflowing the output sizes not rejected")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
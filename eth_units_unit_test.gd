@@ -0,0 +1,36 @@
+extends Label
+
+# The test case
+func test_expected_behavior():
+	print("------> start test eth units <------")
+	assert(EthUnits.format_units("1500000000000000000") == "1.5", "format_units failed!")
+	assert(EthUnits.format_units("1234567891234500000000", 18, 2, EthUnits.ROUND_HALF_UP, ",") == "1,234.57", "format_units with precision failed!")
+	assert(EthUnits.format_units("999999999999999999999", 18, 2, EthUnits.ROUND_DOWN) == "999.99", "format_units rounding failed!")
+	print("pass: format_units")
+
+	assert(EthUnits.parse_units("1.5").get_string() == "1500000000000000000", "parse_units failed!")
+	assert(EthUnits.parse_units("1,234.565", 2, EthUnits.ROUND_HALF_EVEN, ",").get_string() == "123456", "parse_units rounding failed!")
+	print("pass: parse_units")
+
+	var words = BigInt.strings_to_words(PackedStringArray(["1000000", "2500000"]))
+	assert(EthUnits.format_units_batch(words, 6) == PackedStringArray(["1", "2.5"]), "format_units_batch failed!")
+	assert(EthUnits.parse_units_batch(PackedStringArray(["1", "2.5"]), 6) == PackedStringArray(["1000000", "2500000"]), "parse_units_batch failed!")
+	print("pass: batch conversions")
+
+	print("------> test eth units done <------")
+	pass
+
+func test_unexpected_behavior():
+	assert(EthUnits.parse_units("1.2.3") == null, "invalid amount should fail")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
@@ -0,0 +1,118 @@
+extends Label
+
+const ZERO_HASH = "0x0000000000000000000000000000000000000000000000000000000000000000"
+const EMPTY_ROOT = "0x56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421"
+const GENESIS_HASH = "0xd4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3"
+
+# Mainnet genesis as returned by eth_getBlockByNumber("0x0", false).
+func genesis_header() -> Dictionary:
+	return {
+		"hash": GENESIS_HASH,
+		"parentHash": ZERO_HASH,
+		"sha3Uncles": "0x1dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347",
+		"miner": "0x0000000000000000000000000000000000000000",
+		"stateRoot": "0xd7f8974fb5ac78d9ac099b9ad5018bedc2ce0a72dad1827a1709da30580f0544",
+		"transactionsRoot": EMPTY_ROOT,
+		"receiptsRoot": EMPTY_ROOT,
+		"logsBloom": "0x" + "00".repeat(256),
+		"difficulty": "0x400000000",
+		"number": "0x0",
+		"gasLimit": "0x1388",
+		"gasUsed": "0x0",
+		"timestamp": "0x0",
+		"extraData": "0x11bbe8db4e347b4e8c937c1c8370e4b5ed33adb3db69cbdb7a38e1e50b1b82fa",
+		"mixHash": ZERO_HASH,
+		"nonce": "0x0000000000000042",
+	}
+
+# A header on top of parent, with its hash filled in.
+func child_header(parent: Dictionary, extra_data: String) -> Dictionary:
+	var header = parent.duplicate()
+	header["parentHash"] = parent["hash"]
+	header["number"] = "0x%x" % (parent["number"].hex_to_int() + 1)
+	header["timestamp"] = "0x%x" % (parent["timestamp"].hex_to_int() + 12)
+	header["extraData"] = extra_data
+	header["hash"] = HeaderChain.compute_hash(header)
+	return header
+
+# The test case
+func test_expected_behavior():
+	print("------> start test header chain <------")
+	var genesis = genesis_header()
+	assert(HeaderChain.compute_hash(genesis) == GENESIS_HASH, "genesis hash incorrect")
+	assert(HeaderChain.verify_header(genesis), "genesis should verify")
+	print("pass: verify_header")
+
+	var chain = HeaderChain.new()
+	chain.set_anchor(0, GENESIS_HASH)
+	assert(chain.add_header(genesis), "anchor header should be added")
+	var block1 = child_header(genesis, "0x01")
+	var block2 = child_header(block1, "0x02")
+	assert(chain.add_header(block1) and chain.add_header(block2), "linked headers should be added")
+	assert(chain.size() == 3 and chain.get_first_number() == 0 and chain.get_tip_number() == 2, "chain range incorrect")
+	assert(chain.get_hash(2) == block2["hash"], "tip hash incorrect")
+	assert(chain.get_header(1)["parentHash"] == GENESIS_HASH, "stored parent hash incorrect")
+	print("pass: add_header")
+
+	# Reorg: another block 2 replaces the old one.
+	var block2b = child_header(block1, "0x2b")
+	assert(chain.add_header(block2b), "reorg header should be added")
+	assert(chain.size() == 3 and chain.get_hash(2) == block2b["hash"], "reorg not applied")
+
+	# Fork fields are hashed when present.
+	var london = child_header(block2b, "0x")
+	london["baseFeePerGas"] = "0x3b9aca00"
+	london["hash"] = HeaderChain.compute_hash(london)
+	assert(HeaderChain.verify_header(london) and chain.add_header(london), "header with baseFeePerGas should be added")
+
+	var path = "user://header_chain_unit_test.bin"
+	assert(chain.save(path) == OK, "save failed")
+	var loaded = HeaderChain.new()
+	loaded.set_anchor(0, GENESIS_HASH)
+	assert(loaded.load(path) == OK, "load failed")
+	assert(loaded.size() == 4 and loaded.get_hash(3) == london["hash"], "loaded chain incorrect")
+
+	loaded.set_max_headers(2)
+	assert(loaded.size() == 2 and loaded.get_first_number() == 2, "max_headers not applied")
+	assert(loaded.get_anchor_number() == 2 and loaded.get_anchor_hash() == block2b["hash"], "anchor not moved to the first kept header")
+	assert(loaded.save(path) == OK and loaded.load(path) == OK, "trimmed chain does not load again")
+	var reloaded = HeaderChain.new()
+	reloaded.set_anchor(loaded.get_anchor_number(), loaded.get_anchor_hash())
+	assert(reloaded.load(path) == OK and reloaded.size() == 2, "trimmed chain does not load with its anchor")
+	print("pass: max_headers keeps the chain anchored")
+	print("------> test header chain done <------")
+	pass
+
+func test_unexpected_behavior():
+	var genesis = genesis_header()
+	var tampered = genesis.duplicate()
+	tampered["stateRoot"] = EMPTY_ROOT
+	assert(not HeaderChain.verify_header(tampered), "tampered header should not verify")
+
+	var chain = HeaderChain.new()
+	chain.set_anchor(0, GENESIS_HASH)
+	assert(not chain.add_header(tampered), "header with wrong hash should be rejected")
+	var block1 = child_header(genesis, "0x01")
+	assert(not chain.add_header(block1), "first header must be the anchor")
+	assert(chain.add_header(genesis), "anchor header should be added")
+
+	# Block 2 whose parent is not in the chain.
+	var orphan = child_header(child_header(genesis, "0xff"), "0x02")
+	assert(not chain.add_header(orphan), "non-linking header should be rejected")
+
+	var missing = genesis.duplicate()
+	missing.erase("mixHash")
+	assert(HeaderChain.encode_header(missing).is_empty(), "header without mixHash should fail")
+	assert(chain.size() == 1, "rejected headers should not be added")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
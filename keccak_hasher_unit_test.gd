@@ -0,0 +1,59 @@
+extends Label
+
+# The test case
+func test_expected_behavior():
+    print("------> start test keccak hasher expected behavior <------")
+    var right_hash = "8610ca36ff04079aa5f6430c4c103c4950df5b31c0620db1d965c825b523083d"
+
+    var hasher = KeccakHasher.new()
+    hasher.update("Hello, ".to_utf8_buffer())
+    hasher.update_string("web3!")
+    assert(hasher.finalize().hex_encode() == right_hash, "incremental hash incorrect")
+    assert(hasher.is_finalized(), "hasher should be finalized")
+    print("pass: update and finalize")
+
+    hasher.reset()
+    var data = "xxHello, web3!yy".to_utf8_buffer()
+    hasher.update_range(data, 2, 7)
+    hasher.update_range(data, 9, 5)
+    assert(hasher.finalize().hex_encode() == right_hash, "update_range hash incorrect")
+    print("pass: update_range")
+
+    # Inputs longer than one block (136 bytes), split at odd offsets.
+    var long_data = PackedByteArray()
+    for i in range(1000):
+        long_data.append(i % 251)
+    hasher.reset()
+    hasher.update_range(long_data, 0, 137)
+    var fork = hasher.clone()
+    hasher.update_range(long_data, 137)
+    var keccak = KeccakWrapper.new()
+    assert(hasher.finalize() == keccak.keccak256_hash(long_data), "long incremental hash incorrect")
+    fork.update_range(long_data, 137, 3)
+    assert(fork.finalize() == keccak.keccak256_hash(long_data.slice(0, 140)), "cloned hasher incorrect")
+    print("pass: clone")
+
+    hasher.reset()
+    assert(hasher.finalize().hex_encode() == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470", "empty hash incorrect")
+    print("------> test keccak hasher expected behavior <------")
+    pass
+
+func test_unexpected_behavior():
+    var hasher = KeccakHasher.new()
+    hasher.update_range(PackedByteArray([1, 2, 3]), 2, 5)
+    hasher.update_range(PackedByteArray([1, 2, 3]), -1, 1)
+    # Invalid ranges are ignored.
+    assert(hasher.finalize().hex_encode() == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470", "invalid ranges should not be hashed")
+    assert(hasher.finalize().is_empty(), "finalize twice should fail")
+    pass
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+    test_expected_behavior()
+    test_unexpected_behavior()
+    pass # Replace with function body.
+
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+    pass
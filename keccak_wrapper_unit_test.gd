@@ -11,10 +11,41 @@ func test_expected_behavior():
     var right_hash = "8610ca36ff04079aa5f6430c4c103c4950df5b31c0620db1d965c825b523083d"
     assert(hash.hex_encode() == right_hash, "get keccak 256 hash no equal except right result")
     print("pass: keccak256 hash")
+
+    # Five inputs of the same size (one group of four, then one alone) and
+    # inputs spanning several blocks.
+    var inputs = []
+    for i in range(5):
+        inputs.append(("leaf %d" % i).to_utf8_buffer())
+    inputs.append(PackedByteArray())
+    for i in range(4):
+        var long_input = PackedByteArray()
+        long_input.resize(300 + i)
+        long_input.fill(i)
+        inputs.append(long_input)
+    var hashes = keccak.keccak256_hash_batch(inputs)
+    assert(hashes.size() == inputs.size() * 32, "batch hash size incorrect")
+    for i in range(inputs.size()):
+        assert(hashes.slice(i * 32, i * 32 + 32) == keccak.keccak256_hash(inputs[i]), "batch hash %d incorrect" % i)
+    assert(hashes.slice(5 * 32, 6 * 32).hex_encode() == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470", "empty input hash incorrect")
+    print("pass: keccak256 hash batch")
+
+    var packed = PackedByteArray()
+    var offsets = PackedInt32Array()
+    for input in inputs:
+        offsets.append(packed.size())
+        packed.append_array(input)
+    assert(keccak.keccak256_hash_packed(packed, offsets) == hashes, "packed hash incorrect")
+    print("pass: keccak256 hash packed")
     print("------> test keccak wrapper expected behavior <------")
     pass
 
 func test_unexpected_behavior():
+    var keccak = KeccakWrapper.new()
+    assert(keccak.keccak256_hash_batch([]).is_empty(), "empty batch should return nothing")
+    assert(keccak.keccak256_hash_batch(["not bytes"]).is_empty(), "non byte input should fail")
+    assert(keccak.keccak256_hash_packed(PackedByteArray([1, 2]), PackedInt32Array([0, 3])).is_empty(), "out of range offset should fail")
+    assert(keccak.keccak256_hash_packed(PackedByteArray([1, 2]), PackedInt32Array([1, 0])).is_empty(), "decreasing offsets should fail")
     pass
 
 # Called when the node enters the scene tree for the first time.
@@ -46,6 +46,19 @@ func test_expected_behavior():
     print("signed marshal binary result: ", enc_string)
     assert(enc_string == "0xf8708203e88504a817c800825204943535353535353535353535353535353535353535880de0b6b3a76400000182f4f6a06564d364f0e020e351466f4005209a376d15dfba0234e712a8f7fffe801247a8a025bede6451fd2a5a6f44ae791e1729bd4e46cb05bc4e62028c23e541b9b84f8b", "marshalbinary result incorrect")
     print("pass: marshalbinary success!")
+
+    # cached encodings must follow field changes, including in-place BigInt updates
+    var signed_hash = legacyTx.hash()
+    assert(legacyTx.hash() == signed_hash, "cached hash changed without field changes")
+    legacyTx.set_nonce(1001)
+    var resubmit_hash = legacyTx.rlp_hash()
+    assert(resubmit_hash != rlp_hash, "rlp_hash not refreshed after set_nonce")
+    gasPrice.add_int_assign(1000000000)
+    assert(legacyTx.rlp_hash() != resubmit_hash, "rlp_hash not refreshed after gas price bump")
+    assert(legacyTx.sign_tx(secp256k1) == 0, "re-sign tx failed!")
+    assert(legacyTx.signedtx_marshal_binary() != enc_string, "signed encoding not refreshed")
+    assert(legacyTx.recover_sender() == "0x5aad065de89d41a925ca5839efd0e4567ceef933", "re-signed sender incorrect")
+    print("pass: cached encodings")
     print("------> test legacy tx operations done <------")
     pass
 
@@ -0,0 +1,70 @@
+extends Label
+
+const EMPTY_ROOT = "56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421"
+
+# The test case
+func test_expected_behavior():
+	print("------> start test merkle patricia trie <------")
+	# ethereum/tests trieanyorder "puppy"
+	var keys = ["do".to_utf8_buffer(), "dog".to_utf8_buffer(), "doge".to_utf8_buffer(), "horse".to_utf8_buffer()]
+	var values = ["verb".to_utf8_buffer(), "puppy".to_utf8_buffer(), "coin".to_utf8_buffer(), "stallion".to_utf8_buffer()]
+	var root = MerklePatriciaTrie.trie_root(keys, values)
+	assert(root.hex_encode() == "5991bb8c6514148a29db676a14ac506cd2cd5775ace63c30a4fe457715e9ac84", "trie_root incorrect")
+	keys.reverse()
+	values.reverse()
+	assert(MerklePatriciaTrie.trie_root(keys, values) == root, "trie_root should not depend on the order")
+	print("pass: trie_root")
+
+	assert(MerklePatriciaTrie.ordered_trie_root([]).hex_encode() == EMPTY_ROOT, "empty transactions root incorrect")
+	var tx = "f8708203e88504a817c800825204943535353535353535353535353535353535353535880de0b6b3a76400000182f4f6a06564d364f0e020e351466f4005209a376d15dfba0234e712a8f7fffe801247a8a025bede6451fd2a5a6f44ae791e1729bd4e46cb05bc4e62028c23e541b9b84f8b"
+	# A single transaction is the leaf [hp(rlp(0)), tx] of the root.
+	var leaf = MerklePatriciaTrie.trie_root([PackedByteArray([0x80])], [tx.hex_decode()])
+	assert(MerklePatriciaTrie.ordered_trie_root([tx]) == leaf, "ordered_trie_root incorrect")
+	print("pass: ordered_trie_root")
+
+	# Single leaf [hp("do", leaf), "verb"].
+	var node = "c98320646f8476657262"
+	root = MerklePatriciaTrie.trie_root(["do".to_utf8_buffer()], ["verb".to_utf8_buffer()])
+	var proof = MerklePatriciaTrie.verify_proof(root, "do".to_utf8_buffer(), ["0x" + node])
+	assert(proof["valid"] and proof["value"] == "verb".to_utf8_buffer(), "inclusion proof failed")
+	proof = MerklePatriciaTrie.verify_proof(root, "dog".to_utf8_buffer(), [node.hex_decode()])
+	assert(proof["valid"] and proof["value"].is_empty(), "exclusion proof failed")
+	print("pass: verify_proof")
+
+	# Exclusion proof against the empty trie.
+	var result = MerklePatriciaTrie.verify_account_proof(EMPTY_ROOT, "0x3535353535353535353535353535353535353535", [])
+	assert(result["valid"] and not result["exists"], "absent account should verify")
+	assert(result["codeHash"] == "0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470", "absent account code hash incorrect")
+	result = MerklePatriciaTrie.verify_storage_proof("0x" + EMPTY_ROOT, "0x0", [])
+	assert(result["valid"] and result["value"].is_zero(), "absent slot should be zero")
+	print("------> test merkle patricia trie done <------")
+	pass
+
+func test_unexpected_behavior():
+	var root = MerklePatriciaTrie.trie_root(["do".to_utf8_buffer()], ["verb".to_utf8_buffer()])
+	# A proof that does not contain the root node cannot be verified.
+	var result = MerklePatriciaTrie.verify_proof(root, "do".to_utf8_buffer(), [PackedByteArray([0xc0])])
+	assert(not result["valid"], "proof without the root node should fail")
+	assert(MerklePatriciaTrie.trie_root(["a".to_utf8_buffer(), "a".to_utf8_buffer()], ["1".to_utf8_buffer(), "2".to_utf8_buffer()]).is_empty(), "duplicate keys should fail")
+	assert(not MerklePatriciaTrie.verify_get_proof("0x1234", {}), "short root should fail")
+
+	# Single leaf state tries holding 0x3535...35 with nonce 5, then 2^64.
+	var account = "0x3535353535353535353535353535353535353535"
+	var leaf = "f86aa120c914adb94bfc1f1a197995efb70b8f67931012bd27f0562f4855444e240bc012b846f8440580a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a0c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470"
+	result = MerklePatriciaTrie.verify_account_proof("5b99eb57f11def3535f069c1e232cca8d001b7c3932cf88a6ac803a7c2f2ad08", account, [leaf])
+	assert(result["valid"] and result["nonce"] == 5, "account proof failed")
+	leaf = "f873a120c914adb94bfc1f1a197995efb70b8f67931012bd27f0562f4855444e240bc012b84ff84d8901000000000000000080a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a0c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470"
+	result = MerklePatriciaTrie.verify_account_proof("c84ca42a7d0695425dc54249bfa2f13203b77adddad598bfb751c9c9d9479955", account, [leaf])
+	assert(not result["valid"], "nonce above 2^64 - 1 should fail")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
@@ -1,45 +1,156 @@
 #include "big_int.h"
 
+#include <limits.h>
+#include <string.h>
+
+#include "core/templates/local_vector.h"
+
+#include "u256_math.h"
+
+// Per-thread freelist of mpz_t storage. Releasing a BigInt hands its limb buffer
+// back to the pool instead of freeing it, so short-lived temporaries in tight
+// loops reuse already-allocated limbs. Only small buffers are kept.
+#define BIGINT_POOL_CAPACITY 64
+#define BIGINT_POOL_MAX_LIMBS 8
+
+struct BigIntPool {
+	__mpz_struct entries[BIGINT_POOL_CAPACITY];
+	int count = 0;
+
+	~BigIntPool() {
+		for (int i = 0; i < count; i++) {
+			mpz_clear(&entries[i]);
+		}
+		count = 0;
+	}
+};
+
+static thread_local BigIntPool bigint_pool;
+
+static void _mpz_pool_acquire(mpz_t number) {
+	if (bigint_pool.count > 0) {
+		number[0] = bigint_pool.entries[--bigint_pool.count];
+		mpz_set_ui(number, 0);
+		return;
+	}
+	mpz_init(number);
+}
+
+static void _mpz_pool_release(mpz_t number) {
+	if (bigint_pool.count < BIGINT_POOL_CAPACITY && number->_mp_alloc <= BIGINT_POOL_MAX_LIMBS) {
+		bigint_pool.entries[bigint_pool.count++] = number[0];
+		return;
+	}
+	mpz_clear(number);
+}
+
+// `long` is 32 bits on some platforms, so int64 operands only take the
+// mpz_*_si/_ui fast paths when they fit.
+static inline bool _fits_long(int64_t value) {
+	return value >= LONG_MIN && value <= LONG_MAX;
+}
+
+void big_int_set_int64(mpz_t number, int64_t value) {
+	if (_fits_long(value)) {
+		mpz_set_si(number, (long)value);
+		return;
+	}
+	uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+	mpz_import(number, 1, 1, sizeof(magnitude), 0, 0, &magnitude);
+	if (value < 0) {
+		mpz_neg(number, number);
+	}
+}
+
+// Scratch value for operations that need a temporary, reused per thread.
+struct BigIntScratch {
+	mpz_t value;
+
+	BigIntScratch() {
+		mpz_init(value);
+	}
+	~BigIntScratch() {
+		mpz_clear(value);
+	}
+};
+
+static thread_local BigIntScratch bigint_scratch;
 
 BigInt::BigInt(){
-	mpz_init(m_number);
+	_mpz_pool_acquire(m_number);
 }
 
 BigInt::~BigInt() {
-	mpz_clear(m_number);
+	_mpz_pool_release(m_number);
 }
 
 void BigInt::set_bytes(uint8_t* bytes, size_t size) {
     mpz_import(m_number, size, 1, sizeof(bytes[0]), 0, 0, bytes);
 }
 
-void BigInt::from_string(String str) {
-	mpz_init_set_str(m_number, str.utf8().get_data(), 10);
+// Parses an optionally signed number, base 16 also accepts a 0x prefix.
+static bool _mpz_set_cstr(mpz_ptr number, const char *str, int base) {
+	bool negative = str[0] == '-';
+	if (negative) {
+		str++;
+	}
+	if (base == 16 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+		str += 2;
+	}
+	if (str[0] == '\0' || str[0] == '-' || mpz_set_str(number, str, base) != 0) {
+		return false;
+	}
+	if (negative) {
+		mpz_neg(number, number);
+	}
+	return true;
+}
+
+// Formats into a stack buffer when possible, hex gets the same 0x prefix as to_hex().
+static String _mpz_to_string(mpz_srcptr number, int base, LocalVector<char> &heap_buffer) {
+	char stack_buffer[160];
+	size_t needed = mpz_sizeinbase(number, base) + 4;
+	char *buffer = stack_buffer;
+	if (needed > sizeof(stack_buffer)) {
+		heap_buffer.resize((uint32_t)needed);
+		buffer = heap_buffer.ptr();
+	}
+	if (base != 16) {
+		mpz_get_str(buffer, base, number);
+		return String(buffer);
+	}
+	mpz_get_str(buffer + 2, 16, number);
+	if (buffer[2] == '-') {
+		buffer[0] = '-';
+		buffer[1] = '0';
+		buffer[2] = 'x';
+	} else {
+		buffer[0] = '0';
+		buffer[1] = 'x';
+	}
+	return String(buffer);
+}
+
+bool BigInt::from_string(const String &str) {
+	CharString cstr = str.utf8();
+	ERR_FAIL_COND_V_MSG(!_mpz_set_cstr(m_number, cstr.get_data(), 10), false, "Invalid decimal string: " + str);
+	return true;
 }
 
 String BigInt::get_string() {
-	char *str = mpz_get_str(NULL, 10, m_number);
-	String result = String(str);
-	free(str);
-	return result;
+	LocalVector<char> heap_buffer;
+	return _mpz_to_string(m_number, 10, heap_buffer);
 }
 
 String BigInt::to_hex() {
-    char *hex_cstr = mpz_get_str(NULL, 16, this->m_number);
-    String hex_string = "0x" + String(hex_cstr);
-    free(hex_cstr);
-    return hex_string;
+	LocalVector<char> heap_buffer;
+	return _mpz_to_string(m_number, 16, heap_buffer);
 }
 
 bool BigInt::from_hex(const String &hex_string) {
-    String hex_str = hex_string;
-    if (hex_str.begins_with("0x")) {
-        hex_str = hex_str.substr(2, hex_str.length() - 2);
-    }
+    CharString hex_cstr = hex_string.utf8();
 
-    CharString hex_cstr = hex_str.utf8();
-
-    if (mpz_set_str(m_number, hex_cstr.get_data(), 16) != 0) {
+    if (!_mpz_set_cstr(m_number, hex_cstr.get_data(), 16)) {
         ERR_PRINT("Invalid hex string");
         return false;
     }
@@ -50,8 +161,155 @@ int BigInt::to_int() const {
     return static_cast<int>(mpz_get_si(m_number));
 }
 
-int BigInt::to_int64() const {
-    return static_cast<int64_t>(mpz_get_si(m_number));
+// Returns the low 64 bits with the sign applied, like mpz_get_si does for `long`.
+int64_t BigInt::to_int64() const {
+	if (mpz_fits_slong_p(m_number)) {
+		return static_cast<int64_t>(mpz_get_si(m_number));
+	}
+	mpz_abs(bigint_scratch.value, m_number);
+	mpz_tdiv_r_2exp(bigint_scratch.value, bigint_scratch.value, 64);
+	uint64_t low = 0;
+	mpz_export(&low, nullptr, -1, sizeof(low), 0, 0, bigint_scratch.value);
+	if (mpz_sgn(m_number) < 0) {
+		low = (uint64_t)0 - low;
+	}
+	return static_cast<int64_t>(low);
+}
+
+bool BigInt::from_bytes(const PackedByteArray &bytes) {
+	if (bytes.size() == 0) {
+		mpz_set_ui(m_number, 0);
+		return true;
+	}
+	mpz_import(m_number, bytes.size(), 1, 1, 1, 0, bytes.ptr());
+	return true;
+}
+
+PackedByteArray BigInt::to_bytes(int size) const {
+	PackedByteArray bytes;
+	ERR_FAIL_COND_V(size <= 0, bytes);
+	bytes.resize(size);
+	ERR_FAIL_COND_V_MSG(!write_bytes(bytes.ptrw(), size), PackedByteArray(), vformat("BigInt does not fit in %d unsigned bytes.", size));
+	return bytes;
+}
+
+size_t BigInt::string_size(int base) const {
+	return mpz_sizeinbase(m_number, base) + 2;
+}
+
+size_t BigInt::write_string(char *buffer, size_t buffer_size, int base) const {
+	if (buffer_size < string_size(base)) {
+		return 0;
+	}
+	mpz_get_str(buffer, base, m_number);
+	return strlen(buffer);
+}
+
+bool BigInt::write_bytes(uint8_t *out, size_t size) const {
+	if (mpz_sgn(m_number) < 0) {
+		return false;
+	}
+	size_t count = mpz_sgn(m_number) == 0 ? 0 : (mpz_sizeinbase(m_number, 2) + 7) / 8;
+	if (count > size) {
+		return false;
+	}
+	memset(out, 0, size - count);
+	if (count > 0) {
+		mpz_export(out + size - count, nullptr, 1, 1, 1, 0, m_number);
+	}
+	return true;
+}
+
+Array BigInt::parse_strings(const PackedStringArray &strings, int base) {
+	ERR_FAIL_COND_V_MSG(base != 10 && base != 16, Array(), "Only base 10 and 16 are supported.");
+	Array result;
+	result.resize(strings.size());
+	for (int i = 0; i < strings.size(); i++) {
+		Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+		CharString cstr = strings[i].utf8();
+		ERR_FAIL_COND_V_MSG(!_mpz_set_cstr(number->m_number, cstr.get_data(), base), Array(), vformat("Invalid number at index %d.", i));
+		result[i] = number;
+	}
+	return result;
+}
+
+PackedStringArray BigInt::format_strings(const Array &numbers, int base) {
+	ERR_FAIL_COND_V_MSG(base != 10 && base != 16, PackedStringArray(), "Only base 10 and 16 are supported.");
+	PackedStringArray result;
+	result.resize(numbers.size());
+	String *out = result.ptrw();
+	LocalVector<char> heap_buffer;
+	for (int i = 0; i < numbers.size(); i++) {
+		Ref<BigInt> number = numbers[i];
+		ERR_FAIL_COND_V_MSG(number.is_null(), PackedStringArray(), vformat("Element %d is not a BigInt.", i));
+		out[i] = _mpz_to_string(number->m_number, base, heap_buffer);
+	}
+	return result;
+}
+
+Array BigInt::unpack_words(const PackedByteArray &words) {
+	ERR_FAIL_COND_V_MSG(words.size() % 32 != 0, Array(), "Word data must be a multiple of 32 bytes.");
+	int count = words.size() / 32;
+	const uint8_t *in = words.ptr();
+	Array result;
+	result.resize(count);
+	for (int i = 0; i < count; i++) {
+		Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+		mpz_import(number->m_number, 32, 1, 1, 1, 0, in + i * 32);
+		result[i] = number;
+	}
+	return result;
+}
+
+PackedByteArray BigInt::pack_words(const Array &numbers) {
+	PackedByteArray result;
+	result.resize(numbers.size() * 32);
+	uint8_t *out = result.ptrw();
+	for (int i = 0; i < numbers.size(); i++) {
+		Ref<BigInt> number = numbers[i];
+		ERR_FAIL_COND_V_MSG(number.is_null(), PackedByteArray(), vformat("Element %d is not a BigInt.", i));
+		ERR_FAIL_COND_V_MSG(!number->write_bytes(out + i * 32, 32), PackedByteArray(), vformat("Element %d does not fit in an unsigned 256-bit word.", i));
+	}
+	return result;
+}
+
+PackedStringArray BigInt::words_to_strings(const PackedByteArray &words, int base) {
+	ERR_FAIL_COND_V_MSG(base != 10 && base != 16, PackedStringArray(), "Only base 10 and 16 are supported.");
+	ERR_FAIL_COND_V_MSG(words.size() % 32 != 0, PackedStringArray(), "Word data must be a multiple of 32 bytes.");
+	int count = words.size() / 32;
+	const uint8_t *in = words.ptr();
+	PackedStringArray result;
+	result.resize(count);
+	String *out = result.ptrw();
+	char buffer[U256_MAX_DEC_DIGITS + 3];
+	for (int i = 0; i < count; i++) {
+		u256 word;
+		u256_from_be_bytes(word, in + i * 32, 32);
+		if (base == 10) {
+			u256_to_dec(word, buffer);
+		} else {
+			buffer[0] = '0';
+			buffer[1] = 'x';
+			u256_to_hex(word, buffer + 2);
+		}
+		out[i] = String(buffer);
+	}
+	return result;
+}
+
+PackedByteArray BigInt::strings_to_words(const PackedStringArray &strings, int base) {
+	ERR_FAIL_COND_V_MSG(base != 10 && base != 16, PackedByteArray(), "Only base 10 and 16 are supported.");
+	PackedByteArray result;
+	result.resize(strings.size() * 32);
+	uint8_t *out = result.ptrw();
+	for (int i = 0; i < strings.size(); i++) {
+		CharString cstr = strings[i].utf8();
+		u256 word;
+		bool ok = base == 10 ? u256_from_dec(word, cstr.get_data(), cstr.length()) : u256_from_hex(word, cstr.get_data(), cstr.length());
+		ERR_FAIL_COND_V_MSG(!ok, PackedByteArray(), vformat("Invalid or out of range number at index %d.", i));
+		u256_to_be_bytes(word, out + i * 32);
+	}
+	return result;
 }
 
 Ref<BigInt> BigInt::add(const Ref<BigInt> other) {
@@ -90,6 +348,131 @@ Ref<BigInt> BigInt::abs() {
     return result;
 }
 
+Ref<BigInt> BigInt::mul_div(const Ref<BigInt> mul, const Ref<BigInt> div) {
+	ERR_FAIL_COND_V(mul.is_null() || div.is_null(), Ref<BigInt>());
+	ERR_FAIL_COND_V_MSG(div->is_zero(), Ref<BigInt>(), "Division by zero.");
+	Ref<BigInt> result = Ref<BigInt>(memnew(BigInt));
+	mpz_mul(result->m_number, this->m_number, mul->m_number);
+	mpz_tdiv_q(result->m_number, result->m_number, div->m_number);
+	return result;
+}
+
+Ref<BigInt> BigInt::pow_mod(const Ref<BigInt> exp, const Ref<BigInt> modulus) {
+	ERR_FAIL_COND_V(exp.is_null() || modulus.is_null(), Ref<BigInt>());
+	ERR_FAIL_COND_V_MSG(modulus->is_zero(), Ref<BigInt>(), "Division by zero.");
+	ERR_FAIL_COND_V_MSG(exp->sgn() < 0, Ref<BigInt>(), "Negative exponent is not supported.");
+	Ref<BigInt> result = Ref<BigInt>(memnew(BigInt));
+	mpz_powm(result->m_number, this->m_number, exp->m_number, modulus->m_number);
+	return result;
+}
+
+void BigInt::set_value(const Ref<BigInt> other) {
+	ERR_FAIL_COND(other.is_null());
+	mpz_set(m_number, other->m_number);
+}
+
+void BigInt::set_int(int64_t value) {
+	big_int_set_int64(m_number, value);
+}
+
+void BigInt::add_assign(const Ref<BigInt> other) {
+	ERR_FAIL_COND(other.is_null());
+	mpz_add(m_number, m_number, other->m_number);
+}
+
+void BigInt::sub_assign(const Ref<BigInt> other) {
+	ERR_FAIL_COND(other.is_null());
+	mpz_sub(m_number, m_number, other->m_number);
+}
+
+void BigInt::mul_assign(const Ref<BigInt> other) {
+	ERR_FAIL_COND(other.is_null());
+	mpz_mul(m_number, m_number, other->m_number);
+}
+
+void BigInt::div_assign(const Ref<BigInt> other) {
+	ERR_FAIL_COND(other.is_null());
+	ERR_FAIL_COND_MSG(other->is_zero(), "Division by zero.");
+	mpz_tdiv_q(m_number, m_number, other->m_number);
+}
+
+void BigInt::mod_assign(const Ref<BigInt> other) {
+	ERR_FAIL_COND(other.is_null());
+	ERR_FAIL_COND_MSG(other->is_zero(), "Division by zero.");
+	mpz_mod(m_number, m_number, other->m_number);
+}
+
+void BigInt::mul_div_assign(const Ref<BigInt> mul, const Ref<BigInt> div) {
+	ERR_FAIL_COND(mul.is_null() || div.is_null());
+	ERR_FAIL_COND_MSG(div->is_zero(), "Division by zero.");
+	mpz_mul(m_number, m_number, mul->m_number);
+	mpz_tdiv_q(m_number, m_number, div->m_number);
+}
+
+void BigInt::pow_mod_assign(const Ref<BigInt> exp, const Ref<BigInt> modulus) {
+	ERR_FAIL_COND(exp.is_null() || modulus.is_null());
+	ERR_FAIL_COND_MSG(modulus->is_zero(), "Division by zero.");
+	ERR_FAIL_COND_MSG(exp->sgn() < 0, "Negative exponent is not supported.");
+	mpz_powm(m_number, m_number, exp->m_number, modulus->m_number);
+}
+
+void BigInt::neg_assign() {
+	mpz_neg(m_number, m_number);
+}
+
+void BigInt::abs_assign() {
+	mpz_abs(m_number, m_number);
+}
+
+void BigInt::add_int_assign(int64_t value) {
+	if (value >= 0 && _fits_long(value)) {
+		mpz_add_ui(m_number, m_number, (unsigned long)value);
+	} else if (value < 0 && _fits_long(value) && value != LONG_MIN) {
+		mpz_sub_ui(m_number, m_number, (unsigned long)(-value));
+	} else {
+		big_int_set_int64(bigint_scratch.value, value);
+		mpz_add(m_number, m_number, bigint_scratch.value);
+	}
+}
+
+void BigInt::sub_int_assign(int64_t value) {
+	if (value >= 0 && _fits_long(value)) {
+		mpz_sub_ui(m_number, m_number, (unsigned long)value);
+	} else if (value < 0 && _fits_long(value) && value != LONG_MIN) {
+		mpz_add_ui(m_number, m_number, (unsigned long)(-value));
+	} else {
+		big_int_set_int64(bigint_scratch.value, value);
+		mpz_sub(m_number, m_number, bigint_scratch.value);
+	}
+}
+
+void BigInt::mul_int_assign(int64_t value) {
+	if (_fits_long(value)) {
+		mpz_mul_si(m_number, m_number, (long)value);
+	} else {
+		big_int_set_int64(bigint_scratch.value, value);
+		mpz_mul(m_number, m_number, bigint_scratch.value);
+	}
+}
+
+void BigInt::div_int_assign(int64_t value) {
+	ERR_FAIL_COND_MSG(value == 0, "Division by zero.");
+	if (value > 0 && _fits_long(value)) {
+		mpz_tdiv_q_ui(m_number, m_number, (unsigned long)value);
+	} else {
+		big_int_set_int64(bigint_scratch.value, value);
+		mpz_tdiv_q(m_number, m_number, bigint_scratch.value);
+	}
+}
+
+int BigInt::cmp_int(int64_t value) const {
+	if (_fits_long(value)) {
+		return mpz_cmp_si(m_number, (long)value);
+	}
+	big_int_set_int64(bigint_scratch.value, value);
+	return mpz_cmp(m_number, bigint_scratch.value);
+}
+
 int BigInt::cmp(const Ref<BigInt> other) {
     return mpz_cmp(this->m_number, other->m_number);
 }
@@ -105,16 +488,46 @@ bool BigInt::is_zero() const {
 void BigInt::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("from_string"), &BigInt::from_string);
 	ClassDB::bind_method(D_METHOD("get_string"), &BigInt::get_string);
+	ClassDB::bind_method(D_METHOD("from_hex", "hex_string"), &BigInt::from_hex);
 	ClassDB::bind_method(D_METHOD("to_hex"), &BigInt::to_hex);
 	ClassDB::bind_method(D_METHOD("to_int"), &BigInt::to_int);
 	ClassDB::bind_method(D_METHOD("to_int64"), &BigInt::to_int64);
+	ClassDB::bind_method(D_METHOD("from_bytes", "bytes"), &BigInt::from_bytes);
+	ClassDB::bind_method(D_METHOD("to_bytes", "size"), &BigInt::to_bytes, DEFVAL(32));
+
+	ClassDB::bind_static_method("BigInt", D_METHOD("parse_strings", "strings", "base"), &BigInt::parse_strings, DEFVAL(10));
+	ClassDB::bind_static_method("BigInt", D_METHOD("format_strings", "numbers", "base"), &BigInt::format_strings, DEFVAL(10));
+	ClassDB::bind_static_method("BigInt", D_METHOD("unpack_words", "words"), &BigInt::unpack_words);
+	ClassDB::bind_static_method("BigInt", D_METHOD("pack_words", "numbers"), &BigInt::pack_words);
+	ClassDB::bind_static_method("BigInt", D_METHOD("words_to_strings", "words", "base"), &BigInt::words_to_strings, DEFVAL(10));
+	ClassDB::bind_static_method("BigInt", D_METHOD("strings_to_words", "strings", "base"), &BigInt::strings_to_words, DEFVAL(10));
 
 	ClassDB::bind_method(D_METHOD("add"), &BigInt::add);
 	ClassDB::bind_method(D_METHOD("sub"), &BigInt::sub);
 	ClassDB::bind_method(D_METHOD("mul"), &BigInt::mul);
 	ClassDB::bind_method(D_METHOD("div"), &BigInt::div);
 	ClassDB::bind_method(D_METHOD("mod"), &BigInt::mod);
-	ClassDB::bind_method(D_METHOD("abs"), &BigInt::mod);
+	ClassDB::bind_method(D_METHOD("abs"), &BigInt::abs);
+	ClassDB::bind_method(D_METHOD("mul_div", "mul", "div"), &BigInt::mul_div);
+	ClassDB::bind_method(D_METHOD("pow_mod", "exp", "modulus"), &BigInt::pow_mod);
+
+	ClassDB::bind_method(D_METHOD("set_value", "other"), &BigInt::set_value);
+	ClassDB::bind_method(D_METHOD("set_int", "value"), &BigInt::set_int);
+	ClassDB::bind_method(D_METHOD("add_assign", "other"), &BigInt::add_assign);
+	ClassDB::bind_method(D_METHOD("sub_assign", "other"), &BigInt::sub_assign);
+	ClassDB::bind_method(D_METHOD("mul_assign", "other"), &BigInt::mul_assign);
+	ClassDB::bind_method(D_METHOD("div_assign", "other"), &BigInt::div_assign);
+	ClassDB::bind_method(D_METHOD("mod_assign", "other"), &BigInt::mod_assign);
+	ClassDB::bind_method(D_METHOD("mul_div_assign", "mul", "div"), &BigInt::mul_div_assign);
+	ClassDB::bind_method(D_METHOD("pow_mod_assign", "exp", "modulus"), &BigInt::pow_mod_assign);
+	ClassDB::bind_method(D_METHOD("neg_assign"), &BigInt::neg_assign);
+	ClassDB::bind_method(D_METHOD("abs_assign"), &BigInt::abs_assign);
+
+	ClassDB::bind_method(D_METHOD("add_int_assign", "value"), &BigInt::add_int_assign);
+	ClassDB::bind_method(D_METHOD("sub_int_assign", "value"), &BigInt::sub_int_assign);
+	ClassDB::bind_method(D_METHOD("mul_int_assign", "value"), &BigInt::mul_int_assign);
+	ClassDB::bind_method(D_METHOD("div_int_assign", "value"), &BigInt::div_int_assign);
+	ClassDB::bind_method(D_METHOD("cmp_int", "value"), &BigInt::cmp_int);
 
 	ClassDB::bind_method(D_METHOD("cmp"), &BigInt::cmp);
 	ClassDB::bind_method(D_METHOD("sgn"), &BigInt::sgn);
@@ -11,6 +11,9 @@
 #include "core/error/error_macros.h"
 #include "core/error/error_list.h"
 
+// Sets an mpz from an int64 on every platform, including those with a 32-bit `long`.
+void big_int_set_int64(mpz_t number, int64_t value);
+
 class BigInt : public RefCounted {
     GDCLASS(BigInt, RefCounted);
 
@@ -24,12 +27,33 @@ public:
     ~BigInt();
 
 	void set_bytes(uint8_t* bytes, size_t size);
-    void from_string(String str);
+    bool from_string(const String &str);
     String get_string();
 	bool from_hex(const String &hex_string);
 	String to_hex();
 	int to_int() const;
-	int to_int64() const;
+	int64_t to_int64() const;
+	bool from_bytes(const PackedByteArray &bytes);
+	// Big-endian magnitude left-padded to size bytes, empty if it does not fit.
+	PackedByteArray to_bytes(int size = 32) const;
+
+	// Allocation-free conversions into caller buffers.
+	// Upper bound of the characters write_string() needs, including sign and NUL.
+	size_t string_size(int base = 10) const;
+	// Writes the value in base 10 or 16 (lowercase, no prefix) and returns the
+	// number of characters written, or 0 when the buffer is too small.
+	size_t write_string(char *buffer, size_t buffer_size, int base = 10) const;
+	// Writes the magnitude as size big-endian bytes, returns false if it does not fit.
+	bool write_bytes(uint8_t *out, size_t size) const;
+
+	// Bulk conversions, one native call per batch.
+	static Array parse_strings(const PackedStringArray &strings, int base = 10);
+	static PackedStringArray format_strings(const Array &numbers, int base = 10);
+	static Array unpack_words(const PackedByteArray &words);
+	static PackedByteArray pack_words(const Array &numbers);
+	// Converts 32-byte words straight to strings (and back) without creating BigInts.
+	static PackedStringArray words_to_strings(const PackedByteArray &words, int base = 10);
+	static PackedByteArray strings_to_words(const PackedStringArray &strings, int base = 10);
 
 
     Ref<BigInt> add(const Ref<BigInt> other);
@@ -38,6 +62,30 @@ public:
     Ref<BigInt> div(const Ref<BigInt> other);
     Ref<BigInt> mod(const Ref<BigInt> other);
     Ref<BigInt> abs();
+	// this * mul / div in one step, without an intermediate object.
+	Ref<BigInt> mul_div(const Ref<BigInt> mul, const Ref<BigInt> div);
+	// (this ^ exp) mod modulus.
+	Ref<BigInt> pow_mod(const Ref<BigInt> exp, const Ref<BigInt> modulus);
+
+	// In-place variants, these update this object instead of allocating a result.
+	void set_value(const Ref<BigInt> other);
+	void set_int(int64_t value);
+	void add_assign(const Ref<BigInt> other);
+	void sub_assign(const Ref<BigInt> other);
+	void mul_assign(const Ref<BigInt> other);
+	void div_assign(const Ref<BigInt> other);
+	void mod_assign(const Ref<BigInt> other);
+	void mul_div_assign(const Ref<BigInt> mul, const Ref<BigInt> div);
+	void pow_mod_assign(const Ref<BigInt> exp, const Ref<BigInt> modulus);
+	void neg_assign();
+	void abs_assign();
+
+	// Fast paths for small operands, no BigInt is needed for the right-hand side.
+	void add_int_assign(int64_t value);
+	void sub_int_assign(int64_t value);
+	void mul_int_assign(int64_t value);
+	void div_int_assign(int64_t value);
+	int cmp_int(int64_t value) const;
 
 	// return int, meaning:
 	// < 0: this < other
@@ -0,0 +1,622 @@
+#include "big_int_expr.h"
+
+static inline bool _is_ident_start(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static inline bool _is_ident_char(char c) {
+	return _is_ident_start(c) || (c >= '0' && c <= '9');
+}
+
+static inline bool _is_hex_char(char c) {
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static void _clear_mpz_vector(LocalVector<__mpz_struct> &values) {
+	for (uint32_t i = 0; i < values.size(); i++) {
+		mpz_clear(&values[i]);
+	}
+	values.clear();
+}
+
+static void _init_mpz_vector(LocalVector<__mpz_struct> &values, int count) {
+	values.resize(count);
+	for (int i = 0; i < count; i++) {
+		mpz_init(&values[i]);
+	}
+}
+
+BigIntExpr::BigIntExpr() {
+}
+
+BigIntExpr::~BigIntExpr() {
+	_clear();
+}
+
+void BigIntExpr::_clear() {
+	m_compiled = false;
+	m_variables.clear();
+	m_code.clear();
+	m_max_depth = 0;
+	m_const_literals.clear();
+	_clear_mpz_vector(m_big_consts);
+	_clear_mpz_vector(m_big_vars);
+	_clear_mpz_vector(m_big_stack);
+	m_u256_consts.clear();
+	m_u256_vars.clear();
+	m_u256_stack.clear();
+}
+
+void BigIntExpr::_skip_spaces() {
+	while (m_pos < m_source.length()) {
+		char c = m_source[m_pos];
+		if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+			break;
+		}
+		m_pos++;
+	}
+}
+
+void BigIntExpr::_emit(OpCode op, uint32_t arg) {
+	Instruction instruction;
+	instruction.op = op;
+	instruction.arg = arg;
+	m_code.push_back(instruction);
+
+	if (op == OP_PUSH_VAR || op == OP_PUSH_CONST) {
+		m_depth++;
+		if (m_depth > m_max_depth) {
+			m_max_depth = m_depth;
+		}
+	} else if (op != OP_NEG) {
+		m_depth--;
+	}
+}
+
+// expression := term (('+' | '-') term)*
+bool BigIntExpr::_parse_expression() {
+	if (!_parse_term()) {
+		return false;
+	}
+	while (true) {
+		_skip_spaces();
+		if (m_pos >= m_source.length()) {
+			return true;
+		}
+		char c = m_source[m_pos];
+		if (c != '+' && c != '-') {
+			return true;
+		}
+		m_pos++;
+		if (!_parse_term()) {
+			return false;
+		}
+		_emit(c == '+' ? OP_ADD : OP_SUB);
+	}
+}
+
+// term := unary (('*' | '/' | '%') unary)*
+bool BigIntExpr::_parse_term() {
+	if (!_parse_unary()) {
+		return false;
+	}
+	while (true) {
+		_skip_spaces();
+		if (m_pos >= m_source.length()) {
+			return true;
+		}
+		char c = m_source[m_pos];
+		OpCode op;
+		if (c == '*') {
+			op = OP_MUL;
+		} else if (c == '/') {
+			op = OP_DIV;
+		} else if (c == '%') {
+			op = OP_MOD;
+		} else {
+			return true;
+		}
+		m_pos++;
+		if (!_parse_unary()) {
+			return false;
+		}
+		_emit(op);
+	}
+}
+
+// unary := '-' unary | primary
+bool BigIntExpr::_parse_unary() {
+	_skip_spaces();
+	if (m_pos < m_source.length() && m_source[m_pos] == '-') {
+		m_pos++;
+		if (!_parse_unary()) {
+			return false;
+		}
+		_emit(OP_NEG);
+		return true;
+	}
+	return _parse_primary();
+}
+
+// primary := number | identifier | '(' expression ')'
+bool BigIntExpr::_parse_primary() {
+	_skip_spaces();
+	if (m_pos >= m_source.length()) {
+		m_error = "Unexpected end of expression.";
+		return false;
+	}
+	const char *src = m_source.get_data();
+	char c = src[m_pos];
+
+	if (c == '(') {
+		m_pos++;
+		if (!_parse_expression()) {
+			return false;
+		}
+		_skip_spaces();
+		if (m_pos >= m_source.length() || src[m_pos] != ')') {
+			m_error = vformat("Expected ')' at position %d.", m_pos);
+			return false;
+		}
+		m_pos++;
+		return true;
+	}
+
+	if (c >= '0' && c <= '9') {
+		int start = m_pos;
+		if (c == '0' && m_pos + 1 < m_source.length() && (src[m_pos + 1] == 'x' || src[m_pos + 1] == 'X')) {
+			m_pos += 2;
+			while (m_pos < m_source.length() && _is_hex_char(src[m_pos])) {
+				m_pos++;
+			}
+			if (m_pos == start + 2) {
+				m_error = vformat("Invalid hex literal at position %d.", start);
+				return false;
+			}
+		} else {
+			while (m_pos < m_source.length() && src[m_pos] >= '0' && src[m_pos] <= '9') {
+				m_pos++;
+			}
+		}
+		String literal = String::utf8(src + start, m_pos - start);
+		int index = -1;
+		for (uint32_t i = 0; i < m_const_literals.size(); i++) {
+			if (m_const_literals[i] == literal) {
+				index = i;
+				break;
+			}
+		}
+		if (index < 0) {
+			index = m_const_literals.size();
+			m_const_literals.push_back(literal);
+		}
+		_emit(OP_PUSH_CONST, index);
+		return true;
+	}
+
+	if (_is_ident_start(c)) {
+		int start = m_pos;
+		while (m_pos < m_source.length() && _is_ident_char(src[m_pos])) {
+			m_pos++;
+		}
+		String name = String::utf8(src + start, m_pos - start);
+		int index = m_variables.find(name);
+		if (index < 0) {
+			index = m_variables.size();
+			m_variables.push_back(name);
+		}
+		_emit(OP_PUSH_VAR, index);
+		return true;
+	}
+
+	m_error = vformat("Unexpected character '%s' at position %d.", String::chr(c), m_pos);
+	return false;
+}
+
+bool BigIntExpr::_allocate_registers() {
+	int const_count = m_const_literals.size();
+	if (m_mode == MODE_BIG_INT) {
+		_init_mpz_vector(m_big_consts, const_count);
+		_init_mpz_vector(m_big_vars, m_variables.size());
+		_init_mpz_vector(m_big_stack, m_max_depth);
+		for (int i = 0; i < const_count; i++) {
+			CharString literal = m_const_literals[i].utf8();
+			const char *digits = literal.get_data();
+			int base = 10;
+			if (literal.length() > 2 && digits[1] != '\0' && (digits[1] == 'x' || digits[1] == 'X')) {
+				digits += 2;
+				base = 16;
+			}
+			if (mpz_set_str(&m_big_consts[i], digits, base) != 0) {
+				m_error = "Invalid literal: " + m_const_literals[i];
+				return false;
+			}
+		}
+	} else {
+		m_u256_consts.resize(const_count);
+		m_u256_vars.resize(m_variables.size());
+		m_u256_stack.resize(m_max_depth);
+		for (int i = 0; i < const_count; i++) {
+			CharString literal = m_const_literals[i].utf8();
+			bool hex = literal.length() > 2 && (literal[1] == 'x' || literal[1] == 'X');
+			bool ok = hex ? u256_from_hex(m_u256_consts[i], literal.get_data(), literal.length())
+						  : u256_from_dec(m_u256_consts[i], literal.get_data(), literal.length());
+			if (!ok) {
+				m_error = "Literal does not fit in 256 bits: " + m_const_literals[i];
+				return false;
+			}
+		}
+		for (uint32_t i = 0; i < m_u256_vars.size(); i++) {
+			u256_set_zero(m_u256_vars[i]);
+		}
+	}
+	return true;
+}
+
+Error BigIntExpr::compile(const String &expression, Mode mode) {
+	_clear();
+	m_mode = mode;
+	m_source = expression.utf8();
+	m_pos = 0;
+	m_depth = 0;
+	m_error = "";
+
+	bool ok = _parse_expression();
+	if (ok) {
+		_skip_spaces();
+		if (m_pos < m_source.length()) {
+			m_error = vformat("Unexpected character '%s' at position %d.", String::chr(m_source[m_pos]), m_pos);
+			ok = false;
+		}
+	}
+	if (ok) {
+		ok = _allocate_registers();
+	}
+	m_source = CharString();
+
+	if (!ok) {
+		String error = m_error;
+		_clear();
+		m_error = error;
+		ERR_FAIL_V_MSG(ERR_PARSE_ERROR, "Failed to compile expression: " + error);
+	}
+	m_compiled = true;
+	return OK;
+}
+
+String BigIntExpr::get_error() const {
+	return m_error;
+}
+
+bool BigIntExpr::is_compiled() const {
+	return m_compiled;
+}
+
+BigIntExpr::Mode BigIntExpr::get_mode() const {
+	return m_mode;
+}
+
+PackedStringArray BigIntExpr::get_variables() const {
+	return m_variables;
+}
+
+bool BigIntExpr::_set_variable(int index, const Variant &value) {
+	switch (value.get_type()) {
+		case Variant::INT: {
+			int64_t v = value;
+			if (m_mode == MODE_BIG_INT) {
+				big_int_set_int64(&m_big_vars[index], v);
+			} else {
+				ERR_FAIL_COND_V_MSG(v < 0, false, "Negative input for U256 expression: " + m_variables[index]);
+				u256_set_u64(m_u256_vars[index], (uint64_t)v);
+			}
+			return true;
+		}
+		case Variant::STRING: {
+			CharString digits = String(value).utf8();
+			if (m_mode == MODE_BIG_INT) {
+				ERR_FAIL_COND_V_MSG(mpz_set_str(&m_big_vars[index], digits.get_data(), 10) != 0, false, "Invalid decimal input: " + m_variables[index]);
+			} else {
+				ERR_FAIL_COND_V_MSG(!u256_from_dec(m_u256_vars[index], digits.get_data(), digits.length()), false, "Invalid decimal input: " + m_variables[index]);
+			}
+			return true;
+		}
+		case Variant::OBJECT: {
+			Object *object = value;
+			BigInt *big = Object::cast_to<BigInt>(object);
+			if (big) {
+				if (m_mode == MODE_BIG_INT) {
+					mpz_set(&m_big_vars[index], big->m_number);
+				} else {
+					ERR_FAIL_COND_V_MSG(!u256_from_mpz(m_u256_vars[index], big->m_number), false, "Input does not fit in U256: " + m_variables[index]);
+				}
+				return true;
+			}
+			U256 *word = Object::cast_to<U256>(object);
+			if (word) {
+				if (m_mode == MODE_BIG_INT) {
+					u256_to_mpz(&m_big_vars[index], word->m_value);
+				} else {
+					m_u256_vars[index] = word->m_value;
+				}
+				return true;
+			}
+		} break;
+		default:
+			break;
+	}
+	ERR_FAIL_V_MSG(false, "Unsupported input type for variable: " + m_variables[index]);
+}
+
+bool BigIntExpr::_set_variable_from_column(int index, const Column &column, int row) {
+	switch (column.type) {
+		case Variant::PACKED_STRING_ARRAY: {
+			CharString digits = column.strings[row].utf8();
+			if (m_mode == MODE_BIG_INT) {
+				ERR_FAIL_COND_V_MSG(mpz_set_str(&m_big_vars[index], digits.get_data(), 10) != 0, false, vformat("Invalid decimal input at row %d.", row));
+			} else {
+				ERR_FAIL_COND_V_MSG(!u256_from_dec(m_u256_vars[index], digits.get_data(), digits.length()), false, vformat("Invalid decimal input at row %d.", row));
+			}
+			return true;
+		}
+		case Variant::PACKED_INT64_ARRAY: {
+			int64_t v = column.ints[row];
+			if (m_mode == MODE_BIG_INT) {
+				big_int_set_int64(&m_big_vars[index], v);
+			} else {
+				ERR_FAIL_COND_V_MSG(v < 0, false, vformat("Negative input at row %d.", row));
+				u256_set_u64(m_u256_vars[index], (uint64_t)v);
+			}
+			return true;
+		}
+		case Variant::PACKED_BYTE_ARRAY: {
+			const uint8_t *word = column.words.ptr() + row * 32;
+			if (m_mode == MODE_BIG_INT) {
+				mpz_import(&m_big_vars[index], 32, 1, 1, 1, 0, word);
+			} else {
+				u256_from_be_bytes(m_u256_vars[index], word, 32);
+			}
+			return true;
+		}
+		default:
+			break;
+	}
+	return false;
+}
+
+bool BigIntExpr::_prepare_columns(const Array &columns, LocalVector<Column> &r_columns, int &r_rows) {
+	ERR_FAIL_COND_V_MSG(!m_compiled, false, "Expression is not compiled.");
+	ERR_FAIL_COND_V_MSG(columns.size() != m_variables.size(), false, vformat("Expected %d input columns, got %d.", m_variables.size(), columns.size()));
+
+	r_rows = -1;
+	r_columns.resize(columns.size());
+	for (int i = 0; i < columns.size(); i++) {
+		const Variant &value = columns[i];
+		Column &column = r_columns[i];
+		column.type = value.get_type();
+		int rows = 0;
+		if (column.type == Variant::PACKED_STRING_ARRAY) {
+			column.strings = value;
+			rows = column.strings.size();
+		} else if (column.type == Variant::PACKED_INT64_ARRAY) {
+			column.ints = value;
+			rows = column.ints.size();
+		} else if (column.type == Variant::PACKED_BYTE_ARRAY) {
+			column.words = value;
+			ERR_FAIL_COND_V_MSG(column.words.size() % 32 != 0, false, "Word columns must be a multiple of 32 bytes.");
+			rows = column.words.size() / 32;
+		} else {
+			ERR_FAIL_V_MSG(false, "Unsupported column type for variable: " + m_variables[i]);
+		}
+		ERR_FAIL_COND_V_MSG(r_rows >= 0 && rows != r_rows, false, "All input columns must have the same number of rows.");
+		r_rows = rows;
+	}
+	if (r_rows < 0) {
+		// A constant expression evaluates once.
+		r_rows = 1;
+	}
+	return true;
+}
+
+bool BigIntExpr::_run() {
+	int sp = 0;
+	if (m_mode == MODE_BIG_INT) {
+		__mpz_struct *stack = m_big_stack.ptr();
+		for (uint32_t i = 0; i < m_code.size(); i++) {
+			const Instruction &instruction = m_code[i];
+			switch (instruction.op) {
+				case OP_PUSH_VAR:
+					mpz_set(&stack[sp++], &m_big_vars[instruction.arg]);
+					break;
+				case OP_PUSH_CONST:
+					mpz_set(&stack[sp++], &m_big_consts[instruction.arg]);
+					break;
+				case OP_ADD:
+					sp--;
+					mpz_add(&stack[sp - 1], &stack[sp - 1], &stack[sp]);
+					break;
+				case OP_SUB:
+					sp--;
+					mpz_sub(&stack[sp - 1], &stack[sp - 1], &stack[sp]);
+					break;
+				case OP_MUL:
+					sp--;
+					mpz_mul(&stack[sp - 1], &stack[sp - 1], &stack[sp]);
+					break;
+				case OP_DIV:
+					sp--;
+					ERR_FAIL_COND_V_MSG(mpz_sgn(&stack[sp]) == 0, false, "Division by zero.");
+					mpz_tdiv_q(&stack[sp - 1], &stack[sp - 1], &stack[sp]);
+					break;
+				case OP_MOD:
+					sp--;
+					ERR_FAIL_COND_V_MSG(mpz_sgn(&stack[sp]) == 0, false, "Division by zero.");
+					mpz_mod(&stack[sp - 1], &stack[sp - 1], &stack[sp]);
+					break;
+				case OP_NEG:
+					mpz_neg(&stack[sp - 1], &stack[sp - 1]);
+					break;
+			}
+		}
+	} else {
+		u256 *stack = m_u256_stack.ptr();
+		for (uint32_t i = 0; i < m_code.size(); i++) {
+			const Instruction &instruction = m_code[i];
+			switch (instruction.op) {
+				case OP_PUSH_VAR:
+					stack[sp++] = m_u256_vars[instruction.arg];
+					break;
+				case OP_PUSH_CONST:
+					stack[sp++] = m_u256_consts[instruction.arg];
+					break;
+				case OP_ADD:
+					sp--;
+					u256_add(stack[sp - 1], stack[sp - 1], stack[sp]);
+					break;
+				case OP_SUB:
+					sp--;
+					u256_sub(stack[sp - 1], stack[sp - 1], stack[sp]);
+					break;
+				case OP_MUL:
+					sp--;
+					u256_mul(stack[sp - 1], stack[sp - 1], stack[sp]);
+					break;
+				case OP_DIV:
+					sp--;
+					ERR_FAIL_COND_V_MSG(u256_is_zero(stack[sp]), false, "Division by zero.");
+					u256_divmod(&stack[sp - 1], nullptr, stack[sp - 1], stack[sp]);
+					break;
+				case OP_MOD:
+					sp--;
+					ERR_FAIL_COND_V_MSG(u256_is_zero(stack[sp]), false, "Division by zero.");
+					u256_divmod(nullptr, &stack[sp - 1], stack[sp - 1], stack[sp]);
+					break;
+				case OP_NEG:
+					u256_neg(stack[sp - 1], stack[sp - 1]);
+					break;
+			}
+		}
+	}
+	return true;
+}
+
+Variant BigIntExpr::_result() const {
+	if (m_mode == MODE_BIG_INT) {
+		Ref<BigInt> result = Ref<BigInt>(memnew(BigInt));
+		mpz_set(result->m_number, &m_big_stack[0]);
+		return result;
+	}
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	result->m_value = m_u256_stack[0];
+	return result;
+}
+
+Variant BigIntExpr::evaluate(const Dictionary &variables) {
+	ERR_FAIL_COND_V_MSG(!m_compiled, Variant(), "Expression is not compiled.");
+	for (int i = 0; i < m_variables.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!variables.has(m_variables[i]), Variant(), "Missing variable: " + m_variables[i]);
+		if (!_set_variable(i, variables[m_variables[i]])) {
+			return Variant();
+		}
+	}
+	if (!_run()) {
+		return Variant();
+	}
+	return _result();
+}
+
+Variant BigIntExpr::evaluate_array(const Array &values) {
+	ERR_FAIL_COND_V_MSG(!m_compiled, Variant(), "Expression is not compiled.");
+	ERR_FAIL_COND_V_MSG(values.size() != m_variables.size(), Variant(), vformat("Expected %d values, got %d.", m_variables.size(), values.size()));
+	for (int i = 0; i < m_variables.size(); i++) {
+		if (!_set_variable(i, values[i])) {
+			return Variant();
+		}
+	}
+	if (!_run()) {
+		return Variant();
+	}
+	return _result();
+}
+
+PackedStringArray BigIntExpr::evaluate_batch(const Array &columns) {
+	PackedStringArray results;
+	LocalVector<Column> prepared;
+	int rows = 0;
+	if (!_prepare_columns(columns, prepared, rows)) {
+		return results;
+	}
+
+	results.resize(rows);
+	String *out = results.ptrw();
+	LocalVector<char> buffer;
+	for (int row = 0; row < rows; row++) {
+		for (uint32_t i = 0; i < prepared.size(); i++) {
+			if (!_set_variable_from_column(i, prepared[i], row)) {
+				return PackedStringArray();
+			}
+		}
+		if (!_run()) {
+			return PackedStringArray();
+		}
+		if (m_mode == MODE_BIG_INT) {
+			size_t needed = mpz_sizeinbase(&m_big_stack[0], 10) + 2;
+			if (buffer.size() < needed) {
+				buffer.resize((uint32_t)needed);
+			}
+			mpz_get_str(buffer.ptr(), 10, &m_big_stack[0]);
+			out[row] = String(buffer.ptr());
+		} else {
+			char digits[U256_MAX_DEC_DIGITS + 1];
+			u256_to_dec(m_u256_stack[0], digits);
+			out[row] = String(digits);
+		}
+	}
+	return results;
+}
+
+PackedByteArray BigIntExpr::evaluate_batch_words(const Array &columns) {
+	PackedByteArray results;
+	LocalVector<Column> prepared;
+	int rows = 0;
+	if (!_prepare_columns(columns, prepared, rows)) {
+		return results;
+	}
+
+	results.resize(rows * 32);
+	uint8_t *out = results.ptrw();
+	for (int row = 0; row < rows; row++) {
+		for (uint32_t i = 0; i < prepared.size(); i++) {
+			if (!_set_variable_from_column(i, prepared[i], row)) {
+				return PackedByteArray();
+			}
+		}
+		if (!_run()) {
+			return PackedByteArray();
+		}
+		if (m_mode == MODE_BIG_INT) {
+			u256 word;
+			ERR_FAIL_COND_V_MSG(!u256_from_mpz(word, &m_big_stack[0]), PackedByteArray(), vformat("Result at row %d does not fit in an unsigned 256-bit word.", row));
+			u256_to_be_bytes(word, out + row * 32);
+		} else {
+			u256_to_be_bytes(m_u256_stack[0], out + row * 32);
+		}
+	}
+	return results;
+}
+
+void BigIntExpr::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("compile", "expression", "mode"), &BigIntExpr::compile, DEFVAL(MODE_BIG_INT));
+	ClassDB::bind_method(D_METHOD("get_error"), &BigIntExpr::get_error);
+	ClassDB::bind_method(D_METHOD("is_compiled"), &BigIntExpr::is_compiled);
+	ClassDB::bind_method(D_METHOD("get_mode"), &BigIntExpr::get_mode);
+	ClassDB::bind_method(D_METHOD("get_variables"), &BigIntExpr::get_variables);
+
+	ClassDB::bind_method(D_METHOD("evaluate", "variables"), &BigIntExpr::evaluate);
+	ClassDB::bind_method(D_METHOD("evaluate_array", "values"), &BigIntExpr::evaluate_array);
+	ClassDB::bind_method(D_METHOD("evaluate_batch", "columns"), &BigIntExpr::evaluate_batch);
+	ClassDB::bind_method(D_METHOD("evaluate_batch_words", "columns"), &BigIntExpr::evaluate_batch_words);
+
+	BIND_ENUM_CONSTANT(MODE_BIG_INT);
+	BIND_ENUM_CONSTANT(MODE_U256);
+}
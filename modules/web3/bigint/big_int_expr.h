@@ -0,0 +1,128 @@
+#ifndef BIG_INT_EXPR_H
+#define BIG_INT_EXPR_H
+
+#include <gmp.h>
+
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+#include "core/error/error_macros.h"
+#include "core/error/error_list.h"
+
+#include "big_int.h"
+#include "u256.h"
+
+// Compiles an integer formula such as "(a * b + c) / d % e" once into a small
+// stack bytecode, then evaluates it many times with new inputs without crossing
+// the script boundary per operation.
+//
+// Supported syntax: decimal or 0x-prefixed hex literals, identifiers, + - * / %,
+// unary minus and parentheses. In MODE_BIG_INT registers are GMP integers with
+// BigInt semantics (truncating division, non-negative modulo); in MODE_U256 they
+// are fixed-width 256-bit values with wrapping arithmetic.
+//
+// Evaluation reuses registers owned by the object, so a single BigIntExpr must not
+// be evaluated from several threads at once.
+class BigIntExpr : public RefCounted {
+	GDCLASS(BigIntExpr, RefCounted);
+
+public:
+	enum Mode {
+		MODE_BIG_INT,
+		MODE_U256,
+	};
+
+	enum OpCode : uint8_t {
+		OP_PUSH_VAR,
+		OP_PUSH_CONST,
+		OP_ADD,
+		OP_SUB,
+		OP_MUL,
+		OP_DIV,
+		OP_MOD,
+		OP_NEG,
+	};
+
+	struct Instruction {
+		OpCode op;
+		uint32_t arg;
+	};
+
+protected:
+	static void _bind_methods();
+
+private:
+	Mode m_mode = MODE_BIG_INT;
+	bool m_compiled = false;
+	PackedStringArray m_variables;
+	LocalVector<Instruction> m_code;
+	int m_max_depth = 0;
+
+	// Constant pool and registers, in the representation of the current mode.
+	LocalVector<String> m_const_literals;
+	LocalVector<__mpz_struct> m_big_consts;
+	LocalVector<__mpz_struct> m_big_vars;
+	LocalVector<__mpz_struct> m_big_stack;
+	LocalVector<u256> m_u256_consts;
+	LocalVector<u256> m_u256_vars;
+	LocalVector<u256> m_u256_stack;
+
+	// Parser state, only valid during compile().
+	CharString m_source;
+	int m_pos = 0;
+	int m_depth = 0;
+	String m_error;
+
+	void _clear();
+	void _skip_spaces();
+	void _emit(OpCode op, uint32_t arg = 0);
+	bool _parse_expression();
+	bool _parse_term();
+	bool _parse_unary();
+	bool _parse_primary();
+	bool _allocate_registers();
+
+	// One input column of a batch evaluation.
+	struct Column {
+		Variant::Type type = Variant::NIL;
+		PackedStringArray strings;
+		PackedInt64Array ints;
+		PackedByteArray words;
+	};
+
+	bool _set_variable(int index, const Variant &value);
+	bool _set_variable_from_column(int index, const Column &column, int row);
+	bool _prepare_columns(const Array &columns, LocalVector<Column> &r_columns, int &r_rows);
+	bool _run();
+	Variant _result() const;
+
+public:
+	BigIntExpr();
+	~BigIntExpr();
+
+	Error compile(const String &expression, Mode mode = MODE_BIG_INT);
+	String get_error() const;
+	bool is_compiled() const;
+	Mode get_mode() const;
+	// Variable names in the order used by evaluate_array() and evaluate_batch().
+	PackedStringArray get_variables() const;
+
+	// Values may be BigInt, U256, int or decimal String. Returns a BigInt or a
+	// U256 depending on the mode, or null on error.
+	Variant evaluate(const Dictionary &variables);
+	Variant evaluate_array(const Array &values);
+
+	// Each column holds one input per row for the variable at the same index:
+	// PackedStringArray of decimal strings, PackedInt64Array, or PackedByteArray
+	// of 32-byte big-endian words. All columns must have the same row count.
+	PackedStringArray evaluate_batch(const Array &columns);
+	// Same as evaluate_batch(), results are packed as 32-byte big-endian words.
+	PackedByteArray evaluate_batch_words(const Array &columns);
+};
+
+VARIANT_ENUM_CAST(BigIntExpr::Mode);
+
+#endif // BIG_INT_EXPR_H
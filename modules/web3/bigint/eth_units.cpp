@@ -0,0 +1,444 @@
+#include "eth_units.h"
+
+#include "u256_math.h"
+
+// Upper bound of characters written by _format_core().
+static int _format_capacity(int length, int decimals, int precision, int thousands_len, int decimal_len) {
+	int digits = length + decimals + 2;
+	int fraction = precision > decimals ? precision : decimals;
+	return 1 + digits + (digits / 3 + 1) * thousands_len + decimal_len + fraction + 1;
+}
+
+// Formats an optionally signed decimal digit string scaled down by 10^decimals.
+// Works purely on the digits: rounding is a carry through the kept digits.
+// Returns the number of characters written to out, or -1 if the input is invalid.
+static int _format_core(const char *digits, int length, int decimals, int precision, EthUnits::RoundingMode rounding,
+		const char32_t *thousands, int thousands_len, const char32_t *decimal, int decimal_len, char32_t *out) {
+	bool negative = length > 0 && digits[0] == '-';
+	const char *body = digits + (negative ? 1 : 0);
+	int n = length - (negative ? 1 : 0);
+	if (n <= 0) {
+		return -1;
+	}
+	for (int i = 0; i < n; i++) {
+		if (body[i] < '0' || body[i] > '9') {
+			return -1;
+		}
+	}
+	while (n > 1 && body[0] == '0') {
+		body++;
+		n--;
+	}
+
+	// Virtual digit string W: body left-padded with zeros so the integer part has at least one digit.
+	int pad = decimals + 1 > n ? decimals + 1 - n : 0;
+	int m = n + pad;
+#define W(i) ((i) < pad ? '0' : body[(i) - pad])
+	int int_len = m - decimals;
+	int kept = precision < 0 || precision > decimals ? decimals : precision;
+	int r_len = int_len + kept;
+
+	bool round_up = false;
+	if (kept < decimals) {
+		char first = W(r_len);
+		bool rest_nonzero = false;
+		for (int i = r_len + 1; i < m && !rest_nonzero; i++) {
+			rest_nonzero = W(i) != '0';
+		}
+		switch (rounding) {
+			case EthUnits::ROUND_DOWN:
+				break;
+			case EthUnits::ROUND_UP:
+				round_up = first != '0' || rest_nonzero;
+				break;
+			case EthUnits::ROUND_HALF_UP:
+				round_up = first >= '5';
+				break;
+			case EthUnits::ROUND_HALF_EVEN:
+				round_up = first > '5' || (first == '5' && (rest_nonzero || ((W(r_len - 1) - '0') & 1)));
+				break;
+		}
+	}
+
+	// Rounding up increments the last non-nine digit and zeroes the ones after it.
+	int carry_pos = r_len;
+	bool prefix_one = false;
+	if (round_up) {
+		carry_pos = r_len - 1;
+		while (carry_pos >= 0 && W(carry_pos) == '9') {
+			carry_pos--;
+		}
+		prefix_one = carry_pos < 0;
+	}
+#define R(i) (!round_up || (i) < carry_pos ? W(i) : ((i) == carry_pos ? (char)(W(i) + 1) : '0'))
+
+	bool is_zero = !prefix_one;
+	for (int i = 0; i < r_len && is_zero; i++) {
+		is_zero = R(i) == '0';
+	}
+
+	int pos = 0;
+	if (negative && !is_zero) {
+		out[pos++] = '-';
+	}
+	int group_len = int_len + (prefix_one ? 1 : 0);
+	for (int j = 0; j < group_len; j++) {
+		if (j > 0 && thousands_len > 0 && (group_len - j) % 3 == 0) {
+			for (int t = 0; t < thousands_len; t++) {
+				out[pos++] = thousands[t];
+			}
+		}
+		out[pos++] = prefix_one ? (j == 0 ? '1' : R(j - 1)) : R(j);
+	}
+
+	int fraction_len = kept;
+	if (precision < 0) {
+		while (fraction_len > 0 && R(int_len + fraction_len - 1) == '0') {
+			fraction_len--;
+		}
+	}
+	int padded_len = precision > fraction_len ? precision : fraction_len;
+	if (padded_len > 0) {
+		for (int t = 0; t < decimal_len; t++) {
+			out[pos++] = decimal[t];
+		}
+		for (int i = 0; i < padded_len; i++) {
+			out[pos++] = i < fraction_len ? R(int_len + i) : '0';
+		}
+	}
+#undef R
+#undef W
+	out[pos] = 0;
+	return pos;
+}
+
+static bool _match_at(const char32_t *text, int len, int pos, const char32_t *token, int token_len) {
+	if (token_len == 0 || pos + token_len > len) {
+		return false;
+	}
+	for (int i = 0; i < token_len; i++) {
+		if (text[pos + i] != token[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Parses "[-]int[.frac]" with optional thousands separators in the integer part
+// into a signed decimal string of base units. out must hold len + decimals + 3 chars.
+// Returns the number of characters written, or -1 if the text is invalid.
+static int _parse_core(const char32_t *text, int len, int decimals, EthUnits::RoundingMode rounding,
+		const char32_t *thousands, int thousands_len, const char32_t *decimal, int decimal_len, char *out) {
+	int pos = 0;
+	while (pos < len && (text[pos] == ' ' || text[pos] == '\t')) {
+		pos++;
+	}
+	while (len > pos && (text[len - 1] == ' ' || text[len - 1] == '\t')) {
+		len--;
+	}
+	bool negative = false;
+	if (pos < len && (text[pos] == '-' || text[pos] == '+')) {
+		negative = text[pos] == '-';
+		pos++;
+	}
+
+	// Digits are collected after the sign slot: integer digits, then exactly
+	// `decimals` fraction digits (zero padded), remaining fraction digits only
+	// influence rounding.
+	char *digits = out + 1;
+	int count = 0;
+	int int_count = 0;
+	int frac_count = 0;
+	bool in_fraction = false;
+	bool dropped_first_seen = false;
+	char dropped_first = '0';
+	bool dropped_rest_nonzero = false;
+	while (pos < len) {
+		char32_t c = text[pos];
+		if (c >= '0' && c <= '9') {
+			if (!in_fraction) {
+				digits[count++] = (char)c;
+				int_count++;
+			} else if (frac_count < decimals) {
+				digits[count++] = (char)c;
+				frac_count++;
+			} else if (!dropped_first_seen) {
+				dropped_first = (char)c;
+				dropped_first_seen = true;
+			} else if (c != '0') {
+				dropped_rest_nonzero = true;
+			}
+			pos++;
+		} else if (!in_fraction && _match_at(text, len, pos, decimal, decimal_len)) {
+			in_fraction = true;
+			pos += decimal_len;
+		} else if (!in_fraction && int_count > 0 && _match_at(text, len, pos, thousands, thousands_len)) {
+			pos += thousands_len;
+			if (pos >= len || text[pos] < '0' || text[pos] > '9') {
+				return -1;
+			}
+		} else {
+			return -1;
+		}
+	}
+	if (int_count + frac_count == 0 && !dropped_first_seen) {
+		return -1;
+	}
+	while (frac_count < decimals) {
+		digits[count++] = '0';
+		frac_count++;
+	}
+
+	bool round_up = false;
+	switch (rounding) {
+		case EthUnits::ROUND_DOWN:
+			break;
+		case EthUnits::ROUND_UP:
+			round_up = dropped_first != '0' || dropped_rest_nonzero;
+			break;
+		case EthUnits::ROUND_HALF_UP:
+			round_up = dropped_first >= '5';
+			break;
+		case EthUnits::ROUND_HALF_EVEN:
+			round_up = dropped_first > '5' || (dropped_first == '5' && (dropped_rest_nonzero || (count > 0 && ((digits[count - 1] - '0') & 1))));
+			break;
+	}
+	if (round_up) {
+		int i = count - 1;
+		while (i >= 0 && digits[i] == '9') {
+			digits[i--] = '0';
+		}
+		if (i >= 0) {
+			digits[i]++;
+		} else {
+			memmove(digits + 1, digits, count);
+			digits[0] = '1';
+			count++;
+		}
+	}
+
+	int start = 0;
+	while (start < count - 1 && digits[start] == '0') {
+		start++;
+	}
+	if (count == 0) {
+		digits[0] = '0';
+		count = 1;
+	}
+	bool is_zero = digits[start] == '0';
+	int written = 0;
+	if (negative && !is_zero) {
+		out[written++] = '-';
+	}
+	memmove(out + written, digits + start, count - start);
+	written += count - start;
+	out[written] = '\0';
+	return written;
+}
+
+bool EthUnits::format_digits(const char *digits, int length, const Options &options, LocalVector<char32_t> &r_buffer, String &r_result) {
+	int thousands_len = options.thousands_separator.length();
+	int decimal_len = options.decimal_separator.length();
+	int capacity = _format_capacity(length, options.decimals, options.precision, thousands_len, decimal_len);
+	if ((int)r_buffer.size() < capacity) {
+		r_buffer.resize(capacity);
+	}
+	int written = _format_core(digits, length, options.decimals, options.precision, options.rounding,
+			options.thousands_separator.ptr(), thousands_len, options.decimal_separator.ptr(), decimal_len, r_buffer.ptr());
+	if (written < 0) {
+		return false;
+	}
+	r_result = String(r_buffer.ptr());
+	return true;
+}
+
+bool EthUnits::parse_amount(const String &text, const Options &options, LocalVector<char> &r_buffer, String &r_result) {
+	int capacity = text.length() + options.decimals + 3;
+	if ((int)r_buffer.size() < capacity) {
+		r_buffer.resize(capacity);
+	}
+	int written = _parse_core(text.ptr(), text.length(), options.decimals, options.rounding,
+			options.thousands_separator.ptr(), options.thousands_separator.length(),
+			options.decimal_separator.ptr(), options.decimal_separator.length(), r_buffer.ptr());
+	if (written < 0) {
+		return false;
+	}
+	r_result = String(r_buffer.ptr());
+	return true;
+}
+
+static bool _validate_options(const EthUnits::Options &options) {
+	ERR_FAIL_COND_V_MSG(options.decimals < 0 || options.decimals > EthUnits::MAX_DECIMALS, false, vformat("decimals must be between 0 and %d.", EthUnits::MAX_DECIMALS));
+	ERR_FAIL_COND_V_MSG(options.precision < -1 || options.precision > EthUnits::MAX_DECIMALS, false, vformat("precision must be between -1 and %d.", EthUnits::MAX_DECIMALS));
+	ERR_FAIL_COND_V_MSG(options.decimal_separator.is_empty(), false, "decimal_separator must not be empty.");
+	ERR_FAIL_COND_V_MSG(options.thousands_separator == options.decimal_separator, false, "Separators must differ.");
+	return true;
+}
+
+static EthUnits::Options _make_options(int decimals, int precision, EthUnits::RoundingMode rounding, const String &thousands_separator, const String &decimal_separator) {
+	EthUnits::Options options;
+	options.decimals = decimals;
+	options.precision = precision;
+	options.rounding = rounding;
+	options.thousands_separator = thousands_separator;
+	options.decimal_separator = decimal_separator;
+	return options;
+}
+
+// Writes the decimal digits of a supported value into r_digits.
+static bool _value_digits(const Variant &value, LocalVector<char> &r_digits, int &r_length) {
+	switch (value.get_type()) {
+		case Variant::STRING: {
+			CharString cstr = String(value).utf8();
+			r_length = cstr.length();
+			if ((int)r_digits.size() < r_length + 1) {
+				r_digits.resize(r_length + 1);
+			}
+			memcpy(r_digits.ptr(), cstr.get_data(), r_length + 1);
+			return true;
+		}
+		case Variant::INT: {
+			if (r_digits.size() < 24) {
+				r_digits.resize(24);
+			}
+			r_length = snprintf(r_digits.ptr(), 24, "%lld", (long long)(int64_t)value);
+			return true;
+		}
+		case Variant::OBJECT: {
+			Object *object = value;
+			BigInt *big = Object::cast_to<BigInt>(object);
+			if (big) {
+				size_t size = big->string_size(10);
+				if (r_digits.size() < size) {
+					r_digits.resize((uint32_t)size);
+				}
+				r_length = (int)big->write_string(r_digits.ptr(), size, 10);
+				return true;
+			}
+			U256 *word = Object::cast_to<U256>(object);
+			if (word) {
+				if (r_digits.size() < U256_MAX_DEC_DIGITS + 1) {
+					r_digits.resize(U256_MAX_DEC_DIGITS + 1);
+				}
+				r_length = (int)u256_to_dec(word->m_value, r_digits.ptr());
+				return true;
+			}
+		} break;
+		default:
+			break;
+	}
+	return false;
+}
+
+String EthUnits::format_units(const Variant &value, int decimals, int precision, RoundingMode rounding, const String &thousands_separator, const String &decimal_separator) {
+	Options options = _make_options(decimals, precision, rounding, thousands_separator, decimal_separator);
+	if (!_validate_options(options)) {
+		return String();
+	}
+	LocalVector<char> digits;
+	int length = 0;
+	ERR_FAIL_COND_V_MSG(!_value_digits(value, digits, length), String(), "Unsupported value type, expected String, int, BigInt or U256.");
+	LocalVector<char32_t> buffer;
+	String result;
+	ERR_FAIL_COND_V_MSG(!format_digits(digits.ptr(), length, options, buffer, result), String(), "Invalid integer value.");
+	return result;
+}
+
+Ref<BigInt> EthUnits::parse_units(const String &text, int decimals, RoundingMode rounding, const String &thousands_separator, const String &decimal_separator) {
+	Options options = _make_options(decimals, -1, rounding, thousands_separator, decimal_separator);
+	if (!_validate_options(options)) {
+		return Ref<BigInt>();
+	}
+	LocalVector<char> buffer;
+	String amount;
+	ERR_FAIL_COND_V_MSG(!parse_amount(text, options, buffer, amount), Ref<BigInt>(), "Invalid token amount: " + text);
+	Ref<BigInt> result = Ref<BigInt>(memnew(BigInt));
+	mpz_set_str(result->m_number, buffer.ptr(), 10);
+	return result;
+}
+
+PackedStringArray EthUnits::format_units_batch(const Variant &values, int decimals, int precision, RoundingMode rounding, const String &thousands_separator, const String &decimal_separator) {
+	PackedStringArray results;
+	Options options = _make_options(decimals, precision, rounding, thousands_separator, decimal_separator);
+	if (!_validate_options(options)) {
+		return results;
+	}
+
+	LocalVector<char32_t> buffer;
+	LocalVector<char> digits;
+	switch (values.get_type()) {
+		case Variant::PACKED_STRING_ARRAY: {
+			PackedStringArray strings = values;
+			results.resize(strings.size());
+			String *out = results.ptrw();
+			for (int i = 0; i < strings.size(); i++) {
+				CharString cstr = strings[i].utf8();
+				ERR_FAIL_COND_V_MSG(!format_digits(cstr.get_data(), cstr.length(), options, buffer, out[i]), PackedStringArray(), vformat("Invalid integer at index %d.", i));
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			PackedByteArray words = values;
+			ERR_FAIL_COND_V_MSG(words.size() % 32 != 0, results, "Word data must be a multiple of 32 bytes.");
+			int count = words.size() / 32;
+			results.resize(count);
+			String *out = results.ptrw();
+			char word_digits[U256_MAX_DEC_DIGITS + 1];
+			for (int i = 0; i < count; i++) {
+				u256 word;
+				u256_from_be_bytes(word, words.ptr() + i * 32, 32);
+				int length = (int)u256_to_dec(word, word_digits);
+				format_digits(word_digits, length, options, buffer, out[i]);
+			}
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			PackedInt64Array ints = values;
+			results.resize(ints.size());
+			String *out = results.ptrw();
+			char int_digits[24];
+			for (int i = 0; i < ints.size(); i++) {
+				int length = snprintf(int_digits, sizeof(int_digits), "%lld", (long long)ints[i]);
+				format_digits(int_digits, length, options, buffer, out[i]);
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array array = values;
+			results.resize(array.size());
+			String *out = results.ptrw();
+			for (int i = 0; i < array.size(); i++) {
+				int length = 0;
+				ERR_FAIL_COND_V_MSG(!_value_digits(array[i], digits, length), PackedStringArray(), vformat("Unsupported value type at index %d.", i));
+				ERR_FAIL_COND_V_MSG(!format_digits(digits.ptr(), length, options, buffer, out[i]), PackedStringArray(), vformat("Invalid integer at index %d.", i));
+			}
+		} break;
+		default:
+			ERR_FAIL_V_MSG(results, "Unsupported values type, expected PackedStringArray, PackedByteArray, PackedInt64Array or Array.");
+	}
+	return results;
+}
+
+PackedStringArray EthUnits::parse_units_batch(const PackedStringArray &texts, int decimals, RoundingMode rounding, const String &thousands_separator, const String &decimal_separator) {
+	PackedStringArray results;
+	Options options = _make_options(decimals, -1, rounding, thousands_separator, decimal_separator);
+	if (!_validate_options(options)) {
+		return results;
+	}
+	results.resize(texts.size());
+	String *out = results.ptrw();
+	LocalVector<char> buffer;
+	for (int i = 0; i < texts.size(); i++) {
+		ERR_FAIL_COND_V_MSG(!parse_amount(texts[i], options, buffer, out[i]), PackedStringArray(), vformat("Invalid token amount at index %d: %s", i, texts[i]));
+	}
+	return results;
+}
+
+void EthUnits::_bind_methods() {
+	ClassDB::bind_static_method("EthUnits", D_METHOD("format_units", "value", "decimals", "precision", "rounding", "thousands_separator", "decimal_separator"), &EthUnits::format_units, DEFVAL(18), DEFVAL(-1), DEFVAL(ROUND_HALF_UP), DEFVAL(""), DEFVAL("."));
+	ClassDB::bind_static_method("EthUnits", D_METHOD("parse_units", "text", "decimals", "rounding", "thousands_separator", "decimal_separator"), &EthUnits::parse_units, DEFVAL(18), DEFVAL(ROUND_HALF_UP), DEFVAL(""), DEFVAL("."));
+	ClassDB::bind_static_method("EthUnits", D_METHOD("format_units_batch", "values", "decimals", "precision", "rounding", "thousands_separator", "decimal_separator"), &EthUnits::format_units_batch, DEFVAL(18), DEFVAL(-1), DEFVAL(ROUND_HALF_UP), DEFVAL(""), DEFVAL("."));
+	ClassDB::bind_static_method("EthUnits", D_METHOD("parse_units_batch", "texts", "decimals", "rounding", "thousands_separator", "decimal_separator"), &EthUnits::parse_units_batch, DEFVAL(18), DEFVAL(ROUND_HALF_UP), DEFVAL(""), DEFVAL("."));
+
+	BIND_ENUM_CONSTANT(ROUND_DOWN);
+	BIND_ENUM_CONSTANT(ROUND_HALF_UP);
+	BIND_ENUM_CONSTANT(ROUND_UP);
+	BIND_ENUM_CONSTANT(ROUND_HALF_EVEN);
+}
@@ -0,0 +1,64 @@
+#ifndef ETH_UNITS_H
+#define ETH_UNITS_H
+
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/variant.h"
+#include "core/error/error_macros.h"
+
+#include "big_int.h"
+#include "u256.h"
+
+// Conversion between integer base units (e.g. wei) and human-readable token
+// amounts (e.g. "1,234.5"). Formatting and parsing work directly on decimal
+// digits, so no big-number division is needed, and the batch variants convert
+// whole lists in one call.
+class EthUnits : public RefCounted {
+	GDCLASS(EthUnits, RefCounted);
+
+public:
+	enum RoundingMode {
+		ROUND_DOWN, // Toward zero.
+		ROUND_HALF_UP, // To nearest, ties away from zero.
+		ROUND_UP, // Away from zero.
+		ROUND_HALF_EVEN, // To nearest, ties to the even digit.
+	};
+
+	// Largest supported decimals/precision, 10^77 is the largest power of ten in 256 bits.
+	static const int MAX_DECIMALS = 77;
+
+	struct Options {
+		int decimals = 18;
+		// Number of fraction digits to output, -1 keeps all significant digits.
+		int precision = -1;
+		RoundingMode rounding = ROUND_HALF_UP;
+		String thousands_separator;
+		String decimal_separator = ".";
+	};
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Formats digits ("-" optional, then [0-9]+) scaled down by options.decimals.
+	static bool format_digits(const char *digits, int length, const Options &options, LocalVector<char32_t> &r_buffer, String &r_result);
+	// Parses a token amount into base units, the result is a signed decimal string.
+	static bool parse_amount(const String &text, const Options &options, LocalVector<char> &r_buffer, String &r_result);
+
+	// value may be a decimal String, int, BigInt or U256.
+	static String format_units(const Variant &value, int decimals = 18, int precision = -1, RoundingMode rounding = ROUND_HALF_UP, const String &thousands_separator = "", const String &decimal_separator = ".");
+	// Returns null when the text is not a valid amount.
+	static Ref<BigInt> parse_units(const String &text, int decimals = 18, RoundingMode rounding = ROUND_HALF_UP, const String &thousands_separator = "", const String &decimal_separator = ".");
+
+	// values may be a PackedStringArray of decimal strings, a PackedByteArray of
+	// 32-byte big-endian words, a PackedInt64Array or an Array of BigInt/U256.
+	static PackedStringArray format_units_batch(const Variant &values, int decimals = 18, int precision = -1, RoundingMode rounding = ROUND_HALF_UP, const String &thousands_separator = "", const String &decimal_separator = ".");
+	// Returns base unit amounts as decimal strings, empty on error.
+	static PackedStringArray parse_units_batch(const PackedStringArray &texts, int decimals = 18, RoundingMode rounding = ROUND_HALF_UP, const String &thousands_separator = "", const String &decimal_separator = ".");
+};
+
+VARIANT_ENUM_CAST(EthUnits::RoundingMode);
+
+#endif // ETH_UNITS_H
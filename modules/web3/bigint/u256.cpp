@@ -0,0 +1,627 @@
+#include "u256.h"
+
+static bool _parse_dec(u256 &r, const String &str) {
+	CharString cs = str.utf8();
+	return u256_from_dec(r, cs.get_data(), cs.length());
+}
+
+static bool _parse_hex(u256 &r, const String &str) {
+	CharString cs = str.utf8();
+	return u256_from_hex(r, cs.get_data(), cs.length());
+}
+
+static String _format_dec(const u256 &value) {
+	char buf[U256_MAX_DEC_DIGITS + 1];
+	u256_to_dec(value, buf);
+	return String(buf);
+}
+
+static String _format_hex(const u256 &value) {
+	char buf[U256_MAX_HEX_DIGITS + 1];
+	u256_to_hex(value, buf);
+	return "0x" + String(buf);
+}
+
+static PackedByteArray _to_word(const u256 &value) {
+	PackedByteArray bytes;
+	bytes.resize(32);
+	u256_to_be_bytes(value, bytes.ptrw());
+	return bytes;
+}
+
+// Writes the magnitude of an mpz into r, returns false if it needs more than 256 bits.
+static bool _magnitude_from_mpz(u256 &r, const mpz_t value) {
+	u256_set_zero(r);
+	if (mpz_sgn(value) == 0) {
+		return true;
+	}
+	if (mpz_sizeinbase(value, 2) > 256) {
+		return false;
+	}
+	uint8_t buf[32];
+	size_t count = 0;
+	mpz_export(buf, &count, 1, 1, 1, 0, value);
+	return u256_from_be_bytes(r, buf, count);
+}
+
+bool u256_from_mpz(u256 &r, const mpz_t value) {
+	if (mpz_sgn(value) < 0) {
+		return false;
+	}
+	return _magnitude_from_mpz(r, value);
+}
+
+void u256_to_mpz(mpz_t r, const u256 &value) {
+	uint8_t buf[32];
+	u256_to_be_bytes(value, buf);
+	mpz_import(r, 32, 1, 1, 1, 0, buf);
+}
+
+// Largest magnitude an I256 may hold for the given sign: 2^255 - 1 or 2^255.
+static bool _fits_signed(const u256 &magnitude, bool negative) {
+	if (!u256_is_neg(magnitude)) {
+		return true;
+	}
+	if (!negative) {
+		return false;
+	}
+	return magnitude.limbs[3] == 0x8000000000000000ULL && magnitude.limbs[2] == 0 && magnitude.limbs[1] == 0 && magnitude.limbs[0] == 0;
+}
+
+static void _abs_signed(u256 &r, const u256 &value) {
+	if (u256_is_neg(value)) {
+		u256_neg(r, value);
+	} else {
+		r = value;
+	}
+}
+
+// U256
+
+U256::U256() {
+	u256_set_zero(m_value);
+}
+
+U256::~U256() {
+}
+
+bool U256::from_string(const String &str) {
+	u256 v;
+	ERR_FAIL_COND_V_MSG(!_parse_dec(v, str), false, "Invalid or out of range U256 decimal string: " + str);
+	m_value = v;
+	return true;
+}
+
+String U256::get_string() const {
+	return _format_dec(m_value);
+}
+
+bool U256::from_hex(const String &hex_string) {
+	u256 v;
+	ERR_FAIL_COND_V_MSG(!_parse_hex(v, hex_string), false, "Invalid or out of range U256 hex string: " + hex_string);
+	m_value = v;
+	return true;
+}
+
+String U256::to_hex() const {
+	return _format_hex(m_value);
+}
+
+bool U256::from_int(int64_t value) {
+	ERR_FAIL_COND_V_MSG(value < 0, false, "U256 cannot hold a negative value.");
+	u256_set_u64(m_value, (uint64_t)value);
+	return true;
+}
+
+int64_t U256::to_int64() const {
+	return (int64_t)m_value.limbs[0];
+}
+
+bool U256::set_bytes(const PackedByteArray &bytes) {
+	ERR_FAIL_COND_V_MSG(bytes.size() > 32, false, "U256 accepts at most 32 bytes.");
+	return u256_from_be_bytes(m_value, bytes.ptr(), bytes.size());
+}
+
+PackedByteArray U256::to_bytes() const {
+	return _to_word(m_value);
+}
+
+PackedByteArray U256::to_bytes_trimmed() const {
+	uint8_t buf[32];
+	size_t len = u256_to_be_bytes_min(m_value, buf);
+	PackedByteArray bytes;
+	bytes.resize(len);
+	if (len > 0) {
+		memcpy(bytes.ptrw(), buf, len);
+	}
+	return bytes;
+}
+
+bool U256::from_big_int(const Ref<BigInt> &value) {
+	ERR_FAIL_COND_V(value.is_null(), false);
+	ERR_FAIL_COND_V_MSG(mpz_sgn(value->m_number) < 0, false, "U256 cannot hold a negative value.");
+	u256 v;
+	ERR_FAIL_COND_V_MSG(!_magnitude_from_mpz(v, value->m_number), false, "BigInt does not fit in 256 bits.");
+	m_value = v;
+	return true;
+}
+
+Ref<BigInt> U256::to_big_int() const {
+	Ref<BigInt> result = Ref<BigInt>(memnew(BigInt));
+	u256_to_mpz(result->m_number, m_value);
+	return result;
+}
+
+Ref<U256> U256::copy() const {
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	result->m_value = m_value;
+	return result;
+}
+
+Ref<U256> U256::add(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_add(result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<U256> U256::sub(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_sub(result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<U256> U256::mul(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_mul(result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<U256> U256::div(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	ERR_FAIL_COND_V_MSG(u256_is_zero(other->m_value), Ref<U256>(), "Division by zero.");
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_divmod(&result->m_value, nullptr, m_value, other->m_value);
+	return result;
+}
+
+Ref<U256> U256::mod(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	ERR_FAIL_COND_V_MSG(u256_is_zero(other->m_value), Ref<U256>(), "Division by zero.");
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_divmod(nullptr, &result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<U256> U256::shl(int bits) const {
+	ERR_FAIL_COND_V(bits < 0, Ref<U256>());
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_shl(result->m_value, m_value, (unsigned int)bits);
+	return result;
+}
+
+Ref<U256> U256::shr(int bits) const {
+	ERR_FAIL_COND_V(bits < 0, Ref<U256>());
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	u256_shr(result->m_value, m_value, (unsigned int)bits);
+	return result;
+}
+
+Ref<U256> U256::checked_add(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	u256 r;
+	if (u256_add(r, m_value, other->m_value)) {
+		return Ref<U256>();
+	}
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	result->m_value = r;
+	return result;
+}
+
+Ref<U256> U256::checked_sub(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	u256 r;
+	if (u256_sub(r, m_value, other->m_value)) {
+		return Ref<U256>();
+	}
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	result->m_value = r;
+	return result;
+}
+
+Ref<U256> U256::checked_mul(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<U256>());
+	u256 r;
+	if (u256_mul(r, m_value, other->m_value)) {
+		return Ref<U256>();
+	}
+	Ref<U256> result = Ref<U256>(memnew(U256));
+	result->m_value = r;
+	return result;
+}
+
+void U256::add_assign(const Ref<U256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	u256_add(m_value, m_value, other->m_value);
+}
+
+void U256::sub_assign(const Ref<U256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	u256_sub(m_value, m_value, other->m_value);
+}
+
+void U256::mul_assign(const Ref<U256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	u256_mul(m_value, m_value, other->m_value);
+}
+
+void U256::div_assign(const Ref<U256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	ERR_FAIL_COND_MSG(u256_is_zero(other->m_value), "Division by zero.");
+	u256 q;
+	u256_divmod(&q, nullptr, m_value, other->m_value);
+	m_value = q;
+}
+
+void U256::mod_assign(const Ref<U256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	ERR_FAIL_COND_MSG(u256_is_zero(other->m_value), "Division by zero.");
+	u256 r;
+	u256_divmod(nullptr, &r, m_value, other->m_value);
+	m_value = r;
+}
+
+int U256::cmp(const Ref<U256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), 0);
+	return u256_cmp(m_value, other->m_value);
+}
+
+bool U256::is_zero() const {
+	return u256_is_zero(m_value);
+}
+
+int U256::bit_length() const {
+	return u256_bit_length(m_value);
+}
+
+void U256::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("from_string", "str"), &U256::from_string);
+	ClassDB::bind_method(D_METHOD("get_string"), &U256::get_string);
+	ClassDB::bind_method(D_METHOD("from_hex", "hex_string"), &U256::from_hex);
+	ClassDB::bind_method(D_METHOD("to_hex"), &U256::to_hex);
+	ClassDB::bind_method(D_METHOD("from_int", "value"), &U256::from_int);
+	ClassDB::bind_method(D_METHOD("to_int64"), &U256::to_int64);
+	ClassDB::bind_method(D_METHOD("set_bytes", "bytes"), &U256::set_bytes);
+	ClassDB::bind_method(D_METHOD("to_bytes"), &U256::to_bytes);
+	ClassDB::bind_method(D_METHOD("to_bytes_trimmed"), &U256::to_bytes_trimmed);
+	ClassDB::bind_method(D_METHOD("from_big_int", "value"), &U256::from_big_int);
+	ClassDB::bind_method(D_METHOD("to_big_int"), &U256::to_big_int);
+	ClassDB::bind_method(D_METHOD("copy"), &U256::copy);
+
+	ClassDB::bind_method(D_METHOD("add", "other"), &U256::add);
+	ClassDB::bind_method(D_METHOD("sub", "other"), &U256::sub);
+	ClassDB::bind_method(D_METHOD("mul", "other"), &U256::mul);
+	ClassDB::bind_method(D_METHOD("div", "other"), &U256::div);
+	ClassDB::bind_method(D_METHOD("mod", "other"), &U256::mod);
+	ClassDB::bind_method(D_METHOD("shl", "bits"), &U256::shl);
+	ClassDB::bind_method(D_METHOD("shr", "bits"), &U256::shr);
+
+	ClassDB::bind_method(D_METHOD("checked_add", "other"), &U256::checked_add);
+	ClassDB::bind_method(D_METHOD("checked_sub", "other"), &U256::checked_sub);
+	ClassDB::bind_method(D_METHOD("checked_mul", "other"), &U256::checked_mul);
+
+	ClassDB::bind_method(D_METHOD("add_assign", "other"), &U256::add_assign);
+	ClassDB::bind_method(D_METHOD("sub_assign", "other"), &U256::sub_assign);
+	ClassDB::bind_method(D_METHOD("mul_assign", "other"), &U256::mul_assign);
+	ClassDB::bind_method(D_METHOD("div_assign", "other"), &U256::div_assign);
+	ClassDB::bind_method(D_METHOD("mod_assign", "other"), &U256::mod_assign);
+
+	ClassDB::bind_method(D_METHOD("cmp", "other"), &U256::cmp);
+	ClassDB::bind_method(D_METHOD("is_zero"), &U256::is_zero);
+	ClassDB::bind_method(D_METHOD("bit_length"), &U256::bit_length);
+}
+
+// I256
+
+I256::I256() {
+	u256_set_zero(m_value);
+}
+
+I256::~I256() {
+}
+
+bool I256::from_string(const String &str) {
+	bool negative = str.begins_with("-");
+	u256 magnitude;
+	bool ok = _parse_dec(magnitude, negative ? str.substr(1) : str);
+	ERR_FAIL_COND_V_MSG(!ok || !_fits_signed(magnitude, negative), false, "Invalid or out of range I256 decimal string: " + str);
+	if (negative) {
+		u256_neg(m_value, magnitude);
+	} else {
+		m_value = magnitude;
+	}
+	return true;
+}
+
+String I256::get_string() const {
+	if (!u256_is_neg(m_value)) {
+		return _format_dec(m_value);
+	}
+	u256 magnitude;
+	u256_neg(magnitude, m_value);
+	return "-" + _format_dec(magnitude);
+}
+
+bool I256::from_hex(const String &hex_string) {
+	bool negative = hex_string.begins_with("-");
+	u256 magnitude;
+	bool ok = _parse_hex(magnitude, negative ? hex_string.substr(1) : hex_string);
+	ERR_FAIL_COND_V_MSG(!ok || !_fits_signed(magnitude, negative), false, "Invalid or out of range I256 hex string: " + hex_string);
+	if (negative) {
+		u256_neg(m_value, magnitude);
+	} else {
+		m_value = magnitude;
+	}
+	return true;
+}
+
+String I256::to_hex() const {
+	if (!u256_is_neg(m_value)) {
+		return _format_hex(m_value);
+	}
+	u256 magnitude;
+	u256_neg(magnitude, m_value);
+	return "-" + _format_hex(magnitude);
+}
+
+void I256::from_int(int64_t value) {
+	u256_set_u64(m_value, (uint64_t)value);
+	if (value < 0) {
+		m_value.limbs[1] = m_value.limbs[2] = m_value.limbs[3] = ~0ULL;
+	}
+}
+
+int64_t I256::to_int64() const {
+	return (int64_t)m_value.limbs[0];
+}
+
+bool I256::set_bytes(const PackedByteArray &bytes) {
+	ERR_FAIL_COND_V_MSG(bytes.size() > 32, false, "I256 accepts at most 32 bytes.");
+	if (bytes.size() == 0) {
+		u256_set_zero(m_value);
+		return true;
+	}
+	uint8_t buf[32];
+	uint8_t fill = (bytes[0] & 0x80) ? 0xff : 0x00;
+	int pad = 32 - bytes.size();
+	memset(buf, fill, pad);
+	memcpy(buf + pad, bytes.ptr(), bytes.size());
+	return u256_from_be_bytes(m_value, buf, 32);
+}
+
+PackedByteArray I256::to_bytes() const {
+	return _to_word(m_value);
+}
+
+bool I256::from_big_int(const Ref<BigInt> &value) {
+	ERR_FAIL_COND_V(value.is_null(), false);
+	bool negative = mpz_sgn(value->m_number) < 0;
+	u256 magnitude;
+	bool ok = _magnitude_from_mpz(magnitude, value->m_number);
+	ERR_FAIL_COND_V_MSG(!ok || !_fits_signed(magnitude, negative), false, "BigInt does not fit in a signed 256-bit integer.");
+	if (negative) {
+		u256_neg(m_value, magnitude);
+	} else {
+		m_value = magnitude;
+	}
+	return true;
+}
+
+Ref<BigInt> I256::to_big_int() const {
+	Ref<BigInt> result = Ref<BigInt>(memnew(BigInt));
+	u256 magnitude;
+	_abs_signed(magnitude, m_value);
+	u256_to_mpz(result->m_number, magnitude);
+	if (u256_is_neg(m_value)) {
+		mpz_neg(result->m_number, result->m_number);
+	}
+	return result;
+}
+
+Ref<I256> I256::copy() const {
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	result->m_value = m_value;
+	return result;
+}
+
+// Signed overflow checks, shared by the checked_* methods.
+static bool _signed_add_overflows(u256 &r, const u256 &a, const u256 &b) {
+	u256_add(r, a, b);
+	return u256_is_neg(a) == u256_is_neg(b) && u256_is_neg(r) != u256_is_neg(a);
+}
+
+static bool _signed_sub_overflows(u256 &r, const u256 &a, const u256 &b) {
+	u256_sub(r, a, b);
+	return u256_is_neg(a) != u256_is_neg(b) && u256_is_neg(r) != u256_is_neg(a);
+}
+
+static bool _signed_mul_overflows(u256 &r, const u256 &a, const u256 &b) {
+	u256_mul(r, a, b);
+	if (u256_is_zero(a) || u256_is_zero(b)) {
+		return false;
+	}
+	u256 ma, mb, m;
+	_abs_signed(ma, a);
+	_abs_signed(mb, b);
+	if (u256_mul(m, ma, mb)) {
+		return true;
+	}
+	return !_fits_signed(m, u256_is_neg(a) != u256_is_neg(b));
+}
+
+Ref<I256> I256::add(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	u256_add(result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<I256> I256::sub(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	u256_sub(result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<I256> I256::mul(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	u256_mul(result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<I256> I256::div(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	ERR_FAIL_COND_V_MSG(u256_is_zero(other->m_value), Ref<I256>(), "Division by zero.");
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	u256_divmod_signed(&result->m_value, nullptr, m_value, other->m_value);
+	return result;
+}
+
+Ref<I256> I256::mod(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	ERR_FAIL_COND_V_MSG(u256_is_zero(other->m_value), Ref<I256>(), "Division by zero.");
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	u256_divmod_signed(nullptr, &result->m_value, m_value, other->m_value);
+	return result;
+}
+
+Ref<I256> I256::neg() const {
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	u256_neg(result->m_value, m_value);
+	return result;
+}
+
+Ref<I256> I256::abs() const {
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	_abs_signed(result->m_value, m_value);
+	return result;
+}
+
+Ref<I256> I256::checked_add(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	u256 r;
+	if (_signed_add_overflows(r, m_value, other->m_value)) {
+		return Ref<I256>();
+	}
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	result->m_value = r;
+	return result;
+}
+
+Ref<I256> I256::checked_sub(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	u256 r;
+	if (_signed_sub_overflows(r, m_value, other->m_value)) {
+		return Ref<I256>();
+	}
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	result->m_value = r;
+	return result;
+}
+
+Ref<I256> I256::checked_mul(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), Ref<I256>());
+	u256 r;
+	if (_signed_mul_overflows(r, m_value, other->m_value)) {
+		return Ref<I256>();
+	}
+	Ref<I256> result = Ref<I256>(memnew(I256));
+	result->m_value = r;
+	return result;
+}
+
+void I256::add_assign(const Ref<I256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	u256_add(m_value, m_value, other->m_value);
+}
+
+void I256::sub_assign(const Ref<I256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	u256_sub(m_value, m_value, other->m_value);
+}
+
+void I256::mul_assign(const Ref<I256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	u256_mul(m_value, m_value, other->m_value);
+}
+
+void I256::div_assign(const Ref<I256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	ERR_FAIL_COND_MSG(u256_is_zero(other->m_value), "Division by zero.");
+	u256 q;
+	u256_divmod_signed(&q, nullptr, m_value, other->m_value);
+	m_value = q;
+}
+
+void I256::mod_assign(const Ref<I256> &other) {
+	ERR_FAIL_COND(other.is_null());
+	ERR_FAIL_COND_MSG(u256_is_zero(other->m_value), "Division by zero.");
+	u256 r;
+	u256_divmod_signed(nullptr, &r, m_value, other->m_value);
+	m_value = r;
+}
+
+int I256::cmp(const Ref<I256> &other) const {
+	ERR_FAIL_COND_V(other.is_null(), 0);
+	return u256_cmp_signed(m_value, other->m_value);
+}
+
+int I256::sgn() const {
+	if (u256_is_zero(m_value)) {
+		return 0;
+	}
+	return u256_is_neg(m_value) ? -1 : 1;
+}
+
+bool I256::is_zero() const {
+	return u256_is_zero(m_value);
+}
+
+void I256::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("from_string", "str"), &I256::from_string);
+	ClassDB::bind_method(D_METHOD("get_string"), &I256::get_string);
+	ClassDB::bind_method(D_METHOD("from_hex", "hex_string"), &I256::from_hex);
+	ClassDB::bind_method(D_METHOD("to_hex"), &I256::to_hex);
+	ClassDB::bind_method(D_METHOD("from_int", "value"), &I256::from_int);
+	ClassDB::bind_method(D_METHOD("to_int64"), &I256::to_int64);
+	ClassDB::bind_method(D_METHOD("set_bytes", "bytes"), &I256::set_bytes);
+	ClassDB::bind_method(D_METHOD("to_bytes"), &I256::to_bytes);
+	ClassDB::bind_method(D_METHOD("from_big_int", "value"), &I256::from_big_int);
+	ClassDB::bind_method(D_METHOD("to_big_int"), &I256::to_big_int);
+	ClassDB::bind_method(D_METHOD("copy"), &I256::copy);
+
+	ClassDB::bind_method(D_METHOD("add", "other"), &I256::add);
+	ClassDB::bind_method(D_METHOD("sub", "other"), &I256::sub);
+	ClassDB::bind_method(D_METHOD("mul", "other"), &I256::mul);
+	ClassDB::bind_method(D_METHOD("div", "other"), &I256::div);
+	ClassDB::bind_method(D_METHOD("mod", "other"), &I256::mod);
+	ClassDB::bind_method(D_METHOD("neg"), &I256::neg);
+	ClassDB::bind_method(D_METHOD("abs"), &I256::abs);
+
+	ClassDB::bind_method(D_METHOD("checked_add", "other"), &I256::checked_add);
+	ClassDB::bind_method(D_METHOD("checked_sub", "other"), &I256::checked_sub);
+	ClassDB::bind_method(D_METHOD("checked_mul", "other"), &I256::checked_mul);
+
+	ClassDB::bind_method(D_METHOD("add_assign", "other"), &I256::add_assign);
+	ClassDB::bind_method(D_METHOD("sub_assign", "other"), &I256::sub_assign);
+	ClassDB::bind_method(D_METHOD("mul_assign", "other"), &I256::mul_assign);
+	ClassDB::bind_method(D_METHOD("div_assign", "other"), &I256::div_assign);
+	ClassDB::bind_method(D_METHOD("mod_assign", "other"), &I256::mod_assign);
+
+	ClassDB::bind_method(D_METHOD("cmp", "other"), &I256::cmp);
+	ClassDB::bind_method(D_METHOD("sgn"), &I256::sgn);
+	ClassDB::bind_method(D_METHOD("is_zero"), &I256::is_zero);
+}
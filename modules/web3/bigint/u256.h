@@ -0,0 +1,132 @@
+#ifndef U256_H
+#define U256_H
+
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+#include "core/error/error_macros.h"
+
+#include "u256_math.h"
+#include "big_int.h"
+
+// Conversions between u256 and GMP integers.
+// u256_from_mpz fails for negative values and values wider than 256 bits.
+bool u256_from_mpz(u256 &r, const mpz_t value);
+void u256_to_mpz(mpz_t r, const u256 &value);
+
+// Fixed-width unsigned 256-bit integer.
+// The value is stored inline (no GMP allocation), arithmetic wraps modulo 2^256
+// and the checked_* variants return null on overflow instead of wrapping.
+class U256 : public RefCounted {
+	GDCLASS(U256, RefCounted);
+
+protected:
+	static void _bind_methods();
+
+public:
+	u256 m_value;
+
+	U256();
+	~U256();
+
+	const u256 &get_value() const { return m_value; }
+	void set_value(const u256 &value) { m_value = value; }
+
+	bool from_string(const String &str);
+	String get_string() const;
+	bool from_hex(const String &hex_string);
+	String to_hex() const;
+	bool from_int(int64_t value);
+	int64_t to_int64() const;
+	// Accepts up to 32 big-endian bytes.
+	bool set_bytes(const PackedByteArray &bytes);
+	// Always returns 32 big-endian bytes, suitable for ABI words.
+	PackedByteArray to_bytes() const;
+	// Returns the minimal big-endian bytes, suitable for RLP.
+	PackedByteArray to_bytes_trimmed() const;
+	bool from_big_int(const Ref<BigInt> &value);
+	Ref<BigInt> to_big_int() const;
+	Ref<U256> copy() const;
+
+	// Wrapping arithmetic, returns a new value.
+	Ref<U256> add(const Ref<U256> &other) const;
+	Ref<U256> sub(const Ref<U256> &other) const;
+	Ref<U256> mul(const Ref<U256> &other) const;
+	Ref<U256> div(const Ref<U256> &other) const;
+	Ref<U256> mod(const Ref<U256> &other) const;
+	Ref<U256> shl(int bits) const;
+	Ref<U256> shr(int bits) const;
+
+	// Returns null when the result does not fit in 256 bits.
+	Ref<U256> checked_add(const Ref<U256> &other) const;
+	Ref<U256> checked_sub(const Ref<U256> &other) const;
+	Ref<U256> checked_mul(const Ref<U256> &other) const;
+
+	// In-place wrapping arithmetic, avoids allocating a result object.
+	void add_assign(const Ref<U256> &other);
+	void sub_assign(const Ref<U256> &other);
+	void mul_assign(const Ref<U256> &other);
+	void div_assign(const Ref<U256> &other);
+	void mod_assign(const Ref<U256> &other);
+
+	int cmp(const Ref<U256> &other) const;
+	bool is_zero() const;
+	int bit_length() const;
+};
+
+// Fixed-width signed 256-bit integer (two's complement).
+// Shares the representation of U256, so to_bytes() yields the ABI int256 encoding.
+class I256 : public RefCounted {
+	GDCLASS(I256, RefCounted);
+
+protected:
+	static void _bind_methods();
+
+public:
+	u256 m_value;
+
+	I256();
+	~I256();
+
+	const u256 &get_value() const { return m_value; }
+	void set_value(const u256 &value) { m_value = value; }
+
+	bool from_string(const String &str);
+	String get_string() const;
+	bool from_hex(const String &hex_string);
+	String to_hex() const;
+	void from_int(int64_t value);
+	int64_t to_int64() const;
+	// Accepts up to 32 big-endian two's complement bytes, sign-extended.
+	bool set_bytes(const PackedByteArray &bytes);
+	PackedByteArray to_bytes() const;
+	bool from_big_int(const Ref<BigInt> &value);
+	Ref<BigInt> to_big_int() const;
+	Ref<I256> copy() const;
+
+	Ref<I256> add(const Ref<I256> &other) const;
+	Ref<I256> sub(const Ref<I256> &other) const;
+	Ref<I256> mul(const Ref<I256> &other) const;
+	// Truncates toward zero.
+	Ref<I256> div(const Ref<I256> &other) const;
+	// The remainder takes the sign of the dividend.
+	Ref<I256> mod(const Ref<I256> &other) const;
+	Ref<I256> neg() const;
+	Ref<I256> abs() const;
+
+	Ref<I256> checked_add(const Ref<I256> &other) const;
+	Ref<I256> checked_sub(const Ref<I256> &other) const;
+	Ref<I256> checked_mul(const Ref<I256> &other) const;
+
+	void add_assign(const Ref<I256> &other);
+	void sub_assign(const Ref<I256> &other);
+	void mul_assign(const Ref<I256> &other);
+	void div_assign(const Ref<I256> &other);
+	void mod_assign(const Ref<I256> &other);
+
+	int cmp(const Ref<I256> &other) const;
+	int sgn() const;
+	bool is_zero() const;
+};
+
+#endif // U256_H
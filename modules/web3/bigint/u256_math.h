@@ -0,0 +1,537 @@
+#ifndef U256_MATH_H
+#define U256_MATH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Fixed-width 256-bit unsigned integer arithmetic.
+//
+// Values are stored inline as four 64-bit limbs, least significant limb first,
+// so they can live on the stack or inside other structs without any heap
+// allocation. All arithmetic wraps modulo 2^256; functions that can overflow
+// report it through their return value so callers can build checked variants.
+// Signed (two's complement) helpers are provided for I256.
+
+struct u256 {
+	uint64_t limbs[4];
+};
+
+#define U256_MAX_DEC_DIGITS 78
+#define U256_MAX_HEX_DIGITS 64
+
+static inline void u256_set_zero(u256 &r) {
+	r.limbs[0] = r.limbs[1] = r.limbs[2] = r.limbs[3] = 0;
+}
+
+static inline void u256_set_u64(u256 &r, uint64_t v) {
+	r.limbs[0] = v;
+	r.limbs[1] = r.limbs[2] = r.limbs[3] = 0;
+}
+
+static inline u256 u256_from_u64(uint64_t v) {
+	u256 r;
+	u256_set_u64(r, v);
+	return r;
+}
+
+static inline bool u256_is_zero(const u256 &a) {
+	return (a.limbs[0] | a.limbs[1] | a.limbs[2] | a.limbs[3]) == 0;
+}
+
+static inline bool u256_fits_u64(const u256 &a) {
+	return (a.limbs[1] | a.limbs[2] | a.limbs[3]) == 0;
+}
+
+static inline bool u256_is_neg(const u256 &a) {
+	return (a.limbs[3] >> 63) != 0;
+}
+
+static inline int u256_cmp(const u256 &a, const u256 &b) {
+	for (int i = 3; i >= 0; i--) {
+		if (a.limbs[i] != b.limbs[i]) {
+			return a.limbs[i] < b.limbs[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+// Signed comparison of two's complement values.
+static inline int u256_cmp_signed(const u256 &a, const u256 &b) {
+	bool an = u256_is_neg(a);
+	bool bn = u256_is_neg(b);
+	if (an != bn) {
+		return an ? -1 : 1;
+	}
+	return u256_cmp(a, b);
+}
+
+// r = a + b, returns the carry out of the top limb.
+static inline bool u256_add(u256 &r, const u256 &a, const u256 &b) {
+	uint64_t carry = 0;
+	for (int i = 0; i < 4; i++) {
+		uint64_t s = a.limbs[i] + carry;
+		uint64_t c1 = s < carry;
+		uint64_t t = s + b.limbs[i];
+		uint64_t c2 = t < s;
+		r.limbs[i] = t;
+		carry = c1 | c2;
+	}
+	return carry != 0;
+}
+
+// r = a - b, returns the borrow out of the top limb.
+static inline bool u256_sub(u256 &r, const u256 &a, const u256 &b) {
+	uint64_t borrow = 0;
+	for (int i = 0; i < 4; i++) {
+		uint64_t ai = a.limbs[i];
+		uint64_t d = ai - b.limbs[i];
+		uint64_t b1 = ai < b.limbs[i];
+		uint64_t e = d - borrow;
+		uint64_t b2 = d < borrow;
+		r.limbs[i] = e;
+		borrow = b1 | b2;
+	}
+	return borrow != 0;
+}
+
+// r = -a (two's complement).
+static inline void u256_neg(u256 &r, const u256 &a) {
+	u256 zero;
+	u256_set_zero(zero);
+	u256_sub(r, zero, a);
+}
+
+// 64x64 -> 128 bit multiply, returns the low half and stores the high half.
+static inline uint64_t u256_mul64(uint64_t a, uint64_t b, uint64_t *hi) {
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 p = (unsigned __int128)a * b;
+	*hi = (uint64_t)(p >> 64);
+	return (uint64_t)p;
+#else
+	uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+	uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+	uint64_t p0 = a_lo * b_lo;
+	uint64_t p1 = a_lo * b_hi;
+	uint64_t p2 = a_hi * b_lo;
+	uint64_t p3 = a_hi * b_hi;
+	uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+	*hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+	return (mid << 32) | (uint32_t)p0;
+#endif
+}
+
+// r = a * b mod 2^256, returns true when the full product does not fit in 256 bits.
+static inline bool u256_mul(u256 &r, const u256 &a, const u256 &b) {
+	uint64_t out[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	for (int i = 0; i < 4; i++) {
+		if (a.limbs[i] == 0) {
+			continue;
+		}
+		uint64_t carry = 0;
+		for (int j = 0; j < 4; j++) {
+			uint64_t hi;
+			uint64_t lo = u256_mul64(a.limbs[i], b.limbs[j], &hi);
+			lo += carry;
+			hi += lo < carry;
+			uint64_t cur = out[i + j];
+			lo += cur;
+			hi += lo < cur;
+			out[i + j] = lo;
+			carry = hi;
+		}
+		out[i + 4] = carry;
+	}
+	memcpy(r.limbs, out, sizeof(r.limbs));
+	return (out[4] | out[5] | out[6] | out[7]) != 0;
+}
+
+// r = a * m + add for a 64-bit multiplier, returns the carried-out top limb.
+static inline uint64_t u256_mul_u64_add(u256 &r, const u256 &a, uint64_t m, uint64_t add) {
+	uint64_t carry = add;
+	for (int i = 0; i < 4; i++) {
+		uint64_t hi;
+		uint64_t lo = u256_mul64(a.limbs[i], m, &hi);
+		lo += carry;
+		hi += lo < carry;
+		r.limbs[i] = lo;
+		carry = hi;
+	}
+	return carry;
+}
+
+static inline int u256_bit_length(const u256 &a) {
+	for (int i = 3; i >= 0; i--) {
+		uint64_t v = a.limbs[i];
+		if (v != 0) {
+			int bits = 0;
+			while (v != 0) {
+				bits++;
+				v >>= 1;
+			}
+			return i * 64 + bits;
+		}
+	}
+	return 0;
+}
+
+// Number of bytes needed to hold the value without leading zero bytes (0 for zero).
+static inline int u256_byte_length(const u256 &a) {
+	return (u256_bit_length(a) + 7) / 8;
+}
+
+static inline void u256_shl(u256 &r, const u256 &a, unsigned int shift) {
+	if (shift >= 256) {
+		u256_set_zero(r);
+		return;
+	}
+	u256 t;
+	unsigned int limb_shift = shift / 64;
+	unsigned int bit_shift = shift % 64;
+	for (int i = 3; i >= 0; i--) {
+		int src = i - (int)limb_shift;
+		uint64_t v = 0;
+		if (src >= 0) {
+			v = a.limbs[src] << bit_shift;
+			if (bit_shift != 0 && src > 0) {
+				v |= a.limbs[src - 1] >> (64 - bit_shift);
+			}
+		}
+		t.limbs[i] = v;
+	}
+	r = t;
+}
+
+static inline void u256_shr(u256 &r, const u256 &a, unsigned int shift) {
+	if (shift >= 256) {
+		u256_set_zero(r);
+		return;
+	}
+	u256 t;
+	unsigned int limb_shift = shift / 64;
+	unsigned int bit_shift = shift % 64;
+	for (int i = 0; i < 4; i++) {
+		unsigned int src = i + limb_shift;
+		uint64_t v = 0;
+		if (src < 4) {
+			v = a.limbs[src] >> bit_shift;
+			if (bit_shift != 0 && src < 3) {
+				v |= a.limbs[src + 1] << (64 - bit_shift);
+			}
+		}
+		t.limbs[i] = v;
+	}
+	r = t;
+}
+
+// Divides a by a 32-bit divisor in place and returns the remainder.
+static inline uint32_t u256_divmod_u32(u256 &a, uint32_t d) {
+	uint64_t rem = 0;
+	for (int i = 3; i >= 0; i--) {
+		uint64_t hi = (rem << 32) | (a.limbs[i] >> 32);
+		uint64_t qh = hi / d;
+		rem = hi % d;
+		uint64_t lo = (rem << 32) | (a.limbs[i] & 0xffffffffULL);
+		uint64_t ql = lo / d;
+		rem = lo % d;
+		a.limbs[i] = (qh << 32) | ql;
+	}
+	return (uint32_t)rem;
+}
+
+// q = a / b, rem = a % b (unsigned). Returns false on division by zero.
+// Uses Knuth's algorithm D over 32-bit digits so no 128-bit division is needed.
+static inline bool u256_divmod(u256 *q, u256 *rem, const u256 &a, const u256 &b) {
+	if (u256_is_zero(b)) {
+		return false;
+	}
+	if (u256_cmp(a, b) < 0) {
+		if (rem) {
+			*rem = a;
+		}
+		if (q) {
+			u256_set_zero(*q);
+		}
+		return true;
+	}
+	if (u256_fits_u64(b) && b.limbs[0] <= 0xffffffffULL) {
+		u256 t = a;
+		uint32_t r = u256_divmod_u32(t, (uint32_t)b.limbs[0]);
+		if (q) {
+			*q = t;
+		}
+		if (rem) {
+			u256_set_u64(*rem, r);
+		}
+		return true;
+	}
+
+	uint32_t u[9], v[8], qd[8];
+	for (int i = 0; i < 4; i++) {
+		u[2 * i] = (uint32_t)a.limbs[i];
+		u[2 * i + 1] = (uint32_t)(a.limbs[i] >> 32);
+		v[2 * i] = (uint32_t)b.limbs[i];
+		v[2 * i + 1] = (uint32_t)(b.limbs[i] >> 32);
+	}
+	u[8] = 0;
+	int n = 8;
+	while (n > 0 && v[n - 1] == 0) {
+		n--;
+	}
+	int m = 8;
+	while (m > 0 && u[m - 1] == 0) {
+		m--;
+	}
+
+	// Normalize so the top divisor digit has its high bit set.
+	int s = 0;
+	while ((v[n - 1] << s & 0x80000000U) == 0) {
+		s++;
+	}
+	if (s != 0) {
+		for (int i = n - 1; i > 0; i--) {
+			v[i] = (v[i] << s) | (v[i - 1] >> (32 - s));
+		}
+		v[0] <<= s;
+		u[m] = u[m - 1] >> (32 - s);
+		for (int i = m - 1; i > 0; i--) {
+			u[i] = (u[i] << s) | (u[i - 1] >> (32 - s));
+		}
+		u[0] <<= s;
+	} else {
+		u[m] = 0;
+	}
+
+	memset(qd, 0, sizeof(qd));
+	for (int j = m - n; j >= 0; j--) {
+		uint64_t num = ((uint64_t)u[j + n] << 32) | u[j + n - 1];
+		uint64_t qhat = num / v[n - 1];
+		uint64_t rhat = num % v[n - 1];
+		while (qhat > 0xffffffffULL || (n > 1 && qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2]))) {
+			qhat--;
+			rhat += v[n - 1];
+			if (rhat > 0xffffffffULL) {
+				break;
+			}
+		}
+
+		int64_t borrow = 0;
+		uint64_t carry = 0;
+		for (int i = 0; i < n; i++) {
+			uint64_t p = qhat * v[i] + carry;
+			carry = p >> 32;
+			int64_t t = (int64_t)u[i + j] - (int64_t)(uint32_t)p + borrow;
+			u[i + j] = (uint32_t)t;
+			borrow = t >> 32;
+		}
+		int64_t t = (int64_t)u[j + n] - (int64_t)carry + borrow;
+		u[j + n] = (uint32_t)t;
+
+		if (t < 0) {
+			// qhat was one too large, add the divisor back.
+			qhat--;
+			uint64_t c = 0;
+			for (int i = 0; i < n; i++) {
+				uint64_t sum = (uint64_t)u[i + j] + v[i] + c;
+				u[i + j] = (uint32_t)sum;
+				c = sum >> 32;
+			}
+			u[j + n] = (uint32_t)((uint64_t)u[j + n] + c);
+		}
+		qd[j] = (uint32_t)qhat;
+	}
+
+	if (q) {
+		for (int i = 0; i < 4; i++) {
+			q->limbs[i] = ((uint64_t)qd[2 * i + 1] << 32) | qd[2 * i];
+		}
+	}
+	if (rem) {
+		uint32_t rd[8];
+		memset(rd, 0, sizeof(rd));
+		for (int i = 0; i < n; i++) {
+			rd[i] = (u[i] >> s) | (s != 0 && i + 1 < 9 ? (uint32_t)((uint64_t)u[i + 1] << (32 - s)) : 0);
+		}
+		for (int i = 0; i < 4; i++) {
+			rem->limbs[i] = ((uint64_t)rd[2 * i + 1] << 32) | rd[2 * i];
+		}
+	}
+	return true;
+}
+
+// Signed truncating division (rounds toward zero, remainder takes the dividend's sign).
+static inline bool u256_divmod_signed(u256 *q, u256 *rem, const u256 &a, const u256 &b) {
+	bool an = u256_is_neg(a);
+	bool bn = u256_is_neg(b);
+	u256 ua = a, ub = b;
+	if (an) {
+		u256_neg(ua, a);
+	}
+	if (bn) {
+		u256_neg(ub, b);
+	}
+	u256 uq, ur;
+	if (!u256_divmod(&uq, &ur, ua, ub)) {
+		return false;
+	}
+	if (q) {
+		if (an != bn) {
+			u256_neg(uq, uq);
+		}
+		*q = uq;
+	}
+	if (rem) {
+		if (an) {
+			u256_neg(ur, ur);
+		}
+		*rem = ur;
+	}
+	return true;
+}
+
+// Reads up to 32 big-endian bytes. Returns false if len > 32.
+static inline bool u256_from_be_bytes(u256 &r, const uint8_t *bytes, size_t len) {
+	if (len > 32) {
+		return false;
+	}
+	u256_set_zero(r);
+	for (size_t i = 0; i < len; i++) {
+		size_t pos = len - 1 - i;
+		r.limbs[i / 8] |= (uint64_t)bytes[pos] << ((i % 8) * 8);
+	}
+	return true;
+}
+
+// Writes exactly 32 big-endian bytes.
+static inline void u256_to_be_bytes(const u256 &a, uint8_t *out) {
+	for (int i = 0; i < 32; i++) {
+		out[31 - i] = (uint8_t)(a.limbs[i / 8] >> ((i % 8) * 8));
+	}
+}
+
+// Writes the minimal big-endian representation (no leading zeros, nothing for zero)
+// into out, which must hold 32 bytes. Returns the number of bytes written.
+static inline size_t u256_to_be_bytes_min(const u256 &a, uint8_t *out) {
+	int len = u256_byte_length(a);
+	for (int i = 0; i < len; i++) {
+		out[len - 1 - i] = (uint8_t)(a.limbs[i / 8] >> ((i % 8) * 8));
+	}
+	return (size_t)len;
+}
+
+static inline int u256_hex_digit(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+// Parses an unsigned decimal string. Returns false on empty input, invalid
+// characters or values that do not fit in 256 bits.
+static inline bool u256_from_dec(u256 &r, const char *str, size_t len) {
+	u256_set_zero(r);
+	if (len == 0) {
+		return false;
+	}
+	size_t i = 0;
+	while (i < len) {
+		// Consume up to 19 digits at a time to keep the multiply count low.
+		uint64_t chunk = 0;
+		uint64_t scale = 1;
+		size_t end = i + 19 < len ? i + 19 : len;
+		for (; i < end; i++) {
+			char c = str[i];
+			if (c < '0' || c > '9') {
+				return false;
+			}
+			chunk = chunk * 10 + (uint64_t)(c - '0');
+			scale *= 10;
+		}
+		if (u256_mul_u64_add(r, r, scale, chunk) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Parses an unsigned hex string with an optional 0x prefix.
+static inline bool u256_from_hex(u256 &r, const char *str, size_t len) {
+	u256_set_zero(r);
+	if (len >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+		str += 2;
+		len -= 2;
+	}
+	if (len == 0) {
+		return false;
+	}
+	while (len > 1 && str[0] == '0') {
+		str++;
+		len--;
+	}
+	if (len > U256_MAX_HEX_DIGITS) {
+		return false;
+	}
+	for (size_t i = 0; i < len; i++) {
+		int d = u256_hex_digit(str[len - 1 - i]);
+		if (d < 0) {
+			return false;
+		}
+		r.limbs[i / 16] |= (uint64_t)d << ((i % 16) * 4);
+	}
+	return true;
+}
+
+// Writes the decimal representation into buf (at least U256_MAX_DEC_DIGITS + 1
+// bytes), NUL terminated. Returns the number of digits written.
+static inline size_t u256_to_dec(const u256 &a, char *buf) {
+	char tmp[U256_MAX_DEC_DIGITS + 1];
+	size_t n = 0;
+	u256 t = a;
+	if (u256_is_zero(t)) {
+		buf[0] = '0';
+		buf[1] = '\0';
+		return 1;
+	}
+	while (!u256_is_zero(t)) {
+		uint32_t chunk = u256_divmod_u32(t, 1000000000U);
+		bool last = u256_is_zero(t);
+		for (int k = 0; k < 9; k++) {
+			tmp[n++] = (char)('0' + chunk % 10);
+			chunk /= 10;
+			if (last && chunk == 0) {
+				break;
+			}
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		buf[i] = tmp[n - 1 - i];
+	}
+	buf[n] = '\0';
+	return n;
+}
+
+// Writes the minimal lowercase hex representation (no prefix, "0" for zero) into
+// buf (at least U256_MAX_HEX_DIGITS + 1 bytes). Returns the number of digits.
+static inline size_t u256_to_hex(const u256 &a, char *buf) {
+	static const char digits[] = "0123456789abcdef";
+	int nibbles = (u256_bit_length(a) + 3) / 4;
+	if (nibbles == 0) {
+		buf[0] = '0';
+		buf[1] = '\0';
+		return 1;
+	}
+	for (int i = 0; i < nibbles; i++) {
+		int pos = nibbles - 1 - i;
+		buf[i] = digits[(a.limbs[pos / 16] >> ((pos % 16) * 4)) & 0xf];
+	}
+	buf[nibbles] = '\0';
+	return (size_t)nibbles;
+}
+
+#endif // U256_MATH_H
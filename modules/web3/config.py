@@ -5,3 +5,11 @@ def can_build(env, platform):
 
 def configure(env):
     pass
+
+def get_opts(platform):
+    from SCons.Variables import EnumVariable
+
+    return [
+        # opt64: unrolled, lane complementing; compact64: smallest code size.
+        EnumVariable("web3_keccak", "Keccak-p[1600] implementation", "opt64", ("opt64", "compact64")),
+    ]
@@ -2,10 +2,13 @@
 #include "account.h"
 #include "core/crypto/crypto_core.h"
 #include "core/error/error_list.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "eth_abi/abi_util.h"
 #include "eth_ecdsa.h"
 #include "keccak256.h"
+#include "secp256k1_pubkey_batch.h"
 
 #include "thirdparty/mbedtls/include/mbedtls/pkcs5.h"
 
@@ -59,6 +62,31 @@ PackedByteArray EthAccount::sign_data_with_prefix(const PackedByteArray &data) c
 	return result;
 }
 
+bool EthAccount::sign_hash32(const uint8_t *hash, uint8_t *r_signature, const secp256k1_context *ctx) const {
+	struct eth_ecdsa_signature signature {};
+
+	int r = ctx != nullptr ? eth_ecdsa_sign_with_context(ctx, &signature, account.privkey, hash) : eth_ecdsa_sign(&signature, account.privkey, hash);
+	if (r != 1) {
+		return false;
+	}
+
+	memcpy(r_signature, signature.r, sizeof(signature.r));
+	memcpy(r_signature + 32, signature.s, sizeof(signature.s));
+	r_signature[64] = signature.recid;
+	return true;
+}
+
+PackedByteArray EthAccount::sign_hash(const PackedByteArray &hash) const {
+	ERR_FAIL_COND_V_MSG(hash.size() != 32, PackedByteArray(), "hash must be 32 bytes");
+
+	PackedByteArray result;
+	result.resize(65);
+	if (!sign_hash32(hash.ptr(), result.ptrw())) {
+		return PackedByteArray();
+	}
+	return result;
+}
+
 static String convert_to_hex(const PackedByteArray &byte_array) {
 	return packedByteArrayToHexString(byte_array);
 }
@@ -91,6 +119,7 @@ void EthAccount::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_hex_address"), &EthAccount::get_hex_address);
 	ClassDB::bind_method(D_METHOD("sign_data", "data"), &EthAccount::sign_data);
 	ClassDB::bind_method(D_METHOD("sign_data_with_prefix", "data"), &EthAccount::sign_data_with_prefix);
+	ClassDB::bind_method(D_METHOD("sign_hash", "hash"), &EthAccount::sign_hash);
 }
 
 Ref<EthAccount> EthAccountManager::create(const PackedByteArray &entropy) {
@@ -118,6 +147,116 @@ Ref<EthAccount> EthAccountManager::privateKeyToAccount(const PackedByteArray &pr
 	return account;
 }
 
+// Keys per worker task, the size of the groups secp256k1_ec_pubkey_create_batch
+// shares an inversion over.
+static const int KEY_BATCH_GROUP = 64;
+// Largest count of create_batch, keeps count * 33 far from overflowing int.
+static const int MAX_KEY_BATCH = 1 << 20;
+
+struct KeyBatch {
+	const secp256k1_context *ctx = nullptr;
+	int count = 0;
+	const uint8_t *private_keys = nullptr;
+	uint8_t *public_keys = nullptr;
+	uint8_t *addresses = nullptr;
+	SafeNumeric<uint32_t> failed;
+};
+
+static void _derive_key_group(void *p_userdata, uint32_t p_group) {
+	KeyBatch *batch = static_cast<KeyBatch *>(p_userdata);
+	int first = p_group * KEY_BATCH_GROUP;
+	int n = MIN(KEY_BATCH_GROUP, batch->count - first);
+	uint8_t uncompressed[KEY_BATCH_GROUP * 65];
+	uint8_t hashes[KEY_BATCH_GROUP * 32];
+	const uint8_t *inputs[KEY_BATCH_GROUP];
+	size_t lens[KEY_BATCH_GROUP];
+
+	if (secp256k1_ec_pubkey_create_batch(batch->ctx, uncompressed, batch->private_keys + first * 32, n, SECP256K1_EC_UNCOMPRESSED) != 1) {
+		batch->failed.increment();
+		return;
+	}
+
+	for (int i = 0; i < n; i++) {
+		const uint8_t *point = uncompressed + i * 65;
+		uint8_t *public_key = batch->public_keys + (first + i) * 33;
+		public_key[0] = 0x02 | (point[64] & 1);
+		memcpy(public_key + 1, point + 1, 32);
+		inputs[i] = point + 1;
+		lens[i] = 64;
+	}
+	if (eth_keccak256_batch(hashes, inputs, lens, n) != 1) {
+		batch->failed.increment();
+		return;
+	}
+	for (int i = 0; i < n; i++) {
+		memcpy(batch->addresses + (first + i) * 20, hashes + i * 32 + 12, 20);
+	}
+}
+
+Dictionary EthAccountManager::create_batch(int count, const PackedByteArray &entropy) {
+	ERR_FAIL_COND_V_MSG(count < 0, Dictionary(), "count must not be negative");
+	ERR_FAIL_COND_V_MSG(count > MAX_KEY_BATCH, Dictionary(), vformat("count must not exceed %d", MAX_KEY_BATCH));
+	ERR_FAIL_COND_V_MSG(!entropy.is_empty() && entropy.size() != 32, Dictionary(), "entropy must be 32 bytes");
+
+	PackedByteArray private_keys;
+	PackedByteArray public_keys;
+	PackedByteArray addresses;
+	private_keys.resize(count * 32);
+	public_keys.resize(count * 33);
+	addresses.resize(count * 20);
+
+	const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+	ERR_FAIL_NULL_V_MSG(ctx, Dictionary(), "Failed to create secp256k1 context");
+
+	CryptoCore::RandomGenerator rng;
+	bool ok = rng.init() == OK;
+	uint8_t *keys = private_keys.ptrw();
+	for (int i = 0; ok && i < count; i++) {
+		uint8_t *key = keys + i * 32;
+		// As create: keccak256(random || entropy) when entropy is given.
+		do {
+			uint8_t seed[64];
+			ok = rng.get_random_bytes(seed, 32) == OK;
+			if (ok && entropy.is_empty()) {
+				memcpy(key, seed, 32);
+			} else if (ok) {
+				memcpy(seed + 32, entropy.ptr(), 32);
+				ok = eth_keccak256(key, seed, 64) == 1;
+			}
+			memset(seed, 0, sizeof(seed));
+		} while (ok && secp256k1_ec_seckey_verify(ctx, key) != 1);
+	}
+
+	KeyBatch batch;
+	batch.ctx = ctx;
+	batch.count = count;
+	batch.private_keys = keys;
+	batch.public_keys = public_keys.ptrw();
+	batch.addresses = addresses.ptrw();
+
+	uint32_t groups = (count + KEY_BATCH_GROUP - 1) / KEY_BATCH_GROUP;
+	if (!ok || groups == 0) {
+		// Nothing to derive.
+	} else if (groups == 1) {
+		_derive_key_group(&batch, 0);
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_derive_key_group, &batch, groups, -1, true, "Create accounts");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	eth_ecdsa_context_release(ctx);
+
+	if (!ok || batch.failed.get() != 0) {
+		memset(keys, 0, count * 32);
+		ERR_FAIL_V_MSG(Dictionary(), "Failed to create accounts");
+	}
+
+	Dictionary result;
+	result["private_keys"] = private_keys;
+	result["public_keys"] = public_keys;
+	result["addresses"] = addresses;
+	return result;
+}
+
 String generate_uuid_v4() {
 	CryptoCore::RandomGenerator rng;
 
@@ -480,6 +619,11 @@ void EthAccountManager::_bind_methods() {
 			D_METHOD("privateKeyToAccount", "privkey"),
 			&EthAccountManager::privateKeyToAccount);
 
+	ClassDB::bind_static_method("EthAccountManager",
+			D_METHOD("create_batch", "count", "entropy"),
+			&EthAccountManager::create_batch,
+			DEFVAL(PackedByteArray()));
+
 	ClassDB::bind_static_method("EthAccountManager",
 			D_METHOD("encrypt", "private_key", "password", "options"),
 			&EthAccountManager::encrypt,
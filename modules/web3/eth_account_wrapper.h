@@ -65,6 +65,20 @@ public:
 	 */
 	PackedByteArray sign_data_with_prefix(const PackedByteArray &data) const;
 
+	/**
+	 * @brief Sign an already computed 32-byte hash, e.g. a cached transaction hash.
+	 * @param hash Byte array of the 32-byte hash.
+	 * @return Byte array of the signed data (r, s, recid), empty on error.
+	 */
+	PackedByteArray sign_hash(const PackedByteArray &hash) const;
+
+	/**
+	 * @brief Same as sign_hash, writing r, s, recid to a 65-byte buffer.
+	 * @param ctx Optional shared signing context, a temporary one is used when null.
+	 * @return True on success.
+	 */
+	bool sign_hash32(const uint8_t *hash, uint8_t *r_signature, const secp256k1_context *ctx = nullptr) const;
+
 	/**
 	 * @brief Initialize the account.
 	 * @param m_account Account data structure.
@@ -145,6 +159,22 @@ public:
 	 */
 	static Ref<EthAccount> privateKeyToAccount(const PackedByteArray &privkey);
 
+	/**
+	 * @brief Create many Ethereum accounts at once, spread over the worker thread pool.
+	 *
+	 *        Public keys are computed in groups sharing one field inversion and
+	 *        addresses are hashed four at a time, much faster than calling create
+	 *        in a loop. Each key still has its own multiplication by G, keys
+	 *        derived from each other could share it but one leaked key would
+	 *        then expose all of them.
+	 * @param count Number of accounts to create, at most 1048576.
+	 * @param entropy Optional 32 bytes mixed into every private key, as in create.
+	 * @return Dictionary with packed "private_keys" (32 bytes each), "public_keys"
+	 *         (33-byte compressed, as EthAccount.get_public_key) and "addresses"
+	 *         (20 bytes each), empty on error.
+	 */
+	static Dictionary create_batch(int count, const PackedByteArray &entropy = {});
+
 	/**
 	 * @brief Create an Ethereum account from a private key.
 	 * @param privkey Byte array of the account's private key.
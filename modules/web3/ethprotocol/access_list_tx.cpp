@@ -0,0 +1,23 @@
+#include "access_list_tx.h"
+
+void AccessListTx::set_gas_price(Ref<BigInt> gas_price) {
+	_set_uint(gas_price, m_fields.gas_price);
+}
+
+Ref<BigInt> AccessListTx::get_gas_price() const {
+	return _to_big_int(m_fields.gas_price);
+}
+
+Ref<AccessListTx> AccessListTx::from_raw(const PackedByteArray &raw) {
+	Ref<AccessListTx> tx = Ref<AccessListTx>(memnew(AccessListTx));
+	if (!tx->_decode_raw(raw)) {
+		return Ref<AccessListTx>();
+	}
+	return tx;
+}
+
+void AccessListTx::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_gas_price", "gas_price"), &AccessListTx::set_gas_price);
+	ClassDB::bind_method(D_METHOD("get_gas_price"), &AccessListTx::get_gas_price);
+	ClassDB::bind_static_method("AccessListTx", D_METHOD("from_raw", "raw"), &AccessListTx::from_raw);
+}
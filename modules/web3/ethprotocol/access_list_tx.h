@@ -0,0 +1,36 @@
+#ifndef ACCESS_LIST_TX_H
+#define ACCESS_LIST_TX_H
+
+#include "typed_transaction.h"
+
+// EIP-2930 access list transaction (type 1): legacy gas price plus an access list.
+class AccessListTx : public TypedTransactionSchema<AccessListTx> {
+	GDCLASS(AccessListTx, TypedTransaction);
+
+public:
+	static const int TYPE = TransactionDecoder::TYPE_ACCESS_LIST;
+
+	typedef RlpSchema<
+			RlpField<&Fields::chain_id>,
+			RlpField<&Fields::nonce>,
+			RlpField<&Fields::gas_price>,
+			RlpField<&Fields::gas_limit>,
+			RlpField<&Fields::to>,
+			RlpField<&Fields::value>,
+			RlpField<&Fields::data>,
+			RlpField<&Fields::access_list>>
+			SigningSchema;
+	typedef SigningSchema::Append<RlpField<&Fields::y_parity>, RlpField<&Fields::r>, RlpField<&Fields::s>> SignedSchema;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_gas_price(Ref<BigInt> gas_price);
+	Ref<BigInt> get_gas_price() const;
+
+	// Decodes a signed type 1 envelope, null on error.
+	static Ref<AccessListTx> from_raw(const PackedByteArray &raw);
+};
+
+#endif // ACCESS_LIST_TX_H
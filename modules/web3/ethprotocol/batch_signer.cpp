@@ -0,0 +1,154 @@
+#include "batch_signer.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+
+#include "keccak256.h"
+#include "rlp_reader.h"
+#include "rlp_writer.h"
+#include "u256_math.h"
+
+struct SignJob {
+	PackedByteArray payload; // EIP-155 signing payload
+	Ref<EthAccount> signer;
+};
+
+struct SignBatch {
+	const secp256k1_context *ctx = nullptr;
+	LocalVector<SignJob> jobs;
+	LocalVector<uint8_t> signatures; // 65 bytes per transaction
+	LocalVector<uint8_t> signed_ok;
+	String *raws = nullptr;
+};
+
+// Builds the signed envelope from the signing payload: the first six fields
+// are copied as encoded, chain id, 0, 0 are replaced by v, r, s.
+static bool _build_signed(const PackedByteArray &p_payload, const uint8_t *p_signature, String &r_raw) {
+	eth_rlp_item list;
+	eth_rlp_item fields[9];
+	if (eth_rlp_read_exact(&list, p_payload.ptr(), p_payload.size()) <= 0 || eth_rlp_read_list(fields, 9, &list) != 9) {
+		return false;
+	}
+
+	// v = chain_id * 2 + 35 + recid
+	u256 v;
+	if (!u256_from_be_bytes(v, fields[6].payload, fields[6].len)) {
+		return false;
+	}
+	u256_shl(v, v, 1);
+	if (u256_add(v, v, u256_from_u64(35 + p_signature[64]))) {
+		return false;
+	}
+	uint8_t v_bytes[32];
+	size_t v_len = u256_to_be_bytes_min(v, v_bytes);
+
+	const uint8_t *fields_begin = fields[0].raw;
+	size_t fields_len = fields[6].raw - fields_begin;
+	size_t payload_len = fields_len + eth_rlp_sizeof_bytes(v_bytes, v_len) + eth_rlp_sizeof_be_uint(p_signature, 32) + eth_rlp_sizeof_be_uint(p_signature + 32, 32);
+	size_t size = eth_rlp_sizeof_list(payload_len);
+
+	uint8_t stack_buffer[1024];
+	LocalVector<uint8_t> heap_buffer;
+	uint8_t *buffer = stack_buffer;
+	if (size > sizeof(stack_buffer)) {
+		heap_buffer.resize(size);
+		buffer = heap_buffer.ptr();
+	}
+
+	uint8_t *out = eth_rlp_put_list(buffer, payload_len);
+	memcpy(out, fields_begin, fields_len);
+	out += fields_len;
+	out = eth_rlp_put_bytes(out, v_bytes, v_len);
+	out = eth_rlp_put_be_uint(out, p_signature, 32);
+	eth_rlp_put_be_uint(out, p_signature + 32, 32);
+
+	r_raw = "0x" + String::hex_encode_buffer(buffer, size);
+	return true;
+}
+
+static void _sign_one(void *p_userdata, uint32_t p_index) {
+	SignBatch *batch = static_cast<SignBatch *>(p_userdata);
+	const SignJob &job = batch->jobs[p_index];
+	if (job.payload.is_empty()) {
+		// The transaction or its signer was invalid.
+		return;
+	}
+	uint8_t *signature = batch->signatures.ptr() + p_index * 65;
+
+	uint8_t hash[32];
+	eth_keccak256(hash, job.payload.ptr(), job.payload.size());
+	if (!job.signer->sign_hash32(hash, signature, batch->ctx)) {
+		return;
+	}
+	batch->signed_ok[p_index] = _build_signed(job.payload, signature, batch->raws[p_index]) ? 1 : 0;
+}
+
+PackedStringArray BatchSigner::sign_transactions(const Array &transactions, const Variant &signers, bool apply_signatures) {
+	PackedStringArray result;
+	int count = transactions.size();
+	if (count == 0) {
+		return result;
+	}
+
+	Ref<EthAccount> single_signer;
+	Array signer_list;
+	if (signers.get_type() == Variant::ARRAY) {
+		signer_list = signers;
+		ERR_FAIL_COND_V_MSG(signer_list.size() != count, result, "signers must have one account per transaction");
+	} else {
+		single_signer = Ref<EthAccount>(Object::cast_to<EthAccount>(signers.operator Object *()));
+		ERR_FAIL_COND_V_MSG(single_signer.is_null(), result, "signers must be an EthAccount or an Array of EthAccount");
+	}
+
+	SignBatch batch;
+	batch.jobs.resize(count);
+	batch.signatures.resize(count * 65);
+	batch.signed_ok.resize(count);
+	LocalVector<Ref<LegacyTx>> txs;
+	txs.resize(count);
+	for (int i = 0; i < count; i++) {
+		batch.signed_ok[i] = 0;
+		txs[i] = Ref<LegacyTx>(Object::cast_to<LegacyTx>(transactions[i].operator Object *()));
+		SignJob &job = batch.jobs[i];
+		job.signer = single_signer.is_valid() ? single_signer : Ref<EthAccount>(Object::cast_to<EthAccount>(signer_list[i].operator Object *()));
+		if (txs[i].is_valid() && job.signer.is_valid()) {
+			job.payload = txs[i]->rlp_encode();
+		}
+	}
+
+	result.resize(count);
+	batch.raws = result.ptrw();
+
+	// Signing only reads the shared context, all workers use it.
+	const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+	ERR_FAIL_NULL_V_MSG(ctx, PackedStringArray(), "Failed to create secp256k1 context");
+	batch.ctx = ctx;
+
+	if (count < PARALLEL_SIGN_THRESHOLD) {
+		for (int i = 0; i < count; i++) {
+			_sign_one(&batch, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_sign_one, &batch, count, -1, true, "Sign transactions");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	eth_ecdsa_context_release(ctx);
+
+	for (int i = 0; i < count; i++) {
+		if (!batch.signed_ok[i]) {
+			result.set(i, String());
+			continue;
+		}
+		if (apply_signatures) {
+			PackedByteArray signature;
+			signature.resize(65);
+			memcpy(signature.ptrw(), batch.signatures.ptr() + i * 65, 65);
+			txs[i]->_apply_signature(signature);
+		}
+	}
+	return result;
+}
+
+void BatchSigner::_bind_methods() {
+	ClassDB::bind_static_method("BatchSigner", D_METHOD("sign_transactions", "transactions", "signers", "apply_signatures"), &BatchSigner::sign_transactions, DEFVAL(true));
+}
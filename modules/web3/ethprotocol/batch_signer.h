@@ -0,0 +1,34 @@
+#ifndef BATCH_SIGNER_H
+#define BATCH_SIGNER_H
+
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/variant/array.h"
+#include "core/variant/variant.h"
+#include "core/error/error_macros.h"
+
+#include "legacy_tx.h"
+#include "eth_account_wrapper.h"
+
+// Signs many transactions at once. Payloads are encoded on the calling thread
+// (cheap, and it fills the LegacyTx caches), hashing, signing and building the
+// signed envelopes run on the WorkerThreadPool with one shared signing context.
+class BatchSigner : public RefCounted {
+	GDCLASS(BatchSigner, RefCounted);
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Batch below which signing inline is cheaper than dispatching to the pool.
+	static const int PARALLEL_SIGN_THRESHOLD = 4;
+
+	// signers is one EthAccount for every transaction, or an Array of
+	// EthAccount with one entry per transaction.
+	// Returns the 0x-prefixed signed raw transactions in input order, failed
+	// entries are empty strings. When apply_signatures is true, v, r and s are
+	// also set on the LegacyTx objects.
+	static PackedStringArray sign_transactions(const Array &transactions, const Variant &signers, bool apply_signatures = true);
+};
+
+#endif // BATCH_SIGNER_H
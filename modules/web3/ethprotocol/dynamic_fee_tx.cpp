@@ -0,0 +1,33 @@
+#include "dynamic_fee_tx.h"
+
+void DynamicFeeTx::set_max_priority_fee_per_gas(Ref<BigInt> max_priority_fee_per_gas) {
+	_set_uint(max_priority_fee_per_gas, m_fields.max_priority_fee_per_gas);
+}
+
+void DynamicFeeTx::set_max_fee_per_gas(Ref<BigInt> max_fee_per_gas) {
+	_set_uint(max_fee_per_gas, m_fields.max_fee_per_gas);
+}
+
+Ref<BigInt> DynamicFeeTx::get_max_priority_fee_per_gas() const {
+	return _to_big_int(m_fields.max_priority_fee_per_gas);
+}
+
+Ref<BigInt> DynamicFeeTx::get_max_fee_per_gas() const {
+	return _to_big_int(m_fields.max_fee_per_gas);
+}
+
+Ref<DynamicFeeTx> DynamicFeeTx::from_raw(const PackedByteArray &raw) {
+	Ref<DynamicFeeTx> tx = Ref<DynamicFeeTx>(memnew(DynamicFeeTx));
+	if (!tx->_decode_raw(raw)) {
+		return Ref<DynamicFeeTx>();
+	}
+	return tx;
+}
+
+void DynamicFeeTx::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_max_priority_fee_per_gas", "max_priority_fee_per_gas"), &DynamicFeeTx::set_max_priority_fee_per_gas);
+	ClassDB::bind_method(D_METHOD("get_max_priority_fee_per_gas"), &DynamicFeeTx::get_max_priority_fee_per_gas);
+	ClassDB::bind_method(D_METHOD("set_max_fee_per_gas", "max_fee_per_gas"), &DynamicFeeTx::set_max_fee_per_gas);
+	ClassDB::bind_method(D_METHOD("get_max_fee_per_gas"), &DynamicFeeTx::get_max_fee_per_gas);
+	ClassDB::bind_static_method("DynamicFeeTx", D_METHOD("from_raw", "raw"), &DynamicFeeTx::from_raw);
+}
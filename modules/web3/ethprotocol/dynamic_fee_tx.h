@@ -0,0 +1,39 @@
+#ifndef DYNAMIC_FEE_TX_H
+#define DYNAMIC_FEE_TX_H
+
+#include "typed_transaction.h"
+
+// EIP-1559 dynamic fee transaction (type 2): priority fee and fee cap instead of a gas price.
+class DynamicFeeTx : public TypedTransactionSchema<DynamicFeeTx> {
+	GDCLASS(DynamicFeeTx, TypedTransaction);
+
+public:
+	static const int TYPE = TransactionDecoder::TYPE_DYNAMIC_FEE;
+
+	typedef RlpSchema<
+			RlpField<&Fields::chain_id>,
+			RlpField<&Fields::nonce>,
+			RlpField<&Fields::max_priority_fee_per_gas>,
+			RlpField<&Fields::max_fee_per_gas>,
+			RlpField<&Fields::gas_limit>,
+			RlpField<&Fields::to>,
+			RlpField<&Fields::value>,
+			RlpField<&Fields::data>,
+			RlpField<&Fields::access_list>>
+			SigningSchema;
+	typedef SigningSchema::Append<RlpField<&Fields::y_parity>, RlpField<&Fields::r>, RlpField<&Fields::s>> SignedSchema;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_max_priority_fee_per_gas(Ref<BigInt> max_priority_fee_per_gas);
+	void set_max_fee_per_gas(Ref<BigInt> max_fee_per_gas);
+	Ref<BigInt> get_max_priority_fee_per_gas() const;
+	Ref<BigInt> get_max_fee_per_gas() const;
+
+	// Decodes a signed type 2 envelope, null on error.
+	static Ref<DynamicFeeTx> from_raw(const PackedByteArray &raw);
+};
+
+#endif // DYNAMIC_FEE_TX_H
@@ -0,0 +1,609 @@
+#include "eip712.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#include "abiargument.h"
+#include "abitype.h"
+#include "big_int.h"
+#include "keccak256.h"
+#include "transaction_decoder.h"
+#include "u256.h"
+
+static const char *DOMAIN_TYPE = "EIP712Domain";
+
+// Standard domain fields in EIP-712 order, used when the types do not define
+// EIP712Domain.
+static const char *DOMAIN_FIELDS[][2] = {
+	{ "name", "string" },
+	{ "version", "string" },
+	{ "chainId", "uint256" },
+	{ "verifyingContract", "address" },
+	{ "salt", "bytes32" },
+};
+
+bool TypedDataEncoder::_parse_field(const Dictionary &p_field, Field &r_field, String &r_error) const {
+	if (!p_field.has("name") || !p_field.has("type")) {
+		r_error = "field needs a name and a type";
+		return false;
+	}
+	r_field.name = p_field["name"];
+	r_field.key = r_field.name;
+	r_field.type = p_field["type"];
+	if (!isValidFieldName(r_field.name)) {
+		r_error = "invalid field name '" + r_field.name + "'";
+		return false;
+	}
+
+	// Array dimensions, parsed from the right: the outermost comes last.
+	String base = r_field.type;
+	LocalVector<int> outer_first;
+	while (base.ends_with("]")) {
+		int open = base.rfind("[");
+		if (open < 0) {
+			r_error = "invalid type '" + r_field.type + "'";
+			return false;
+		}
+		String size = base.substr(open + 1, base.length() - open - 2);
+		if (size.is_empty()) {
+			outer_first.push_back(-1);
+		} else if (size.is_valid_int() && size.to_int() > 0) {
+			outer_first.push_back(size.to_int());
+		} else {
+			r_error = "invalid array size in '" + r_field.type + "'";
+			return false;
+		}
+		base = base.substr(0, open);
+	}
+	r_field.dims.clear();
+	for (int i = outer_first.size() - 1; i >= 0; i--) {
+		r_field.dims.push_back(outer_first[i]);
+	}
+
+	int struct_index = _find_struct(base);
+	if (struct_index >= 0) {
+		r_field.kind = FIELD_STRUCT;
+		r_field.struct_index = struct_index;
+		return true;
+	}
+
+	Ref<ABIType> abi_type = NewABIType(base, "", Vector<ABIArgumentMarshaling>());
+	if (abi_type.is_null()) {
+		r_error = "unknown type '" + base + "'";
+		return false;
+	}
+	r_field.size = abi_type->size;
+	switch (abi_type->kind) {
+		case UintTy:
+		case IntTy:
+			if (r_field.size < 8 || r_field.size > 256 || r_field.size % 8 != 0) {
+				r_error = "invalid integer type '" + base + "'";
+				return false;
+			}
+			r_field.kind = abi_type->kind == UintTy ? FIELD_UINT : FIELD_INT;
+			break;
+		case BoolTy:
+			r_field.kind = FIELD_BOOL;
+			break;
+		case AddressTy:
+			r_field.kind = FIELD_ADDRESS;
+			break;
+		case FixedBytesTy:
+			if (r_field.size < 1) {
+				r_error = "invalid type '" + base + "'";
+				return false;
+			}
+			r_field.kind = FIELD_FIXED_BYTES;
+			break;
+		case BytesTy:
+			r_field.kind = FIELD_BYTES;
+			break;
+		case StringTy:
+			r_field.kind = FIELD_STRING;
+			break;
+		default:
+			r_error = "type '" + base + "' is not allowed in EIP-712";
+			return false;
+	}
+	return true;
+}
+
+void TypedDataEncoder::_collect_dependencies(int p_index, LocalVector<int> &r_indices) const {
+	if (r_indices.find(p_index) >= 0) {
+		return;
+	}
+	r_indices.push_back(p_index);
+	for (const Field &field : m_structs[p_index].fields) {
+		if (field.kind == FIELD_STRUCT) {
+			_collect_dependencies(field.struct_index, r_indices);
+		}
+	}
+}
+
+String TypedDataEncoder::_encode_type(int p_index) const {
+	LocalVector<int> dependencies;
+	_collect_dependencies(p_index, dependencies);
+
+	// The primary type first, then the referenced ones sorted by name.
+	Vector<String> names;
+	for (uint32_t i = 1; i < dependencies.size(); i++) {
+		names.push_back(m_structs[dependencies[i]].name);
+	}
+	names.sort();
+
+	String result;
+	for (int i = -1; i < names.size(); i++) {
+		const Struct &s = m_structs[i < 0 ? p_index : _find_struct(names[i])];
+		result += s.name + "(";
+		for (uint32_t f = 0; f < s.fields.size(); f++) {
+			result += (f > 0 ? "," : "") + s.fields[f].type + " " + s.fields[f].name;
+		}
+		result += ")";
+	}
+	return result;
+}
+
+int TypedDataEncoder::_find_struct(const String &p_name) const {
+	const int *index = m_struct_indices.getptr(p_name);
+	return index != nullptr ? *index : -1;
+}
+
+// Parses a (u)intN value into its 32-byte two's complement word.
+static bool _integer_word(const Variant &p_value, bool p_signed, int p_bits, uint8_t *r_word) {
+	u256 magnitude;
+	bool negative = false;
+
+	switch (p_value.get_type()) {
+		case Variant::INT: {
+			int64_t v = p_value;
+			negative = v < 0;
+			u256_set_u64(magnitude, negative ? (uint64_t)(-(v + 1)) + 1 : (uint64_t)v);
+		} break;
+		case Variant::STRING: {
+			CharString text = String(p_value).strip_edges().utf8();
+			const char *digits = text.get_data();
+			size_t len = text.length();
+			if (len > 0 && digits[0] == '-') {
+				negative = true;
+				digits++;
+				len--;
+			}
+			bool hex = len > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X');
+			if (len == 0 || !(hex ? u256_from_hex(magnitude, digits, len) : u256_from_dec(magnitude, digits, len))) {
+				return false;
+			}
+		} break;
+		case Variant::OBJECT: {
+			Object *object = p_value;
+			if (BigInt *big = Object::cast_to<BigInt>(object)) {
+				mpz_t abs;
+				mpz_init(abs);
+				mpz_abs(abs, big->m_number);
+				negative = mpz_sgn(big->m_number) < 0;
+				bool fits = u256_from_mpz(magnitude, abs);
+				mpz_clear(abs);
+				if (!fits) {
+					return false;
+				}
+			} else if (U256 *word = Object::cast_to<U256>(object)) {
+				magnitude = word->m_value;
+			} else if (I256 *word = Object::cast_to<I256>(object)) {
+				negative = u256_is_neg(word->m_value);
+				if (negative) {
+					u256_neg(magnitude, word->m_value);
+				} else {
+					magnitude = word->m_value;
+				}
+			} else {
+				return false;
+			}
+		} break;
+		default:
+			return false;
+	}
+
+	if (u256_is_zero(magnitude)) {
+		negative = false;
+	}
+	if (negative) {
+		// -2^(bits-1) is the smallest intN.
+		u256 limit;
+		u256_sub(limit, magnitude, u256_from_u64(1));
+		if (!p_signed || u256_bit_length(limit) > p_bits - 1) {
+			return false;
+		}
+		u256_neg(magnitude, magnitude);
+	} else if (u256_bit_length(magnitude) > (p_signed ? p_bits - 1 : p_bits)) {
+		return false;
+	}
+	u256_to_be_bytes(magnitude, r_word);
+	return true;
+}
+
+// Bytes of a PackedByteArray or 0x hex String. p_len is the expected length,
+// -1 for any.
+static bool _value_bytes(const Variant &p_value, int p_len, LocalVector<uint8_t> &r_bytes) {
+	if (p_value.get_type() == Variant::PACKED_BYTE_ARRAY) {
+		PackedByteArray bytes = p_value;
+		if (p_len >= 0 && bytes.size() != p_len) {
+			return false;
+		}
+		r_bytes.resize(bytes.size());
+		if (bytes.size() > 0) {
+			memcpy(r_bytes.ptr(), bytes.ptr(), bytes.size());
+		}
+		return true;
+	}
+	if (p_value.get_type() == Variant::STRING) {
+		String hex = p_value;
+		int digits = hex.length() - (hex.begins_with("0x") || hex.begins_with("0X") ? 2 : 0);
+		if (digits % 2 != 0 || (p_len >= 0 && digits / 2 != p_len)) {
+			return false;
+		}
+		r_bytes.resize(digits / 2);
+		return TransactionDecoder::parse_hex(hex, r_bytes.ptr(), digits / 2);
+	}
+	return false;
+}
+
+bool TypedDataEncoder::_encode_value(const Field &p_field, int p_depth, const Variant &p_value, uint8_t *r_word, String &r_error) const {
+	memset(r_word, 0, 32);
+
+	if (p_depth > 0) {
+		// Arrays hash the concatenation of their encoded elements.
+		if (p_value.get_type() != Variant::ARRAY) {
+			r_error = "'" + p_field.name + "' must be an Array";
+			return false;
+		}
+		Array elements = p_value;
+		int expected = p_field.dims[p_depth - 1];
+		if (expected >= 0 && elements.size() != expected) {
+			r_error = "'" + p_field.name + "' must have " + itos(expected) + " elements";
+			return false;
+		}
+		eth_keccak256_ctx ctx;
+		eth_keccak256_init(&ctx);
+		uint8_t element[32];
+		for (int i = 0; i < elements.size(); i++) {
+			if (!_encode_value(p_field, p_depth - 1, elements[i], element, r_error)) {
+				return false;
+			}
+			eth_keccak256_update(&ctx, element, 32);
+		}
+		eth_keccak256_final(&ctx, r_word);
+		return true;
+	}
+
+	LocalVector<uint8_t> bytes;
+	switch (p_field.kind) {
+		case FIELD_UINT:
+		case FIELD_INT:
+			if (!_integer_word(p_value, p_field.kind == FIELD_INT, p_field.size, r_word)) {
+				r_error = "'" + p_field.name + "' is not a valid " + p_field.type;
+				return false;
+			}
+			return true;
+		case FIELD_BOOL:
+			if (p_value.get_type() != Variant::BOOL) {
+				r_error = "'" + p_field.name + "' must be a bool";
+				return false;
+			}
+			r_word[31] = (bool)p_value ? 1 : 0;
+			return true;
+		case FIELD_ADDRESS:
+			if (!_value_bytes(p_value, 20, bytes)) {
+				r_error = "'" + p_field.name + "' is not a valid address";
+				return false;
+			}
+			memcpy(r_word + 12, bytes.ptr(), 20);
+			return true;
+		case FIELD_FIXED_BYTES:
+			if (!_value_bytes(p_value, p_field.size, bytes)) {
+				r_error = "'" + p_field.name + "' must be " + itos(p_field.size) + " bytes";
+				return false;
+			}
+			memcpy(r_word, bytes.ptr(), p_field.size);
+			return true;
+		case FIELD_BYTES:
+			if (!_value_bytes(p_value, -1, bytes)) {
+				r_error = "'" + p_field.name + "' must be a PackedByteArray or hex String";
+				return false;
+			}
+			eth_keccak256(r_word, bytes.ptr(), bytes.size());
+			return true;
+		case FIELD_STRING: {
+			if (p_value.get_type() != Variant::STRING) {
+				r_error = "'" + p_field.name + "' must be a String";
+				return false;
+			}
+			CharString text = String(p_value).utf8();
+			eth_keccak256(r_word, (const uint8_t *)text.get_data(), text.length());
+			return true;
+		}
+		case FIELD_STRUCT:
+			return hash_struct_into(p_field.struct_index, p_value, r_word, r_error);
+	}
+	return false;
+}
+
+bool TypedDataEncoder::hash_struct_into(int p_index, const Variant &p_message, uint8_t *r_hash, String &r_error) const {
+	const Struct &s = m_structs[p_index];
+	if (p_message.get_type() != Variant::DICTIONARY) {
+		r_error = s.name + " value must be a Dictionary";
+		return false;
+	}
+	Dictionary message = p_message;
+
+	// keccak256(typeHash || encodeData), one 32-byte word per field.
+	eth_keccak256_ctx ctx;
+	eth_keccak256_init(&ctx);
+	eth_keccak256_update(&ctx, s.type_hash, 32);
+	uint8_t word[32];
+	for (const Field &field : s.fields) {
+		const Variant *value = message.getptr(field.key);
+		if (value == nullptr) {
+			r_error = s.name + " is missing field '" + field.name + "'";
+			return false;
+		}
+		if (!_encode_value(field, field.dims.size(), *value, word, r_error)) {
+			return false;
+		}
+		eth_keccak256_update(&ctx, word, 32);
+	}
+	eth_keccak256_final(&ctx, r_hash);
+	return true;
+}
+
+bool TypedDataEncoder::hash_typed_data_into(int p_index, const Variant &p_message, uint8_t *r_hash, String &r_error) const {
+	uint8_t buffer[66];
+	buffer[0] = 0x19;
+	buffer[1] = 0x01;
+	memcpy(buffer + 2, m_domain_separator, 32);
+	if (!hash_struct_into(p_index, p_message, buffer + 34, r_error)) {
+		return false;
+	}
+	eth_keccak256(r_hash, buffer, sizeof(buffer));
+	return true;
+}
+
+bool TypedDataEncoder::set_types(const Dictionary &types) {
+	m_structs.clear();
+	m_struct_indices.clear();
+	m_has_domain = false;
+	m_domain_derived = false;
+
+	// Names first, so fields can reference structs defined later.
+	Array names = types.keys();
+	m_structs.resize(names.size());
+	for (int i = 0; i < names.size(); i++) {
+		m_structs[i].name = names[i];
+		m_struct_indices.insert(m_structs[i].name, i);
+	}
+
+	for (int i = 0; i < names.size(); i++) {
+		Struct &s = m_structs[i];
+		Variant fields_value = types[names[i]];
+		String error = "fields must be an Array";
+		bool valid = fields_value.get_type() == Variant::ARRAY;
+		if (valid) {
+			Array fields = fields_value;
+			s.fields.resize(fields.size());
+			for (int f = 0; valid && f < fields.size(); f++) {
+				error = "field must be a Dictionary";
+				valid = fields[f].get_type() == Variant::DICTIONARY && _parse_field(fields[f], s.fields[f], error);
+			}
+		}
+		if (!valid) {
+			m_structs.clear();
+			m_struct_indices.clear();
+			ERR_FAIL_V_MSG(false, "Invalid type " + s.name + ": " + error);
+		}
+	}
+
+	for (uint32_t i = 0; i < m_structs.size(); i++) {
+		CharString encoded = _encode_type(i).utf8();
+		eth_keccak256(m_structs[i].type_hash, (const uint8_t *)encoded.get_data(), encoded.length());
+	}
+	return true;
+}
+
+bool TypedDataEncoder::set_domain(const Dictionary &domain) {
+	m_has_domain = false;
+	if (m_domain_derived) {
+		// Derived from the previous domain, which may have other fields.
+		m_struct_indices.erase(DOMAIN_TYPE);
+		m_structs.resize(m_structs.size() - 1);
+		m_domain_derived = false;
+	}
+	int index = _find_struct(DOMAIN_TYPE);
+	if (index < 0) {
+		Struct s;
+		s.name = DOMAIN_TYPE;
+		for (const auto &standard : DOMAIN_FIELDS) {
+			if (!domain.has(standard[0])) {
+				continue;
+			}
+			Field field;
+			Dictionary definition;
+			definition["name"] = standard[0];
+			definition["type"] = standard[1];
+			String error;
+			_parse_field(definition, field, error);
+			s.fields.push_back(field);
+		}
+		index = m_structs.size();
+		m_structs.push_back(s);
+		m_struct_indices.insert(s.name, index);
+		m_domain_derived = true;
+		CharString encoded = _encode_type(index).utf8();
+		eth_keccak256(m_structs[index].type_hash, (const uint8_t *)encoded.get_data(), encoded.length());
+	}
+
+	String error;
+	ERR_FAIL_COND_V_MSG(!hash_struct_into(index, domain, m_domain_separator, error), false, "Invalid domain: " + error);
+	m_has_domain = true;
+	return true;
+}
+
+PackedByteArray TypedDataEncoder::get_domain_separator() const {
+	ERR_FAIL_COND_V_MSG(!m_has_domain, PackedByteArray(), "Domain is not set");
+	return uint8PtrToPackedByteArray(m_domain_separator, 32);
+}
+
+String TypedDataEncoder::encode_type(const String &primary_type) const {
+	int index = _find_struct(primary_type);
+	ERR_FAIL_COND_V_MSG(index < 0, String(), "Unknown type: " + primary_type);
+	return _encode_type(index);
+}
+
+PackedByteArray TypedDataEncoder::type_hash(const String &primary_type) const {
+	int index = _find_struct(primary_type);
+	ERR_FAIL_COND_V_MSG(index < 0, PackedByteArray(), "Unknown type: " + primary_type);
+	return uint8PtrToPackedByteArray(m_structs[index].type_hash, 32);
+}
+
+PackedByteArray TypedDataEncoder::hash_struct(const String &primary_type, const Dictionary &message) const {
+	int index = _find_struct(primary_type);
+	ERR_FAIL_COND_V_MSG(index < 0, PackedByteArray(), "Unknown type: " + primary_type);
+
+	uint8_t hash[32];
+	String error;
+	ERR_FAIL_COND_V_MSG(!hash_struct_into(index, message, hash, error), PackedByteArray(), "Invalid message: " + error);
+	return uint8PtrToPackedByteArray(hash, 32);
+}
+
+PackedByteArray TypedDataEncoder::hash_typed_data(const String &primary_type, const Dictionary &message) const {
+	ERR_FAIL_COND_V_MSG(!m_has_domain, PackedByteArray(), "Domain is not set");
+	int index = _find_struct(primary_type);
+	ERR_FAIL_COND_V_MSG(index < 0, PackedByteArray(), "Unknown type: " + primary_type);
+
+	uint8_t hash[32];
+	String error;
+	ERR_FAIL_COND_V_MSG(!hash_typed_data_into(index, message, hash, error), PackedByteArray(), "Invalid message: " + error);
+	return uint8PtrToPackedByteArray(hash, 32);
+}
+
+PackedByteArray TypedDataEncoder::sign_typed_data(const String &primary_type, const Dictionary &message, const Ref<EthAccount> &account) const {
+	ERR_FAIL_COND_V_MSG(account.is_null(), PackedByteArray(), "account is null");
+	PackedByteArray hash = hash_typed_data(primary_type, message);
+	if (hash.is_empty()) {
+		return PackedByteArray();
+	}
+	return account->sign_hash(hash);
+}
+
+struct TypedDataBatch {
+	const TypedDataEncoder *encoder = nullptr;
+	int index = -1;
+	Array messages;
+	const EthAccount *signer = nullptr;
+	const secp256k1_context *ctx = nullptr;
+	uint8_t *hashes = nullptr;
+	uint8_t *signatures = nullptr;
+	LocalVector<uint8_t> failed;
+	LocalVector<String> errors;
+};
+
+void TypedDataEncoder::_hash_one(void *p_userdata, uint32_t p_index) {
+	TypedDataBatch *batch = static_cast<TypedDataBatch *>(p_userdata);
+	const Array &messages = batch->messages;
+	uint8_t hash[32];
+	if (!batch->encoder->hash_typed_data_into(batch->index, messages[p_index], hash, batch->errors[p_index])) {
+		batch->failed[p_index] = 1;
+		return;
+	}
+	if (batch->hashes != nullptr) {
+		memcpy(batch->hashes + p_index * 32, hash, 32);
+	}
+	if (batch->signer != nullptr && !batch->signer->sign_hash32(hash, batch->signatures + p_index * 65, batch->ctx)) {
+		memset(batch->signatures + p_index * 65, 0, 65);
+		batch->failed[p_index] = 1;
+	}
+}
+
+// Runs a hash or sign batch and reports the first failure.
+static void _run_typed_data_batch(TypedDataBatch &p_batch, void (*p_func)(void *, uint32_t), const char *p_description) {
+	uint32_t count = p_batch.messages.size();
+	p_batch.failed.resize(count);
+	p_batch.errors.resize(count);
+	memset(p_batch.failed.ptr(), 0, count);
+
+	if (count < (uint32_t)TypedDataEncoder::PARALLEL_HASH_THRESHOLD) {
+		for (uint32_t i = 0; i < count; i++) {
+			p_func(&p_batch, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(p_func, &p_batch, count, -1, true, p_description);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (p_batch.failed[i]) {
+			String error = p_batch.errors[i].is_empty() ? String("signing failed") : p_batch.errors[i];
+			ERR_PRINT("Message " + itos(i) + " failed: " + error);
+			break;
+		}
+	}
+}
+
+PackedByteArray TypedDataEncoder::hash_typed_data_batch(const String &primary_type, const Array &messages) const {
+	ERR_FAIL_COND_V_MSG(!m_has_domain, PackedByteArray(), "Domain is not set");
+	int index = _find_struct(primary_type);
+	ERR_FAIL_COND_V_MSG(index < 0, PackedByteArray(), "Unknown type: " + primary_type);
+
+	PackedByteArray result;
+	result.resize(messages.size() * 32);
+	if (messages.is_empty()) {
+		return result;
+	}
+	memset(result.ptrw(), 0, result.size());
+
+	TypedDataBatch batch;
+	batch.encoder = this;
+	batch.index = index;
+	batch.messages = messages;
+	batch.hashes = result.ptrw();
+	_run_typed_data_batch(batch, &_hash_one, "Hash typed data");
+	return result;
+}
+
+PackedByteArray TypedDataEncoder::sign_typed_data_batch(const String &primary_type, const Array &messages, const Ref<EthAccount> &account) const {
+	ERR_FAIL_COND_V_MSG(account.is_null(), PackedByteArray(), "account is null");
+	ERR_FAIL_COND_V_MSG(!m_has_domain, PackedByteArray(), "Domain is not set");
+	int index = _find_struct(primary_type);
+	ERR_FAIL_COND_V_MSG(index < 0, PackedByteArray(), "Unknown type: " + primary_type);
+
+	PackedByteArray result;
+	result.resize(messages.size() * 65);
+	if (messages.is_empty()) {
+		return result;
+	}
+	memset(result.ptrw(), 0, result.size());
+
+	// Signing only reads the shared context, all workers use it.
+	const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+	ERR_FAIL_NULL_V_MSG(ctx, PackedByteArray(), "Failed to create secp256k1 context");
+
+	TypedDataBatch batch;
+	batch.encoder = this;
+	batch.index = index;
+	batch.messages = messages;
+	batch.signer = account.ptr();
+	batch.ctx = ctx;
+	batch.signatures = result.ptrw();
+	_run_typed_data_batch(batch, &_hash_one, "Sign typed data");
+	eth_ecdsa_context_release(ctx);
+	return result;
+}
+
+void TypedDataEncoder::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_types", "types"), &TypedDataEncoder::set_types);
+	ClassDB::bind_method(D_METHOD("set_domain", "domain"), &TypedDataEncoder::set_domain);
+	ClassDB::bind_method(D_METHOD("get_domain_separator"), &TypedDataEncoder::get_domain_separator);
+	ClassDB::bind_method(D_METHOD("encode_type", "primary_type"), &TypedDataEncoder::encode_type);
+	ClassDB::bind_method(D_METHOD("type_hash", "primary_type"), &TypedDataEncoder::type_hash);
+	ClassDB::bind_method(D_METHOD("hash_struct", "primary_type", "message"), &TypedDataEncoder::hash_struct);
+	ClassDB::bind_method(D_METHOD("hash_typed_data", "primary_type", "message"), &TypedDataEncoder::hash_typed_data);
+	ClassDB::bind_method(D_METHOD("sign_typed_data", "primary_type", "message", "account"), &TypedDataEncoder::sign_typed_data);
+	ClassDB::bind_method(D_METHOD("hash_typed_data_batch", "primary_type", "messages"), &TypedDataEncoder::hash_typed_data_batch);
+	ClassDB::bind_method(D_METHOD("sign_typed_data_batch", "primary_type", "messages", "account"), &TypedDataEncoder::sign_typed_data_batch);
+}
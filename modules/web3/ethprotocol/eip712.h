@@ -0,0 +1,114 @@
+#ifndef EIP712_H
+#define EIP712_H
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+#include "eth_account_wrapper.h"
+
+// EIP-712 typed structured data hashing and signing. The types schema is
+// parsed once into an encoding plan per struct (field kinds, nested struct
+// indices, array dimensions) with its typeHash precomputed, and the domain
+// separator is cached, so hashing a message only walks the plan and feeds
+// keccak. Atomic field types are parsed with the ABI type parser.
+//
+// Values: (u)intN take int, decimal or 0x hex String, BigInt, U256 or I256.
+// address, bytesN and bytes take a PackedByteArray or a 0x hex String,
+// structs a Dictionary and arrays an Array.
+class TypedDataEncoder : public RefCounted {
+	GDCLASS(TypedDataEncoder, RefCounted);
+
+public:
+	enum FieldKind {
+		FIELD_UINT,
+		FIELD_INT,
+		FIELD_BOOL,
+		FIELD_ADDRESS,
+		FIELD_FIXED_BYTES,
+		FIELD_BYTES,
+		FIELD_STRING,
+		FIELD_STRUCT,
+	};
+
+	struct Field {
+		Variant key; // Name, as a Dictionary key.
+		String name;
+		String type; // As written in the schema.
+		FieldKind kind = FIELD_UINT;
+		int size = 0; // Bits of (u)intN, bytes of bytesN.
+		int struct_index = -1;
+		LocalVector<int> dims; // Innermost first, -1 for T[].
+	};
+
+	struct Struct {
+		String name;
+		LocalVector<Field> fields;
+		uint8_t type_hash[32] = {};
+	};
+
+	// Batch below which hashing inline is cheaper than dispatching to the pool.
+	static const int PARALLEL_HASH_THRESHOLD = 8;
+
+private:
+	LocalVector<Struct> m_structs;
+	HashMap<String, int> m_struct_indices;
+	bool m_has_domain = false;
+	// EIP712Domain was not in the types and was built from the domain fields.
+	bool m_domain_derived = false;
+	uint8_t m_domain_separator[32] = {};
+
+	bool _parse_field(const Dictionary &p_field, Field &r_field, String &r_error) const;
+	void _collect_dependencies(int p_index, LocalVector<int> &r_indices) const;
+	String _encode_type(int p_index) const;
+	int _find_struct(const String &p_name) const;
+	bool _encode_value(const Field &p_field, int p_depth, const Variant &p_value, uint8_t *r_word, String &r_error) const;
+
+	static void _hash_one(void *p_userdata, uint32_t p_index);
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Hashes a Dictionary message against struct p_index. On error r_error
+	// names the offending field.
+	bool hash_struct_into(int p_index, const Variant &p_message, uint8_t *r_hash, String &r_error) const;
+	// keccak256(0x1901 || domainSeparator || hashStruct(message)).
+	bool hash_typed_data_into(int p_index, const Variant &p_message, uint8_t *r_hash, String &r_error) const;
+
+	/**
+	 * @brief  Parses a types schema, {"Name": [{"name": ..., "type": ...}, ...], ...},
+	 *         as in eth_signTypedData_v4. Clears the domain, set it again afterwards.
+	 * @return False if a type is malformed or unknown.
+	 */
+	bool set_types(const Dictionary &types);
+
+	/**
+	 * @brief  Computes and caches the domain separator. Without an EIP712Domain
+	 *         entry in the types, the domain type is made of the standard fields
+	 *         present (name, version, chainId, verifyingContract, salt).
+	 */
+	bool set_domain(const Dictionary &domain);
+	PackedByteArray get_domain_separator() const;
+
+	// encodeType, e.g. "Mail(Person from,Person to,string contents)Person(string name,address wallet)".
+	String encode_type(const String &primary_type) const;
+	PackedByteArray type_hash(const String &primary_type) const;
+	PackedByteArray hash_struct(const String &primary_type, const Dictionary &message) const;
+	// The 32-byte digest that is signed, the domain must be set.
+	PackedByteArray hash_typed_data(const String &primary_type, const Dictionary &message) const;
+	PackedByteArray sign_typed_data(const String &primary_type, const Dictionary &message, const Ref<EthAccount> &account) const;
+
+	// Batch versions, spread over the worker thread pool. Digests are packed
+	// 32 bytes per message and signatures 65 bytes (r, s, recovery id); the
+	// entries of messages that fail to encode are all zero.
+	PackedByteArray hash_typed_data_batch(const String &primary_type, const Array &messages) const;
+	PackedByteArray sign_typed_data_batch(const String &primary_type, const Array &messages, const Ref<EthAccount> &account) const;
+};
+
+#endif // EIP712_H
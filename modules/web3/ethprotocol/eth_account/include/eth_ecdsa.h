@@ -23,6 +23,46 @@ struct eth_ecdsa_signature {
 
 #define eth_signed eth_ecdsa_signature
 
+/*!
+ * @brief Creates the process-wide context shared by the functions below that
+ * do not take a context. Calling it again once the context exists does nothing.
+ *
+ * @param[in] seed32 A pointer to 32 bytes of randomness used to blind the
+ * context, or `NULL` to leave it unblinded.
+ * @return `1` on success, `-1` otherwise.
+ */
+int eth_ecdsa_context_init(const uint8_t *seed32);
+
+/*!
+ * @brief Destroys the shared context. No other thread may be using it.
+ */
+void eth_ecdsa_context_free(void);
+
+/*!
+ * @brief Borrows the shared context, creating it unblinded if
+ * `eth_ecdsa_context_init` was not called. Every successful call must be
+ * paired with `eth_ecdsa_context_release`. The context must only be read.
+ *
+ * @return The context, `NULL` if it could not be created.
+ */
+const secp256k1_context *eth_ecdsa_context_acquire(void);
+
+/*!
+ * @brief Returns a context borrowed with `eth_ecdsa_context_acquire`. Every
+ * 1024 releases the blinding of the shared context is refreshed.
+ */
+void eth_ecdsa_context_release(const secp256k1_context *ctx);
+
+/*!
+ * @brief Refreshes the blinding of the shared context from the seed given to
+ * `eth_ecdsa_context_init`. Signers never wait for it: the spare context is
+ * blinded and then swapped in.
+ *
+ * @return `1` if the blinding changed, `0` if it was skipped because the
+ * context is not seeded or still in use, `-1` on failure.
+ */
+int eth_ecdsa_context_rerandomize(void);
+
 /*!
  * @brief Extracts public key from private key.
  *
@@ -45,8 +85,38 @@ int eth_ecdsa_pubkey_get_with_compressed(uint8_t *dest, const uint8_t *privkey);
 int eth_ecdsa_sign(struct eth_ecdsa_signature *dest, const uint8_t *privkey,
 		const uint8_t *data32);
 
+/*!
+ * @brief Same as `eth_ecdsa_sign`, using a caller owned context created with
+ * SECP256K1_CONTEXT_SIGN. Signing only reads the context, so one context can
+ * be shared by several threads.
+ */
+int eth_ecdsa_sign_with_context(const secp256k1_context *ctx,
+		struct eth_ecdsa_signature *dest, const uint8_t *privkey,
+		const uint8_t *data32);
+
+/*!
+ * @brief Recovers the public key that produced an ECDSA signature.
+ *
+ * @param[out] dest A pointer to 64-byte array where the public key will be placed.
+ * @param[in] sig A pointer to the signature, recid must be in [0, 3].
+ * @param[in] data32 A pointer to the 32-byte signed data.
+ * @return `1` on success, `-1` otherwise.
+ */
+int eth_ecdsa_recover(uint8_t *dest, const struct eth_ecdsa_signature *sig,
+		const uint8_t *data32);
+
+/*!
+ * @brief Same as `eth_ecdsa_recover`, using a caller owned context created with
+ * SECP256K1_CONTEXT_VERIFY. The context is only read, so it can be shared
+ * between threads.
+ */
+int eth_ecdsa_recover_with_context(const secp256k1_context *ctx, uint8_t *dest,
+		const struct eth_ecdsa_signature *sig, const uint8_t *data32);
+
+/*! @brief Adds tweak to seckey in place, `0` on success, `-1` if the result is invalid. */
 int seckey_tweak_add(unsigned char *seckey, const unsigned char *tweak);
 
+/*! @brief Wrappers around the secp256k1 functions, `1` on success, `0` otherwise. */
 int pubkey_serialize(unsigned char *output, size_t *outputlen, const secp256k1_pubkey *pubkey, unsigned int flags);
 int pubkey_parse(secp256k1_pubkey *pubkey, const unsigned char *input, size_t input_len);
 
@@ -279,20 +279,23 @@ int bip32_key_from_private_key(uint32_t version,
 		const unsigned char *priv_key, size_t priv_key_len,
 		struct ext_key *key_out) {
 	const secp256k1_context *ctx;
+	int valid;
 
 	if (key_out)
 		memset(key_out, 0, sizeof(*key_out));
 
-	ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-	if (ctx == NULL)
-		return -1;
-
 	if (!version_is_valid(version, BIP32_FLAG_KEY_PRIVATE) ||
 			!priv_key || priv_key_len != EC_PRIVATE_KEY_LEN || !key_out)
 		return WEB3_EINVAL;
 
+	ctx = eth_ecdsa_context_acquire();
+	if (ctx == NULL)
+		return WEB3_ERROR;
+
 	/* Check that the generated private key is valid */
-	if (!secp256k1_ec_seckey_verify(ctx, priv_key)) {
+	valid = secp256k1_ec_seckey_verify(ctx, priv_key);
+	eth_ecdsa_context_release(ctx);
+	if (!valid) {
 		return WEB3_ERROR; /* Invalid private key */
 	}
 
@@ -384,10 +387,6 @@ int bip32_key_from_parent(const struct ext_key *hdkey, uint32_t child_num,
 	if (!hdkey || !key_out)
 		return WEB3_EINVAL;
 
-	ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-	if (ctx == NULL)
-		return -1;
-
 	if (!we_are_private && (derive_private || hardened))
 		return wipe_key_fail(key_out); /* Unsupported derivation */
 
@@ -446,10 +445,18 @@ int bip32_key_from_parent(const struct ext_key *hdkey, uint32_t child_num,
 		 */
 		secp256k1_pubkey pub_key;
 		size_t len = sizeof(key_out->pub_key);
+		int tweaked;
+
+		if (!pubkey_parse(&pub_key, hdkey->pub_key, sizeof(hdkey->pub_key)))
+			goto fail;
+
+		ctx = eth_ecdsa_context_acquire();
+		if (ctx == NULL)
+			goto fail;
+		tweaked = secp256k1_ec_pubkey_tweak_add(ctx, &pub_key, u8);
+		eth_ecdsa_context_release(ctx);
 
-		/* FIXME: Out of bounds on pubkey_tweak_add */
-		if (!pubkey_parse(&pub_key, hdkey->pub_key, sizeof(hdkey->pub_key)) ||
-				!secp256k1_ec_pubkey_tweak_add(ctx, &pub_key, u8) ||
+		if (!tweaked ||
 				!pubkey_serialize(key_out->pub_key, &len, &pub_key,
 						SECP256K1_EC_COMPRESSED) ||
 				len != sizeof(key_out->pub_key)) {
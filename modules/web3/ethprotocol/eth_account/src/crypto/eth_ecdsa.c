@@ -1,11 +1,143 @@
 
 #include "eth_ecdsa.h"
 
+#include <stdatomic.h>
+
 #include "keccak256.h"
 #include "secp256k1_recovery.h"
 
+#define ETH_ECDSA_RERANDOMIZE_INTERVAL 1024
+
+/*
+ * Two contexts: signers use the active one while the other one is
+ * re-randomized, then they are swapped. A context is only re-randomized when
+ * no signer holds it, so signing never waits and never sees a context being
+ * modified.
+ */
+static secp256k1_context *eth_ecdsa_ctx[2];
+static atomic_int eth_ecdsa_ctx_readers[2];
+static atomic_int eth_ecdsa_ctx_active;
+/* 0: not created, 1: being created, 2: ready. */
+static atomic_int eth_ecdsa_ctx_state;
+static atomic_flag eth_ecdsa_ctx_updating = ATOMIC_FLAG_INIT;
+static atomic_uint eth_ecdsa_ctx_uses;
+static int eth_ecdsa_ctx_seeded;
+static uint8_t eth_ecdsa_ctx_seed[32];
+
+/* Randomizes ctx with a value derived from the seed, then advances the seed. */
+static int eth_ecdsa_context_reseed(secp256k1_context *ctx) {
+	uint8_t buf[33], blind[32];
+	int r;
+
+	memcpy(buf, eth_ecdsa_ctx_seed, 32);
+	buf[32] = 0;
+	eth_keccak256(blind, buf, 33);
+	buf[32] = 1;
+	eth_keccak256(eth_ecdsa_ctx_seed, buf, 33);
+
+	r = secp256k1_context_randomize(ctx, blind);
+	memset(buf, 0, sizeof(buf));
+	memset(blind, 0, sizeof(blind));
+	return r == 1 ? 1 : -1;
+}
+
+int eth_ecdsa_context_init(const uint8_t *seed32) {
+	int expected = 0;
+
+	if (!atomic_compare_exchange_strong(&eth_ecdsa_ctx_state, &expected, 1)) {
+		/* Created, or being created by another thread. */
+		while (atomic_load(&eth_ecdsa_ctx_state) == 1)
+			;
+		return atomic_load(&eth_ecdsa_ctx_state) == 2 ? 1 : -1;
+	}
+
+	eth_ecdsa_ctx[0] = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	eth_ecdsa_ctx[1] = eth_ecdsa_ctx[0] != NULL ? secp256k1_context_clone(eth_ecdsa_ctx[0]) : NULL;
+	if (eth_ecdsa_ctx[0] == NULL || eth_ecdsa_ctx[1] == NULL)
+		goto fail;
+
+	eth_ecdsa_ctx_seeded = seed32 != NULL;
+	if (seed32 != NULL) {
+		memcpy(eth_ecdsa_ctx_seed, seed32, 32);
+		if (eth_ecdsa_context_reseed(eth_ecdsa_ctx[0]) != 1 ||
+				eth_ecdsa_context_reseed(eth_ecdsa_ctx[1]) != 1)
+			goto fail;
+	}
+
+	atomic_store(&eth_ecdsa_ctx_active, 0);
+	atomic_store(&eth_ecdsa_ctx_state, 2);
+	return 1;
+
+fail:
+	if (eth_ecdsa_ctx[0] != NULL)
+		secp256k1_context_destroy(eth_ecdsa_ctx[0]);
+	if (eth_ecdsa_ctx[1] != NULL)
+		secp256k1_context_destroy(eth_ecdsa_ctx[1]);
+	eth_ecdsa_ctx[0] = eth_ecdsa_ctx[1] = NULL;
+	atomic_store(&eth_ecdsa_ctx_state, 0);
+	return -1;
+}
+
+void eth_ecdsa_context_free(void) {
+	if (atomic_load(&eth_ecdsa_ctx_state) != 2)
+		return;
+
+	secp256k1_context_destroy(eth_ecdsa_ctx[0]);
+	secp256k1_context_destroy(eth_ecdsa_ctx[1]);
+	eth_ecdsa_ctx[0] = eth_ecdsa_ctx[1] = NULL;
+	memset(eth_ecdsa_ctx_seed, 0, sizeof(eth_ecdsa_ctx_seed));
+	eth_ecdsa_ctx_seeded = 0;
+	atomic_store(&eth_ecdsa_ctx_state, 0);
+}
+
+const secp256k1_context *eth_ecdsa_context_acquire(void) {
+	int idx;
+
+	if (atomic_load(&eth_ecdsa_ctx_state) != 2 && eth_ecdsa_context_init(NULL) != 1)
+		return NULL;
+
+	for (;;) {
+		idx = atomic_load(&eth_ecdsa_ctx_active);
+		atomic_fetch_add(&eth_ecdsa_ctx_readers[idx], 1);
+		/* Still active, it cannot be re-randomized until released. */
+		if (atomic_load(&eth_ecdsa_ctx_active) == idx)
+			return eth_ecdsa_ctx[idx];
+		atomic_fetch_sub(&eth_ecdsa_ctx_readers[idx], 1);
+	}
+}
+
+void eth_ecdsa_context_release(const secp256k1_context *ctx) {
+	if (ctx == NULL)
+		return;
+
+	atomic_fetch_sub(&eth_ecdsa_ctx_readers[ctx == eth_ecdsa_ctx[0] ? 0 : 1], 1);
+	if ((atomic_fetch_add(&eth_ecdsa_ctx_uses, 1) + 1) % ETH_ECDSA_RERANDOMIZE_INTERVAL == 0)
+		eth_ecdsa_context_rerandomize();
+}
+
+int eth_ecdsa_context_rerandomize(void) {
+	int idx, r = 0;
+
+	if (atomic_load(&eth_ecdsa_ctx_state) != 2 || !eth_ecdsa_ctx_seeded)
+		return 0;
+
+	/* Another thread is re-randomizing, skip this time. */
+	if (atomic_flag_test_and_set(&eth_ecdsa_ctx_updating))
+		return 0;
+
+	idx = 1 - atomic_load(&eth_ecdsa_ctx_active);
+	if (atomic_load(&eth_ecdsa_ctx_readers[idx]) == 0) {
+		r = eth_ecdsa_context_reseed(eth_ecdsa_ctx[idx]);
+		if (r == 1)
+			atomic_store(&eth_ecdsa_ctx_active, idx);
+	}
+
+	atomic_flag_clear(&eth_ecdsa_ctx_updating);
+	return r;
+}
+
 int eth_ecdsa_pubkey_get(uint8_t *dest, const uint8_t *privkey) {
-	secp256k1_context *secp_ctx;
+	const secp256k1_context *secp_ctx;
 	secp256k1_pubkey secp_pub;
 	size_t outlen = 65;
 	uint8_t tmp[65];
@@ -14,23 +146,24 @@ int eth_ecdsa_pubkey_get(uint8_t *dest, const uint8_t *privkey) {
 	if (dest == NULL || privkey == NULL)
 		return -1;
 
-	secp_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	secp_ctx = eth_ecdsa_context_acquire();
 	if (secp_ctx == NULL)
 		return -1;
 
 	r = secp256k1_ec_pubkey_create(secp_ctx, &secp_pub, privkey);
+	if (r == 1)
+		secp256k1_ec_pubkey_serialize(secp_ctx, tmp, &outlen, &secp_pub,
+				SECP256K1_EC_UNCOMPRESSED);
+	eth_ecdsa_context_release(secp_ctx);
 	if (r == 0)
 		return -1;
 
-	secp256k1_ec_pubkey_serialize(secp_ctx, tmp, &outlen, &secp_pub,
-			SECP256K1_EC_UNCOMPRESSED);
 	memcpy(dest, tmp + 1, 64);
-	secp256k1_context_destroy(secp_ctx);
 	return 1;
 }
 
 int eth_ecdsa_pubkey_get_with_compressed(uint8_t *dest, const uint8_t *privkey) {
-	secp256k1_context *secp_ctx;
+	const secp256k1_context *secp_ctx;
 	secp256k1_pubkey secp_pub;
 	size_t outlen = 33;
 	uint8_t tmp[33];
@@ -39,84 +172,138 @@ int eth_ecdsa_pubkey_get_with_compressed(uint8_t *dest, const uint8_t *privkey)
 	if (dest == NULL || privkey == NULL)
 		return -1;
 
-	secp_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	secp_ctx = eth_ecdsa_context_acquire();
 	if (secp_ctx == NULL)
 		return -1;
 
 	r = secp256k1_ec_pubkey_create(secp_ctx, &secp_pub, privkey);
+	if (r == 1)
+		secp256k1_ec_pubkey_serialize(secp_ctx, tmp, &outlen, &secp_pub,
+				SECP256K1_EC_COMPRESSED);
+	eth_ecdsa_context_release(secp_ctx);
 	if (r == 0)
 		return -1;
 
-	secp256k1_ec_pubkey_serialize(secp_ctx, tmp, &outlen, &secp_pub,
-			SECP256K1_EC_COMPRESSED);
 	memcpy(dest, tmp, 33);
-	secp256k1_context_destroy(secp_ctx);
 	return 1;
 }
 
-int eth_ecdsa_sign(struct eth_ecdsa_signature *dest, const uint8_t *privkey,
+int eth_ecdsa_sign_with_context(const secp256k1_context *ctx,
+		struct eth_ecdsa_signature *dest, const uint8_t *privkey,
 		const uint8_t *bytes32) {
-	secp256k1_context *secp_ctx;
 	secp256k1_ecdsa_recoverable_signature secp_sig;
 	uint8_t signature[64];
-	int r = 0;
-
-	if (dest == NULL || privkey == NULL || bytes32 == NULL)
-		return -1;
 
-	secp_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-	if (secp_ctx == NULL)
+	if (ctx == NULL || dest == NULL || privkey == NULL || bytes32 == NULL)
 		return -1;
 
-	r = secp256k1_ecdsa_sign_recoverable(secp_ctx, &secp_sig, bytes32, privkey,
-			NULL, NULL);
-	if (r == 0)
+	if (secp256k1_ecdsa_sign_recoverable(ctx, &secp_sig, bytes32, privkey,
+				NULL, NULL) == 0)
 		return -1;
 
-	r = secp256k1_ecdsa_recoverable_signature_serialize_compact(
-			secp_ctx, signature, &dest->recid, &secp_sig);
-	if (r == 0)
+	if (secp256k1_ecdsa_recoverable_signature_serialize_compact(
+				ctx, signature, &dest->recid, &secp_sig) == 0)
 		return -1;
 
 	memcpy(dest->r, signature, 32);
 	memcpy(dest->s, signature + 32, 32);
-
-	secp256k1_context_destroy(secp_ctx);
 	return 1;
 }
 
-int seckey_tweak_add(unsigned char *seckey, const unsigned char *tweak) {
-	secp256k1_context *secp_ctx;
-	secp_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-	if (secp_ctx == NULL)
+int eth_ecdsa_sign(struct eth_ecdsa_signature *dest, const uint8_t *privkey,
+		const uint8_t *bytes32) {
+	const secp256k1_context *secp_ctx;
+	int r;
+
+	if (dest == NULL || privkey == NULL || bytes32 == NULL)
 		return -1;
-	secp256k1_ec_privkey_tweak_add(secp_ctx, seckey, tweak);
 
-	secp256k1_context_destroy(secp_ctx);
+	secp_ctx = eth_ecdsa_context_acquire();
+	if (secp_ctx == NULL)
+		return -1;
 
-	return 0;
+	r = eth_ecdsa_sign_with_context(secp_ctx, dest, privkey, bytes32);
+	eth_ecdsa_context_release(secp_ctx);
+	return r;
 }
 
-int pubkey_parse(secp256k1_pubkey *pubkey, const unsigned char *input, size_t input_len) {
-	secp256k1_context *secp_ctx;
-	secp_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+int seckey_tweak_add(unsigned char *seckey, const unsigned char *tweak) {
+	const secp256k1_context *secp_ctx;
+	int r;
+
+	secp_ctx = eth_ecdsa_context_acquire();
 	if (secp_ctx == NULL)
 		return -1;
-	secp256k1_ec_pubkey_parse(secp_ctx, pubkey, input, input_len);
+	r = secp256k1_ec_privkey_tweak_add(secp_ctx, seckey, tweak);
+	eth_ecdsa_context_release(secp_ctx);
+
+	return r == 1 ? 0 : -1;
+}
+
+int pubkey_parse(secp256k1_pubkey *pubkey, const unsigned char *input, size_t input_len) {
+	const secp256k1_context *secp_ctx;
+	int r;
 
-	secp256k1_context_destroy(secp_ctx);
+	secp_ctx = eth_ecdsa_context_acquire();
+	if (secp_ctx == NULL)
+		return 0;
+	r = secp256k1_ec_pubkey_parse(secp_ctx, pubkey, input, input_len);
+	eth_ecdsa_context_release(secp_ctx);
 
-	return 0;
+	return r;
 }
 
 int pubkey_serialize(unsigned char *output, size_t *outputlen, const secp256k1_pubkey *pubkey, unsigned int flags) {
-	secp256k1_context *secp_ctx;
-	secp_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	const secp256k1_context *secp_ctx;
+	int r;
+
+	secp_ctx = eth_ecdsa_context_acquire();
 	if (secp_ctx == NULL)
+		return 0;
+	r = secp256k1_ec_pubkey_serialize(secp_ctx, output, outputlen, pubkey, flags);
+	eth_ecdsa_context_release(secp_ctx);
+
+	return r;
+}
+
+int eth_ecdsa_recover_with_context(const secp256k1_context *ctx, uint8_t *dest,
+		const struct eth_ecdsa_signature *sig, const uint8_t *data32) {
+	secp256k1_ecdsa_recoverable_signature secp_sig;
+	secp256k1_pubkey secp_pub;
+	uint8_t compact[64];
+	uint8_t tmp[65];
+	size_t outlen = 65;
+
+	if (ctx == NULL || dest == NULL || sig == NULL || data32 == NULL)
+		return -1;
+
+	if (sig->recid < 0 || sig->recid > 3)
+		return -1;
+
+	memcpy(compact, sig->r, 32);
+	memcpy(compact + 32, sig->s, 32);
+
+	if (secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &secp_sig, compact, sig->recid) == 0)
 		return -1;
-	secp256k1_ec_pubkey_serialize(secp_ctx, output, outputlen, pubkey, flags);
 
-	secp256k1_context_destroy(secp_ctx);
+	if (secp256k1_ecdsa_recover(ctx, &secp_pub, &secp_sig, data32) == 0)
+		return -1;
+
+	secp256k1_ec_pubkey_serialize(ctx, tmp, &outlen, &secp_pub, SECP256K1_EC_UNCOMPRESSED);
+	memcpy(dest, tmp + 1, 64);
+	return 1;
+}
+
+int eth_ecdsa_recover(uint8_t *dest, const struct eth_ecdsa_signature *sig,
+		const uint8_t *data32) {
+	const secp256k1_context *secp_ctx;
+	int r;
+
+	secp_ctx = eth_ecdsa_context_acquire();
+	if (secp_ctx == NULL)
+		return -1;
 
-	return 0;
+	r = eth_ecdsa_recover_with_context(secp_ctx, dest, sig, data32);
+	eth_ecdsa_context_release(secp_ctx);
+	return r;
 }
@@ -0,0 +1,387 @@
+#include "header_chain.h"
+
+#include "core/io/file_access.h"
+
+#include "keccak256.h"
+#include "rlp_writer.h"
+#include "transaction_decoder.h"
+#include "u256.h"
+#include "u256_math.h"
+
+enum HeaderFieldKind {
+	FIELD_BYTES32,
+	FIELD_ADDRESS,
+	FIELD_BLOOM,
+	FIELD_NONCE,
+	FIELD_BYTES,
+	FIELD_UINT,
+};
+
+struct HeaderField {
+	const char *name;
+	HeaderFieldKind kind;
+};
+
+// Header fields in RLP order. The ones after "nonce" were added by forks
+// (London, Shanghai, Cancun, Prague) and are present from that fork on.
+static const HeaderField HEADER_FIELDS[] = {
+	{ "parentHash", FIELD_BYTES32 },
+	{ "sha3Uncles", FIELD_BYTES32 },
+	{ "miner", FIELD_ADDRESS },
+	{ "stateRoot", FIELD_BYTES32 },
+	{ "transactionsRoot", FIELD_BYTES32 },
+	{ "receiptsRoot", FIELD_BYTES32 },
+	{ "logsBloom", FIELD_BLOOM },
+	{ "difficulty", FIELD_UINT },
+	{ "number", FIELD_UINT },
+	{ "gasLimit", FIELD_UINT },
+	{ "gasUsed", FIELD_UINT },
+	{ "timestamp", FIELD_UINT },
+	{ "extraData", FIELD_BYTES },
+	{ "mixHash", FIELD_BYTES32 },
+	{ "nonce", FIELD_NONCE },
+	{ "baseFeePerGas", FIELD_UINT },
+	{ "withdrawalsRoot", FIELD_BYTES32 },
+	{ "blobGasUsed", FIELD_UINT },
+	{ "excessBlobGas", FIELD_UINT },
+	{ "parentBeaconBlockRoot", FIELD_BYTES32 },
+	{ "requestsHash", FIELD_BYTES32 },
+};
+
+static const int HEADER_REQUIRED_FIELDS = 15;
+static const int HEADER_FIELD_COUNT = sizeof(HEADER_FIELDS) / sizeof(HEADER_FIELDS[0]);
+
+static const uint32_t HEADER_CHAIN_MAGIC = 0x31434448; // "HDC1"
+
+static void _append_rlp_bytes(LocalVector<uint8_t> &r_out, const uint8_t *p_bytes, size_t p_len) {
+	uint32_t offset = r_out.size();
+	r_out.resize(offset + eth_rlp_sizeof_bytes(p_bytes, p_len));
+	eth_rlp_put_bytes(r_out.ptr() + offset, p_bytes, p_len);
+}
+
+static bool _append_field(LocalVector<uint8_t> &r_payload, const HeaderField &p_field, const String &p_value) {
+	int fixed_len = 0;
+	switch (p_field.kind) {
+		case FIELD_BYTES32:
+			fixed_len = 32;
+			break;
+		case FIELD_ADDRESS:
+			fixed_len = 20;
+			break;
+		case FIELD_BLOOM:
+			fixed_len = 256;
+			break;
+		case FIELD_NONCE:
+			fixed_len = 8;
+			break;
+		case FIELD_BYTES: {
+			String hex = p_value.begins_with("0x") ? p_value.substr(2) : p_value;
+			if (hex.length() % 2 != 0) {
+				return false;
+			}
+			PackedByteArray bytes = hex.hex_decode();
+			if (bytes.size() * 2 != hex.length()) {
+				return false;
+			}
+			_append_rlp_bytes(r_payload, bytes.ptr(), bytes.size());
+			return true;
+		}
+		case FIELD_UINT: {
+			CharString hex = p_value.utf8();
+			const char *str = hex.get_data();
+			size_t len = hex.length();
+			if (len >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+				str += 2;
+				len -= 2;
+			}
+			u256 value;
+			if (len == 0 || !u256_from_hex(value, str, len)) {
+				return false;
+			}
+			uint8_t bytes[32];
+			size_t bytes_len = u256_to_be_bytes_min(value, bytes);
+			_append_rlp_bytes(r_payload, bytes, bytes_len);
+			return true;
+		}
+	}
+
+	uint8_t bytes[256];
+	if (!TransactionDecoder::parse_hex(p_value, bytes, fixed_len)) {
+		return false;
+	}
+	_append_rlp_bytes(r_payload, bytes, fixed_len);
+	return true;
+}
+
+bool HeaderChain::encode(const Dictionary &p_header, LocalVector<uint8_t> &r_encoded) {
+	LocalVector<uint8_t> payload;
+	int count = 0;
+	for (; count < HEADER_FIELD_COUNT && p_header.has(HEADER_FIELDS[count].name); count++) {
+		if (!_append_field(payload, HEADER_FIELDS[count], p_header[HEADER_FIELDS[count].name])) {
+			ERR_FAIL_V_MSG(false, vformat("Invalid header field %s", HEADER_FIELDS[count].name));
+		}
+	}
+	ERR_FAIL_COND_V_MSG(count < HEADER_REQUIRED_FIELDS, false, vformat("Missing header field %s", HEADER_FIELDS[count].name));
+	// A fork field after a missing one would hash to a different header.
+	for (int i = count + 1; i < HEADER_FIELD_COUNT; i++) {
+		ERR_FAIL_COND_V_MSG(p_header.has(HEADER_FIELDS[i].name), false, vformat("Header has %s but not %s", HEADER_FIELDS[i].name, HEADER_FIELDS[count].name));
+	}
+
+	r_encoded.resize(eth_rlp_sizeof_list(payload.size()));
+	uint8_t *out = eth_rlp_put_list(r_encoded.ptr(), payload.size());
+	memcpy(out, payload.ptr(), payload.size());
+	return true;
+}
+
+PackedByteArray HeaderChain::encode_header(const Dictionary &header) {
+	LocalVector<uint8_t> encoded;
+	if (!encode(header, encoded)) {
+		return PackedByteArray();
+	}
+	PackedByteArray result;
+	result.resize(encoded.size());
+	memcpy(result.ptrw(), encoded.ptr(), encoded.size());
+	return result;
+}
+
+String HeaderChain::compute_hash(const Dictionary &header) {
+	LocalVector<uint8_t> encoded;
+	if (!encode(header, encoded)) {
+		return String();
+	}
+	uint8_t hash[32];
+	eth_keccak256(hash, encoded.ptr(), encoded.size());
+	return "0x" + String::hex_encode_buffer(hash, 32);
+}
+
+bool HeaderChain::verify_header(const Dictionary &header) {
+	String hash = compute_hash(header);
+	return !hash.is_empty() && header.has("hash") && String(header["hash"]).to_lower() == hash;
+}
+
+const HeaderChain::Header *HeaderChain::_find(uint64_t p_number) const {
+	if (m_headers.is_empty() || p_number < m_headers[0].number || p_number - m_headers[0].number >= m_headers.size()) {
+		return nullptr;
+	}
+	return &m_headers[p_number - m_headers[0].number];
+}
+
+void HeaderChain::_trim() {
+	if (m_max_headers <= 0 || (int)m_headers.size() <= m_max_headers) {
+		return;
+	}
+	uint32_t drop = m_headers.size() - m_max_headers;
+	memmove(m_headers.ptr(), m_headers.ptr() + drop, m_max_headers * sizeof(Header));
+	m_headers.resize(m_max_headers);
+	// The new first header links to the anchor by hash, it is as trusted and
+	// becomes the anchor, so the trimmed chain still saves and loads.
+	if (m_has_anchor && m_anchor_number < m_headers[0].number) {
+		m_anchor_number = m_headers[0].number;
+		memcpy(m_anchor_hash, m_headers[0].hash, 32);
+	}
+}
+
+void HeaderChain::set_anchor(uint64_t number, const String &hash) {
+	uint8_t hash_bytes[32];
+	ERR_FAIL_COND_MSG(!TransactionDecoder::parse_hex(hash, hash_bytes, 32), "Invalid anchor hash: " + hash);
+	m_has_anchor = true;
+	m_anchor_number = number;
+	memcpy(m_anchor_hash, hash_bytes, 32);
+
+	const Header *anchor = _find(number);
+	if (anchor == nullptr || memcmp(anchor->hash, hash_bytes, 32) != 0) {
+		m_headers.clear();
+	}
+}
+
+int64_t HeaderChain::get_anchor_number() const {
+	return m_has_anchor ? (int64_t)m_anchor_number : -1;
+}
+
+String HeaderChain::get_anchor_hash() const {
+	return m_has_anchor ? "0x" + String::hex_encode_buffer(m_anchor_hash, 32) : String();
+}
+
+bool HeaderChain::add_header(const Dictionary &header) {
+	LocalVector<uint8_t> encoded;
+	if (!encode(header, encoded)) {
+		return false;
+	}
+
+	Header h;
+	eth_keccak256(h.hash, encoded.ptr(), encoded.size());
+	if (header.has("hash")) {
+		uint8_t claimed[32];
+		ERR_FAIL_COND_V_MSG(!TransactionDecoder::parse_hex(header["hash"], claimed, 32) || memcmp(claimed, h.hash, 32) != 0, false, "Header hash does not match its contents");
+	}
+	// The fields were validated by encode().
+	h.number = String(header["number"]).hex_to_int();
+	h.timestamp = String(header["timestamp"]).hex_to_int();
+	TransactionDecoder::parse_hex(header["parentHash"], h.parent_hash, 32);
+	TransactionDecoder::parse_hex(header["stateRoot"], h.state_root, 32);
+	TransactionDecoder::parse_hex(header["transactionsRoot"], h.transactions_root, 32);
+	TransactionDecoder::parse_hex(header["receiptsRoot"], h.receipts_root, 32);
+
+	if (m_headers.is_empty()) {
+		if (m_has_anchor) {
+			ERR_FAIL_COND_V_MSG(h.number != m_anchor_number || memcmp(h.hash, m_anchor_hash, 32) != 0, false, "First header must be the anchor");
+		}
+		m_headers.push_back(h);
+		return true;
+	}
+
+	const Header &first = m_headers[0];
+	const Header &tip = m_headers[m_headers.size() - 1];
+	const Header *existing = _find(h.number);
+	if (existing != nullptr && memcmp(existing->hash, h.hash, 32) == 0) {
+		return true;
+	}
+
+	if (h.number == first.number - 1 && first.number > 0) {
+		ERR_FAIL_COND_V_MSG(memcmp(first.parent_hash, h.hash, 32) != 0, false, "Header is not the parent of the first header");
+		ERR_FAIL_COND_V_MSG(m_max_headers > 0 && (int)m_headers.size() >= m_max_headers, false, "Header chain is full");
+		m_headers.insert(0, h);
+		return true;
+	}
+
+	ERR_FAIL_COND_V_MSG(h.number <= first.number || h.number > tip.number + 1, false, vformat("Header %d does not link to the chain", (int64_t)h.number));
+	const Header *parent = _find(h.number - 1);
+	ERR_FAIL_COND_V_MSG(memcmp(parent->hash, h.parent_hash, 32) != 0, false, vformat("Header %d does not link to its parent", (int64_t)h.number));
+	if (existing != nullptr) {
+		// Reorg, the trusted anchor cannot be replaced.
+		ERR_FAIL_COND_V_MSG(m_has_anchor && m_anchor_number >= h.number, false, "Header conflicts with the anchor");
+		m_headers.resize(h.number - first.number);
+	}
+	m_headers.push_back(h);
+	_trim();
+	return true;
+}
+
+void HeaderChain::set_max_headers(int max_headers) {
+	m_max_headers = MAX(max_headers, 0);
+	_trim();
+}
+
+int HeaderChain::get_max_headers() const {
+	return m_max_headers;
+}
+
+int HeaderChain::size() const {
+	return m_headers.size();
+}
+
+void HeaderChain::clear() {
+	m_headers.clear();
+}
+
+int64_t HeaderChain::get_first_number() const {
+	return m_headers.is_empty() ? -1 : (int64_t)m_headers[0].number;
+}
+
+int64_t HeaderChain::get_tip_number() const {
+	return m_headers.is_empty() ? -1 : (int64_t)m_headers[m_headers.size() - 1].number;
+}
+
+bool HeaderChain::has_header(uint64_t number) const {
+	return _find(number) != nullptr;
+}
+
+String HeaderChain::get_hash(uint64_t number) const {
+	const Header *h = _find(number);
+	return h != nullptr ? "0x" + String::hex_encode_buffer(h->hash, 32) : String();
+}
+
+Dictionary HeaderChain::get_header(uint64_t number) const {
+	Dictionary result;
+	const Header *h = _find(number);
+	if (h == nullptr) {
+		return result;
+	}
+	result["number"] = (int64_t)h->number;
+	result["timestamp"] = (int64_t)h->timestamp;
+	result["hash"] = "0x" + String::hex_encode_buffer(h->hash, 32);
+	result["parentHash"] = "0x" + String::hex_encode_buffer(h->parent_hash, 32);
+	result["stateRoot"] = "0x" + String::hex_encode_buffer(h->state_root, 32);
+	result["transactionsRoot"] = "0x" + String::hex_encode_buffer(h->transactions_root, 32);
+	result["receiptsRoot"] = "0x" + String::hex_encode_buffer(h->receipts_root, 32);
+	return result;
+}
+
+// File: magic, count, then per header number, timestamp and the five hashes.
+Error HeaderChain::save(const String &path) const {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, "Cannot open " + path);
+	file->store_32(HEADER_CHAIN_MAGIC);
+	file->store_32(m_headers.size());
+	for (uint32_t i = 0; i < m_headers.size(); i++) {
+		const Header &h = m_headers[i];
+		file->store_64(h.number);
+		file->store_64(h.timestamp);
+		file->store_buffer(h.hash, 32);
+		file->store_buffer(h.parent_hash, 32);
+		file->store_buffer(h.state_root, 32);
+		file->store_buffer(h.transactions_root, 32);
+		file->store_buffer(h.receipts_root, 32);
+	}
+	return file->get_error();
+}
+
+Error HeaderChain::load(const String &path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, "Cannot open " + path);
+	ERR_FAIL_COND_V_MSG(file->get_32() != HEADER_CHAIN_MAGIC, ERR_FILE_UNRECOGNIZED, "Not a header chain file: " + path);
+
+	uint32_t count = file->get_32();
+	ERR_FAIL_COND_V_MSG(file->get_length() < 8 + (uint64_t)count * 176, ERR_FILE_CORRUPT, "Truncated header chain file: " + path);
+	LocalVector<Header> headers;
+	headers.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		Header &h = headers[i];
+		h.number = file->get_64();
+		h.timestamp = file->get_64();
+		file->get_buffer(h.hash, 32);
+		file->get_buffer(h.parent_hash, 32);
+		file->get_buffer(h.state_root, 32);
+		file->get_buffer(h.transactions_root, 32);
+		file->get_buffer(h.receipts_root, 32);
+		// The hashes were verified when added, the links are checked again.
+		if (i > 0) {
+			ERR_FAIL_COND_V_MSG(h.number != headers[i - 1].number + 1 || memcmp(h.parent_hash, headers[i - 1].hash, 32) != 0, ERR_FILE_CORRUPT, "Broken header chain file: " + path);
+		}
+	}
+
+	m_headers = headers;
+	if (m_has_anchor) {
+		const Header *anchor = _find(m_anchor_number);
+		if (anchor == nullptr || memcmp(anchor->hash, m_anchor_hash, 32) != 0) {
+			m_headers.clear();
+			ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Header chain file does not contain the anchor: " + path);
+		}
+	}
+	_trim();
+	return OK;
+}
+
+void HeaderChain::_bind_methods() {
+	ClassDB::bind_static_method("HeaderChain", D_METHOD("encode_header", "header"), &HeaderChain::encode_header);
+	ClassDB::bind_static_method("HeaderChain", D_METHOD("compute_hash", "header"), &HeaderChain::compute_hash);
+	ClassDB::bind_static_method("HeaderChain", D_METHOD("verify_header", "header"), &HeaderChain::verify_header);
+
+	ClassDB::bind_method(D_METHOD("set_anchor", "number", "hash"), &HeaderChain::set_anchor);
+	ClassDB::bind_method(D_METHOD("get_anchor_number"), &HeaderChain::get_anchor_number);
+	ClassDB::bind_method(D_METHOD("get_anchor_hash"), &HeaderChain::get_anchor_hash);
+	ClassDB::bind_method(D_METHOD("add_header", "header"), &HeaderChain::add_header);
+	ClassDB::bind_method(D_METHOD("set_max_headers", "max_headers"), &HeaderChain::set_max_headers);
+	ClassDB::bind_method(D_METHOD("get_max_headers"), &HeaderChain::get_max_headers);
+	ClassDB::bind_method(D_METHOD("size"), &HeaderChain::size);
+	ClassDB::bind_method(D_METHOD("clear"), &HeaderChain::clear);
+	ClassDB::bind_method(D_METHOD("get_first_number"), &HeaderChain::get_first_number);
+	ClassDB::bind_method(D_METHOD("get_tip_number"), &HeaderChain::get_tip_number);
+	ClassDB::bind_method(D_METHOD("has_header", "number"), &HeaderChain::has_header);
+	ClassDB::bind_method(D_METHOD("get_hash", "number"), &HeaderChain::get_hash);
+	ClassDB::bind_method(D_METHOD("get_header", "number"), &HeaderChain::get_header);
+	ClassDB::bind_method(D_METHOD("save", "path"), &HeaderChain::save);
+	ClassDB::bind_method(D_METHOD("load", "path"), &HeaderChain::load);
+}
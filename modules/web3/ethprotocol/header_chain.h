@@ -0,0 +1,112 @@
+#ifndef HEADER_CHAIN_H
+#define HEADER_CHAIN_H
+
+#include "core/error/error_list.h"
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+// Verifies block headers returned by eth_getBlockByNumber/eth_getBlockByHash
+// and keeps a contiguous chain of them. A header is accepted only if the
+// keccak of its RLP encoding is its hash and it links to the headers already
+// held (by parent hash, forwards or backwards), so headers from an untrusted
+// endpoint can be cached once the first one is anchored to a trusted hash.
+//
+// Only the fields needed to check later data are kept (hashes, roots,
+// timestamp), about 170 bytes per header, and the chain can be saved to and
+// loaded from a file.
+class HeaderChain : public RefCounted {
+	GDCLASS(HeaderChain, RefCounted);
+
+public:
+	struct Header {
+		uint64_t number = 0;
+		uint64_t timestamp = 0;
+		uint8_t hash[32] = {};
+		uint8_t parent_hash[32] = {};
+		uint8_t state_root[32] = {};
+		uint8_t transactions_root[32] = {};
+		uint8_t receipts_root[32] = {};
+	};
+
+	// RLP encoding of a JSON-RPC header, fork fields are included when present.
+	static bool encode(const Dictionary &p_header, LocalVector<uint8_t> &r_encoded);
+
+private:
+	// m_headers[i] is block m_headers[0].number + i.
+	LocalVector<Header> m_headers;
+	bool m_has_anchor = false;
+	uint64_t m_anchor_number = 0;
+	uint8_t m_anchor_hash[32] = {};
+	int m_max_headers = 0;
+
+	const Header *_find(uint64_t p_number) const;
+	void _trim();
+
+protected:
+	static void _bind_methods();
+
+public:
+	/**
+	 * @brief  RLP encodes a header from its JSON-RPC fields.
+	 * @return The encoding, empty if a field is missing or malformed.
+	 */
+	static PackedByteArray encode_header(const Dictionary &header);
+
+	/**
+	 * @brief  keccak256 of the header encoding.
+	 * @return 0x-prefixed hash, empty on error.
+	 */
+	static String compute_hash(const Dictionary &header);
+
+	/**
+	 * @brief  True if the "hash" field of the header is its computed hash.
+	 */
+	static bool verify_header(const Dictionary &header);
+
+	/**
+	 * @brief  Sets the trusted block the chain must start from. The chain is
+	 *         cleared if it does not contain that block.
+	 */
+	void set_anchor(uint64_t number, const String &hash);
+	// The anchor moves to the first header when older headers are trimmed,
+	// persist it with save() to load the chain again. -1 / empty when unset.
+	int64_t get_anchor_number() const;
+	String get_anchor_hash() const;
+
+	/**
+	 * @brief  Adds a verified header. Without an anchor, the first header
+	 *         is trusted as is. Later headers must extend the chain at the
+	 *         tip or before the first header. A header replacing one in the
+	 *         chain (reorg) drops that block and its descendants.
+	 * @return False if the header is invalid or does not link.
+	 */
+	bool add_header(const Dictionary &header);
+
+	/**
+	 * @brief  Keeps at most max_headers (oldest dropped first), 0 for no limit.
+	 *         Dropping the anchor makes the new first header the anchor.
+	 */
+	void set_max_headers(int max_headers);
+	int get_max_headers() const;
+
+	int size() const;
+	void clear();
+	// -1 when empty.
+	int64_t get_first_number() const;
+	int64_t get_tip_number() const;
+	bool has_header(uint64_t number) const;
+	// 0x-prefixed hash of a block in the chain, empty if not held.
+	String get_hash(uint64_t number) const;
+	// {"number", "hash", "parentHash", "stateRoot", "transactionsRoot",
+	// "receiptsRoot", "timestamp"}, empty if not held.
+	Dictionary get_header(uint64_t number) const;
+
+	Error save(const String &path) const;
+	Error load(const String &path);
+};
+
+#endif // HEADER_CHAIN_H
@@ -1,49 +1,161 @@
 #include "keccak256.h"
-#include "KeccakHash.h"
+#include "KeccakP-1600-times4-SnP.h"
+#include <stdio.h>
 #include <stdlib.h>
-#include <gmp.h>
+#include <string.h>
 
 #define KECCAK256_RATE 1088
 #define KECCAK256_CAPACITY 512
 #define KECCAK256_HASHBITLEN 256
 #define KECCAK256_DELIMITED_SUFFIX 0x1
+#define KECCAK256_RATE_BYTES (KECCAK256_RATE / 8)
+#define KECCAK256_RATE_LANES (KECCAK256_RATE / 64)
 
-int eth_keccak256(uint8_t *dest, const uint8_t *bytes, size_t len) {
-	Keccak_HashInstance instance;
-
-	if (dest == NULL || bytes == NULL)
+int eth_keccak256_init(eth_keccak256_ctx *ctx) {
+	if (ctx == NULL)
 		return -1;
 
-	if (Keccak_HashInitialize(&instance, KECCAK256_RATE, KECCAK256_CAPACITY,
+	if (Keccak_HashInitialize(ctx, KECCAK256_RATE, KECCAK256_CAPACITY,
 				KECCAK256_HASHBITLEN,
 				KECCAK256_DELIMITED_SUFFIX) == KECCAK_FAIL)
 		return -1;
 
-	if (Keccak_HashUpdate(&instance, bytes, len * 8) == KECCAK_FAIL)
+	return 1;
+}
+
+int eth_keccak256_update(eth_keccak256_ctx *ctx, const uint8_t *bytes, size_t len) {
+	if (ctx == NULL || (bytes == NULL && len > 0))
+		return -1;
+
+	if (len == 0)
+		return 1;
+
+	return Keccak_HashUpdate(ctx, bytes, len * 8) == KECCAK_SUCCESS ? 1 : -1;
+}
+
+int eth_keccak256_final(eth_keccak256_ctx *ctx, uint8_t *dest) {
+	if (ctx == NULL || dest == NULL)
+		return -1;
+
+	return Keccak_HashFinal(ctx, dest) == KECCAK_SUCCESS ? 1 : -1;
+}
+
+int eth_keccak256(uint8_t *dest, const uint8_t *bytes, size_t len) {
+	eth_keccak256_ctx ctx;
+
+	if (dest == NULL || (bytes == NULL && len > 0))
+		return -1;
+
+	if (eth_keccak256_init(&ctx) != 1 || eth_keccak256_update(&ctx, bytes, len) != 1)
 		return -1;
 
-	return Keccak_HashFinal(&instance, dest) == KECCAK_SUCCESS ? 1 : -1;
+	return eth_keccak256_final(&ctx, dest);
 }
 
 int eth_keccak256p(uint8_t *dest, const uint8_t *bytes, size_t len) {
-	int size, r;
-	char *sig, *tmp;
+	eth_keccak256_ctx ctx;
+	char prefix[64];
+	int size;
 
-	if (dest == NULL || bytes == NULL)
+	if (dest == NULL || (bytes == NULL && len > 0))
 		return -1;
 
-	size = gmp_asprintf(&sig, "\x19"
-							  "Ethereum Signed Message:\n%llu",
-			len);
-	tmp = realloc(sig, size + len);
-	if (tmp == NULL) {
-		free(sig);
+	/* The message is hashed after the prefix, never copied, so binary
+	   messages with zero bytes are hashed whole. */
+	size = snprintf(prefix, sizeof(prefix), "\x19"
+											"Ethereum Signed Message:\n%llu",
+			(unsigned long long)len);
+	if (size < 0 || size >= (int)sizeof(prefix))
 		return -1;
+
+	if (eth_keccak256_init(&ctx) != 1 ||
+			eth_keccak256_update(&ctx, (const uint8_t *)prefix, size) != 1 ||
+			eth_keccak256_update(&ctx, bytes, len) != 1)
+		return -1;
+
+	return eth_keccak256_final(&ctx, dest);
+}
+
+static uint64_t eth_keccak256_load64(const uint8_t *bytes) {
+	uint64_t lane = 0;
+	int i;
+
+	for (i = 7; i >= 0; i--)
+		lane = (lane << 8) | bytes[i];
+	return lane;
+}
+
+/* Block `block` of the padded input, the last one is built in `pad`. */
+static const uint8_t *eth_keccak256_block(const uint8_t *bytes, size_t len,
+		size_t block, uint8_t *pad) {
+	size_t offset = block * KECCAK256_RATE_BYTES, rem;
+
+	if (offset + KECCAK256_RATE_BYTES <= len)
+		return bytes + offset;
+
+	rem = len - offset;
+	memset(pad, 0, KECCAK256_RATE_BYTES);
+	if (rem > 0)
+		memcpy(pad, bytes + offset, rem);
+	pad[rem] ^= KECCAK256_DELIMITED_SUFFIX;
+	pad[KECCAK256_RATE_BYTES - 1] ^= 0x80;
+	return pad;
+}
+
+/* Four inputs of `blocks` padded blocks each. */
+static void eth_keccak256_x4(uint8_t *dest, const uint8_t *const *inputs,
+		const size_t *lens, size_t blocks) {
+	uint64_t states[KeccakP1600times4_statesSizeInBytes / 8];
+	uint8_t pad[4][KECCAK256_RATE_BYTES];
+	const uint8_t *block;
+	size_t b;
+	int i, j;
+
+	KeccakP1600times4_InitializeAll(states);
+	for (b = 0; b < blocks; b++) {
+		for (j = 0; j < 4; j++) {
+			block = eth_keccak256_block(inputs[j], lens[j], b, pad[j]);
+			for (i = 0; i < KECCAK256_RATE_LANES; i++)
+				states[i * 4 + j] ^= eth_keccak256_load64(block + i * 8);
+		}
+		KeccakP1600times4_PermuteAll_24rounds(states);
 	}
-	sig = tmp;
 
-	strncpy(sig + size, (char *)bytes, len);
-	r = eth_keccak256(dest, (uint8_t *)sig, size + len);
-	free(sig);
-	return r;
+	for (j = 0; j < 4; j++) {
+		for (i = 0; i < 32; i++)
+			dest[j * 32 + i] = (uint8_t)(states[(i / 8) * 4 + j] >> ((i % 8) * 8));
+	}
+}
+
+int eth_keccak256_batch(uint8_t *dest, const uint8_t *const *inputs,
+		const size_t *lens, size_t count) {
+	static const uint8_t empty[1] = { 0 };
+	size_t i = 0, blocks, j;
+	int same;
+
+	if (count == 0)
+		return 1;
+	if (dest == NULL || inputs == NULL || lens == NULL)
+		return -1;
+	for (j = 0; j < count; j++) {
+		if (inputs[j] == NULL && lens[j] > 0)
+			return -1;
+	}
+
+	while (i < count) {
+		blocks = lens[i] / KECCAK256_RATE_BYTES + 1;
+		same = i + 4 <= count;
+		for (j = 1; same && j < 4; j++)
+			same = lens[i + j] / KECCAK256_RATE_BYTES + 1 == blocks;
+
+		if (same) {
+			eth_keccak256_x4(dest + i * 32, inputs + i, lens + i, blocks);
+			i += 4;
+		} else {
+			if (eth_keccak256(dest + i * 32, inputs[i] != NULL ? inputs[i] : empty, lens[i]) < 0)
+				return -1;
+			i++;
+		}
+	}
+	return 1;
 }
@@ -5,10 +5,41 @@
 extern "C" {
 #endif
 
+#include "KeccakHash.h"
 #include "ethc-common.h"
 #include <stddef.h>
 #include <stdint.h>
 
+/*!
+ * @brief State of an incremental keccak256 computation, may be copied to
+ * fork the hash of a common prefix.
+ */
+typedef Keccak_HashInstance eth_keccak256_ctx;
+
+/*!
+ * @brief Starts an incremental keccak256 computation.
+ *
+ * @param[out] ctx The context to initialize.
+ */
+ETHC_EXPORT int eth_keccak256_init(eth_keccak256_ctx *ctx);
+
+/*!
+ * @brief Absorbs more input, the hash is the same as for the concatenation of every update.
+ *
+ * @param[in,out] ctx The context.
+ * @param[in] bytes A pointer to the input data, may be NULL if len is 0.
+ * @param[in] len The length of the input data.
+ */
+ETHC_EXPORT int eth_keccak256_update(eth_keccak256_ctx *ctx, const uint8_t *bytes, size_t len);
+
+/*!
+ * @brief Writes the hash, the context must be initialized again before reuse.
+ *
+ * @param[in,out] ctx The context.
+ * @param[out] dest A pointer to a 32-byte array to write the hash to.
+ */
+ETHC_EXPORT int eth_keccak256_final(eth_keccak256_ctx *ctx, uint8_t *dest);
+
 /*!
  * @brief Computes the keccak hash for the input data.
  *
@@ -45,6 +76,20 @@ ETHC_EXPORT int eth_keccak256(uint8_t *dest, const uint8_t *bytes, size_t len);
  */
 ETHC_EXPORT int eth_keccak256p(uint8_t *dest, const uint8_t *bytes, size_t len);
 
+/*!
+ * @brief Computes the keccak hashes of several inputs.
+ *
+ * Runs of four consecutive inputs spanning the same number of blocks
+ * (136 bytes each) are hashed together on interleaved states, so batches of
+ * same-sized inputs (leaves, storage slots, addresses) take the fast path.
+ *
+ * @param[out] dest A pointer to a count * 32-byte array to write the hashes to, in input order.
+ * @param[in] inputs Pointers to the input data, may be NULL for empty inputs.
+ * @param[in] lens The lengths of the input data.
+ * @param[in] count The number of inputs.
+ */
+ETHC_EXPORT int eth_keccak256_batch(uint8_t *dest, const uint8_t *const *inputs, const size_t *lens, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
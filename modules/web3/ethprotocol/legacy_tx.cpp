@@ -1,5 +1,9 @@
 #include "legacy_tx.h"
 
+#include "core/templates/local_vector.h"
+
+#include "u256.h"
+
 
 String uint64_to_hex_string(uint64_t value) {
     if (value == 0) {
@@ -33,7 +37,8 @@ void LegacyTx::set_chain_id(Ref<BigInt> chain_id) {
 }
 
 void LegacyTx::set_nonce(uint64_t nonce) {
-    this->m_nonce = nonce;
+    this->m_fields.nonce = nonce;
+    _invalidate(true, true);
 }
 
 void LegacyTx::set_gas_price(Ref<BigInt> gas_price) {
@@ -41,11 +46,23 @@ void LegacyTx::set_gas_price(Ref<BigInt> gas_price) {
 }
 
 void LegacyTx::set_gas_limit(uint64_t gas_limit) {
-    this->m_gas_limit = gas_limit;
+    this->m_fields.gas_limit = gas_limit;
+    _invalidate(true, true);
 }
 
 void LegacyTx::set_to_address(String to) {
-    this->m_to = to;
+	if (to.is_empty()) {
+		this->m_to = to;
+		this->m_fields.to.present = false;
+		_invalidate(true, true);
+		return;
+	}
+	uint8_t to_bytes[20];
+	ERR_FAIL_COND_MSG(!TransactionDecoder::parse_hex(to, to_bytes, 20), "Invalid to address: " + to);
+	this->m_to = to;
+	this->m_fields.to.present = true;
+	memcpy(this->m_fields.to.bytes, to_bytes, 20);
+	_invalidate(true, true);
 }
 
 void LegacyTx::set_value(Ref<BigInt> value) {
@@ -54,7 +71,8 @@ void LegacyTx::set_value(Ref<BigInt> value) {
 }
 
 void LegacyTx::set_data(PackedByteArray data) {
-    this->m_data = data;
+    this->m_fields.data = data;
+    _invalidate(true, true);
 }
 
 void LegacyTx::set_sign_v(Ref<BigInt> sign_v) {
@@ -74,7 +92,7 @@ Ref<BigInt> LegacyTx::get_chain_id() const {
 }
 
 uint64_t LegacyTx::get_nonce() const {
-    return this->m_nonce;
+    return this->m_fields.nonce;
 }
 
 Ref<BigInt> LegacyTx::get_gas_price() const {
@@ -82,7 +100,7 @@ Ref<BigInt> LegacyTx::get_gas_price() const {
 }
 
 uint64_t LegacyTx::get_gas_limit() const {
-    return this->m_gas_limit;
+    return this->m_fields.gas_limit;
 }
 
 String LegacyTx::get_to_address() const {
@@ -94,7 +112,7 @@ Ref<BigInt> LegacyTx::get_value() const {
 }
 
 PackedByteArray LegacyTx::get_data() const {
-    return this->m_data;
+    return this->m_fields.data;
 }
 
 Ref<BigInt> LegacyTx::get_sign_v() const {
@@ -109,402 +127,178 @@ Ref<BigInt> LegacyTx::get_sign_s() const {
     return this->m_s;
 }
 
-PackedByteArray LegacyTx::rlp_hash() {
-	struct eth_rlp rlp0;
-	uint8_t *rlp0_bytes;
-	size_t rlp0_len;
+void LegacyTx::_invalidate(bool p_unsigned, bool p_signed) {
+	if (p_unsigned) {
+		m_unsigned_cache.dirty = true;
+	}
+	if (p_signed) {
+		m_signed_cache.dirty = true;
+	}
+}
+
+// Mirrors a BigInt field into m_fields. Comparing the value is a limb copy,
+// much cheaper than re-encoding, and catches in-place arithmetic on a BigInt
+// that was passed to a setter.
+bool LegacyTx::_sync_uint(const Ref<BigInt> &p_number, const BigInt *&r_source, u256 &r_value, bool &r_changed) const {
+	const BigInt *source = p_number.ptr();
+	u256 value = {};
+	if (source != nullptr && !u256_from_mpz(value, source->m_number)) {
+		return false;
+	}
+	if (source == r_source && u256_cmp(value, r_value) == 0) {
+		return true;
+	}
+	r_source = source;
+	r_value = value;
+	r_changed = true;
+	return true;
+}
 
-	// Get the rlp format of the transaction
-	ERR_FAIL_COND_V_MSG(eth_rlp_init(&rlp0, ETH_RLP_ENCODE) < 0, PackedByteArray(), "eth_rlp_init failed");
+bool LegacyTx::_sync_fields(bool p_signed) const {
+	bool shared_changed = false;
+	bool tail_changed = false;
+
+	ERR_FAIL_COND_V_MSG(m_gas_price.is_null(), false, "rlp format failed: gas price is not set");
+	ERR_FAIL_COND_V_MSG(!_sync_uint(m_gas_price, m_gas_price_source, m_fields.gas_price, shared_changed), false, "rlp format gas price failed");
+	ERR_FAIL_COND_V_MSG(!_sync_uint(m_value, m_value_source, m_fields.value, shared_changed), false, "rlp format value failed");
+
+	if (p_signed) {
+		ERR_FAIL_COND_V_MSG(m_v.is_null() || m_v->is_zero(), false, "rlp format failed: v should not be zero");
+		ERR_FAIL_COND_V_MSG(m_r.is_null(), false, "rlp format failed: r is zero");
+		ERR_FAIL_COND_V_MSG(m_s.is_null(), false, "rlp format failed: s is zero");
+		ERR_FAIL_COND_V_MSG(!_sync_uint(m_v, m_v_source, m_fields.v, tail_changed), false, "rlp format v failed");
+		ERR_FAIL_COND_V_MSG(!_sync_uint(m_r, m_r_source, m_fields.r, tail_changed), false, "rlp format r failed");
+		ERR_FAIL_COND_V_MSG(!_sync_uint(m_s, m_s_source, m_fields.s, tail_changed), false, "rlp format s failed");
+	} else {
+		ERR_FAIL_COND_V_MSG(m_chain_id.is_null() || m_chain_id->is_zero(), false, "rlp format failed: chain id should not be zero");
+		ERR_FAIL_COND_V_MSG(!_sync_uint(m_chain_id, m_chain_id_source, m_fields.chain_id, tail_changed), false, "rlp format chain id failed");
+	}
 
-	// ERR_FAIL_COND_V_MSG(eth_rlp_array(&rlp0) < 0, PackedByteArray(), "eth_rlp_array failed");
-	if (eth_rlp_array(&rlp0) < 0) {
-		ERR_PRINT("eth_rlp_init failed");
-		eth_rlp_free(&rlp0);
-		return PackedByteArray();
+	if (shared_changed) {
+		m_unsigned_cache.dirty = true;
+		m_signed_cache.dirty = true;
 	}
-		// rlp format for nonce
-		// char* nonce = const_cast<char*>(this->get_nonce_hex().utf8().get_data());
-		CharString nonce_cstr = this->get_nonce_hex().utf8();
-		char *nonce = nonce_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &nonce, NULL) < 0, PackedByteArray(), "rlp format nonce failed");
-
-		// rlp format for gas price
-		CharString gas_price_cstr = m_gas_price->to_hex().utf8();
-		char *gas_price = gas_price_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_price, NULL) < 0, PackedByteArray(), "rlp format gas price failed");
-
-		// rlp format for gas limit
-		CharString gas_limit_cstr = uint64_to_hex_string(this->m_gas_limit).utf8();
-		char *gas_limit = gas_limit_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_limit, NULL) < 0, PackedByteArray(), "rlp format gas limit failed");
-
-		// rlp format for to address
-		print_line("rlp_hash format to address start.");
-		CharString to_cstr = m_to.utf8();
-		char *to = to_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_address(&rlp0, &to) < 0, PackedByteArray(), "rlp format to address failed");
-		print_line("rlp_hash format to address done.");
-
-		// rlp format for value
-		CharString value_cstr = m_value->to_hex().utf8();
-		char *value = value_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &value, NULL) < 0, PackedByteArray(), "rlp format value failed");
-
-		// rlp format for data
-		uint8_t *data_bytes = new uint8_t[m_data.size()];
-		memcpy(data_bytes, m_data.ptr(), m_data.size());
-		size_t data_len = m_data.size();
-		ERR_FAIL_COND_V_MSG(eth_rlp_bytes(&rlp0, &data_bytes, &data_len) < 0, PackedByteArray(), "rlp foramt data bytes failed");
-
-		// rlp format for chain id(v)
-		ERR_FAIL_COND_V_MSG(m_chain_id->is_zero(), PackedByteArray(), "rlp format failed: chain id should not be zero");
-		CharString chain_id_cstr = m_chain_id->to_hex().utf8();
-		char *chain_id = chain_id_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &chain_id, NULL) < 0, PackedByteArray(), "rlp format chain id failed");
-
-		// rlp format for r,s
-		uint8_t zero=0;
-		if (m_r.is_null() || m_r->is_zero()) {
-			ERR_FAIL_COND_V_MSG(eth_rlp_uint8(&rlp0, &zero) < 0, PackedByteArray(), "rlp format r(zero) failed");
-		} else {
-			CharString r_cstr = m_r->to_hex().utf8();
-			char *r = r_cstr.ptrw();
-			ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &r, NULL) < 0, PackedByteArray(), "rlp format r failed");
-		}
-
-		if (m_r.is_null() || m_s->is_zero()) {
-			ERR_FAIL_COND_V_MSG(eth_rlp_uint8(&rlp0, &zero) < 0, PackedByteArray(), "rlp format s(zero) failed");
-		} else {
-			CharString s_cstr = m_s->to_hex().utf8();
-			char *s = s_cstr.ptrw();
-			ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &s, NULL) < 0, PackedByteArray(), "rlp format s failed");
-		}
-
-	// ERR_FAIL_COND_V_MSG(eth_rlp_array_end(&rlp0) < 0, PackedByteArray(), "eth_rlp_array end failed");
-	if (eth_rlp_array_end(&rlp0) < 0) {
-		ERR_PRINT("eth_rlp_array end failed");
-		eth_rlp_free(&rlp0);
-		return PackedByteArray();
+	if (tail_changed) {
+		(p_signed ? m_signed_cache : m_unsigned_cache).dirty = true;
+	}
+	return true;
+}
+
+const LegacyTx::EncodingCache *LegacyTx::_get_encoding(bool p_signed) const {
+	if (!_sync_fields(p_signed)) {
+		return nullptr;
+	}
+
+	EncodingCache &cache = p_signed ? m_signed_cache : m_unsigned_cache;
+	if (!cache.dirty) {
+		return &cache;
 	}
 
-	ERR_FAIL_COND_V_MSG(eth_rlp_to_bytes(&rlp0_bytes, &rlp0_len, &rlp0) < 0, PackedByteArray(), "eth_rlp_to_bytes failed");
-	ERR_FAIL_COND_V_MSG(eth_rlp_free(&rlp0) < 0, PackedByteArray(), "eth_rlp_free failed");
+	// A fresh array, earlier encodings may still be referenced by scripts.
+	cache.encoded = p_signed ? SignedSchema::encode(m_fields, TX_TYPE_LEGACY) : SigningSchema::encode(m_fields, TX_TYPE_LEGACY);
+	cache.dirty = false;
+	cache.hashed = false;
+	cache.hex_valid = false;
+	return &cache;
+}
 
-	if (data_bytes != NULL) {
-		free(data_bytes);
-		data_bytes = NULL;
+const uint8_t *LegacyTx::_get_hash(bool p_signed) const {
+	const EncodingCache *cache = _get_encoding(p_signed);
+	if (cache == nullptr) {
+		return nullptr;
+	}
+	if (!cache->hashed) {
+		EncodingCache &writable = p_signed ? m_signed_cache : m_unsigned_cache;
+		eth_keccak256(writable.hash, writable.encoded.ptr(), writable.encoded.size());
+		writable.hashed = true;
 	}
+	return cache->hash;
+}
 
-	// compute the keccak hash of the rlp encoded transaction
-	uint8_t hash[32];
-	eth_keccak256(hash, rlp0_bytes, rlp0_len);
-	if (rlp0_bytes != NULL) {
-	    free(rlp0_bytes);
-		rlp0_bytes = NULL;
+PackedByteArray LegacyTx::rlp_hash() {
+	const uint8_t *hash = _get_hash(false);
+	if (hash == nullptr) {
+		return PackedByteArray();
 	}
 
 	PackedByteArray result;
 	result.resize(32);
 	memcpy(result.ptrw(), hash, 32);
-
 	return result;
 }
 
 PackedByteArray LegacyTx::rlp_encode() {
-	struct eth_rlp rlp0;
-	uint8_t *rlp0_bytes;
-	size_t rlp0_len;
-
-	// Get the rlp format of the transaction
-	ERR_FAIL_COND_V_MSG(eth_rlp_init(&rlp0, ETH_RLP_ENCODE) < 0, PackedByteArray(), "eth_rlp_init failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_array(&rlp0) < 0, PackedByteArray(), "eth_rlp_array failed");
-		// rlp format for nonce
-		// char* nonce = const_cast<char*>(this->get_nonce_hex().utf8().get_data());
-		CharString nonce_cstr = this->get_nonce_hex().utf8();
-		char* nonce = nonce_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &nonce, NULL) < 0, PackedByteArray(), "rlp format nonce failed");
-
-		// rlp format for gas price
-		CharString gas_price_cstr = m_gas_price->to_hex().utf8();
-		char *gas_price = gas_price_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_price, NULL) < 0, PackedByteArray(), "rlp format gas price failed");
-
-		// rlp format for gas limit
-		CharString gas_limit_cstr = uint64_to_hex_string(this->m_gas_limit).utf8();
-		char *gas_limit = gas_limit_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_limit, NULL) < 0, PackedByteArray(), "rlp format gas limit failed");
-
-		// rlp format for to address
-		print_line("rlp_hash format to address start.");
-		CharString to_cstr = m_to.utf8();
-		char *to = to_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_address(&rlp0, &to) < 0, PackedByteArray(), "rlp format to address failed");
-		print_line("rlp_hash format to address done.");
-
-		// rlp format for value
-		CharString value_cstr = m_value->to_hex().utf8();
-		char *value = value_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &value, NULL) < 0, PackedByteArray(), "rlp format value failed");
-
-		// rlp format for data
-		uint8_t *data_bytes = new uint8_t[m_data.size()];
-		memcpy(data_bytes, m_data.ptr(), m_data.size());
-		size_t data_len = m_data.size();
-		ERR_FAIL_COND_V_MSG(eth_rlp_bytes(&rlp0, &data_bytes, &data_len) < 0, PackedByteArray(), "rlp foramt data bytes failed");
-
-		// rlp format for chain id(v)
-		ERR_FAIL_COND_V_MSG(m_chain_id->is_zero(), PackedByteArray(), "rlp format failed: chain id should not be zero");
-		CharString chain_id_cstr = m_chain_id->to_hex().utf8();
-		char *chain_id = chain_id_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &chain_id, NULL) < 0, PackedByteArray(), "rlp format chain id failed");
-
-		// rlp format for r,s
-		uint8_t zero=0;
-		if (m_r.is_null() || m_r->is_zero()) {
-			ERR_FAIL_COND_V_MSG(eth_rlp_uint8(&rlp0, &zero) < 0, PackedByteArray(), "rlp format r(zero) failed");
-		} else {
-			CharString r_cstr = m_r->to_hex().utf8();
-			char *r = r_cstr.ptrw();
-			ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &r, NULL) < 0, PackedByteArray(), "rlp format r failed");
-		}
-
-		if (m_r.is_null() || m_s->is_zero()) {
-			ERR_FAIL_COND_V_MSG(eth_rlp_uint8(&rlp0, &zero) < 0, PackedByteArray(), "rlp format s(zero) failed");
-		} else {
-			CharString s_cstr = m_s->to_hex().utf8();
-			char *s = s_cstr.ptrw();
-			ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &s, NULL) < 0, PackedByteArray(), "rlp format s failed");
-		}
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_array_end(&rlp0) < 0, PackedByteArray(), "eth_rlp_array failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_to_bytes(&rlp0_bytes, &rlp0_len, &rlp0) < 0, PackedByteArray(), "eth_rlp_to_bytes failed");
-	ERR_FAIL_COND_V_MSG(eth_rlp_free(&rlp0) < 0, PackedByteArray(), "eth_rlp_free failed");
-
-	PackedByteArray rlp_encode_bytes;
-	rlp_encode_bytes.resize(rlp0_len);
-	memcpy(rlp_encode_bytes.ptrw(), rlp0_bytes, rlp0_len);
-
-	free(rlp0_bytes);
-	return rlp_encode_bytes;
+	const EncodingCache *cache = _get_encoding(false);
+	return cache != nullptr ? cache->encoded : PackedByteArray();
 }
 
 String LegacyTx::get_nonce_hex() const {
-    return uint64_to_hex_string(this->m_nonce);
+    return uint64_to_hex_string(this->m_fields.nonce);
 }
 
-int LegacyTx::sign_tx(Ref<Secp256k1Wrapper> signer) {
-	// FIXME: does it need to check the signer is valid?
-	// FIXME: does it need to check the LegacyTx data is valid?
-	PackedByteArray rlp_hash = this->rlp_hash();
-	PackedByteArray signature = signer->sign(rlp_hash);
-
+int LegacyTx::_apply_signature(const PackedByteArray &signature) {
 	if (signature.size() != 65) {
 		return -1;
 	}
 
-	uint8_t _signature[65];
-	memcpy(_signature, signature.ptr(), 65);
-
-	// Get the r, s, and v values from the signature and caculate v
-	uint8_t r[32];
-	uint8_t s[32];
-	memcpy(r, _signature, 32);
-	memcpy(s, _signature + 32, 32);
-
-	int v_value = signature[64] + 35 + 2 * this->get_chain_id()->to_int();
-	String v_value_str = String::num(v_value);
-
-	// Set the r, s, and v values
+	// Get the r, s, and v values from the signature and caculate v = recid + 35 + 2 * chainId
 	Ref<BigInt> r_bigint = Ref<BigInt>(memnew(BigInt));
 	Ref<BigInt> s_bigint = Ref<BigInt>(memnew(BigInt));
 	Ref<BigInt> v_bigint = Ref<BigInt>(memnew(BigInt));
-	r_bigint->set_bytes(r, 32);
-	s_bigint->set_bytes(s, 32);
-	v_bigint->from_string(v_value_str);
+	r_bigint->set_bytes(const_cast<uint8_t *>(signature.ptr()), 32);
+	s_bigint->set_bytes(const_cast<uint8_t *>(signature.ptr()) + 32, 32);
+	mpz_mul_ui(v_bigint->m_number, this->m_chain_id->m_number, 2);
+	mpz_add_ui(v_bigint->m_number, v_bigint->m_number, signature[64] + 35);
 
+	// Set the r, s, and v values
 	this->set_sign_r(r_bigint);
 	this->set_sign_s(s_bigint);
 	this->set_sign_v(v_bigint);
 	return 0;
 }
 
-int LegacyTx::sign_tx_by_account(Ref<EthAccount> signer) {
-	// FIXME: does it need to check the signer is valid?
-	// FIXME: does it need to check the LegacyTx data is valid?
-	PackedByteArray rlp_encode_data = this->rlp_encode();
-	PackedByteArray signature = signer->sign_data(rlp_encode_data);
-	if (signature.size() != 65) {
+int LegacyTx::sign_tx(Ref<Secp256k1Wrapper> signer) {
+	ERR_FAIL_COND_V(signer.is_null(), -1);
+	PackedByteArray rlp_hash = this->rlp_hash();
+	if (rlp_hash.size() != 32) {
 		return -1;
 	}
-
-	uint8_t _signature[65];
-	memcpy(_signature, signature.ptr(), 65);
-
-	// Get the r, s, and v values from the signature and caculate v
-	uint8_t r[32];
-	uint8_t s[32];
-	memcpy(r, _signature, 32);
-	memcpy(s, _signature + 32, 32);
-
-	int v_value = signature[64] + 35 + 2 * this->get_chain_id()->to_int();
-	String v_value_str = String::num(v_value);
-
-	// Set the r, s, and v values
-	Ref<BigInt> r_bigint = Ref<BigInt>(memnew(BigInt));
-	Ref<BigInt> s_bigint = Ref<BigInt>(memnew(BigInt));
-	Ref<BigInt> v_bigint = Ref<BigInt>(memnew(BigInt));
-	r_bigint->set_bytes(r, 32);
-	s_bigint->set_bytes(s, 32);
-	v_bigint->from_string(v_value_str);
-
-	this->set_sign_r(r_bigint);
-	this->set_sign_s(s_bigint);
-	this->set_sign_v(v_bigint);
-	return 0;
+	return _apply_signature(signer->sign(rlp_hash));
 }
 
+int LegacyTx::sign_tx_by_account(Ref<EthAccount> signer) {
+	ERR_FAIL_COND_V(signer.is_null(), -1);
+	const uint8_t *hash = _get_hash(false);
+	if (hash == nullptr) {
+		return -1;
+	}
+	uint8_t signature[65];
+	if (!signer->sign_hash32(hash, signature)) {
+		return -1;
+	}
+	PackedByteArray signature_bytes;
+	signature_bytes.resize(65);
+	memcpy(signature_bytes.ptrw(), signature, 65);
+	return _apply_signature(signature_bytes);
+}
 
 String LegacyTx::signedtx_marshal_binary() {
-	struct eth_rlp rlp0;
-
-	// Get the rlp format of the transaction
-	ERR_FAIL_COND_V_MSG(eth_rlp_init(&rlp0, ETH_RLP_ENCODE) < 0, String(), "eth_rlp_init failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_array(&rlp0) < 0, String(), "eth_rlp_array failed");
-		// rlp format for nonce
-		CharString nonce_cstr = this->get_nonce_hex().utf8();
-		char* nonce = nonce_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &nonce, NULL) < 0, String(), "rlp format nonce failed");
-
-		// rlp format for gas price
-		CharString gas_price_cstr = m_gas_price->to_hex().utf8();
-		char *gas_price = gas_price_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_price, NULL) < 0, String(), "rlp format gas price failed");
-
-		// rlp format for gas limit
-		CharString gas_limit_cstr = uint64_to_hex_string(this->m_gas_limit).utf8();
-		char *gas_limit = gas_limit_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_limit, NULL) < 0, String(), "rlp format gas limit failed");
-
-		// rlp format for to address
-		print_line("rlp_hash format to address start.");
-		CharString to_cstr = m_to.utf8();
-		char *to = to_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_address(&rlp0, &to) < 0, String(), "rlp format to address failed");
-		print_line("rlp_hash format to address done.");
-
-		// rlp format for value
-		CharString value_cstr = m_value->to_hex().utf8();
-		char *value = value_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &value, NULL) < 0, String(), "rlp format value failed");
-
-		// rlp format for data
-		uint8_t *data_bytes = new uint8_t[m_data.size()];
-		memcpy(data_bytes, m_data.ptr(), m_data.size());
-		size_t data_len = m_data.size();
-		ERR_FAIL_COND_V_MSG(eth_rlp_bytes(&rlp0, &data_bytes, &data_len) < 0, String(), "rlp foramt data bytes failed");
-
-		// rlp format for v
-		ERR_FAIL_COND_V_MSG(m_v->is_zero(), String(), "rlp format failed: chain id should not be zero");
-		CharString v_cstr = m_v->to_hex().utf8();
-		char *v = v_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &v, NULL) < 0, String(), "rlp format chain id failed");
-
-		// rlp format for r
-		ERR_FAIL_COND_V_MSG(m_r.is_null(), String(), "rlp format failed: r is zero");
-		CharString r_cstr = m_r->to_hex().utf8();
-		char *r = r_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &r, NULL) < 0, String(), "rlp format r failed");
-
-		// rlp format for s
-		ERR_FAIL_COND_V_MSG(m_s.is_null(), String(), "rlp format failed: r is zero");
-		CharString s_cstr = m_s->to_hex().utf8();
-		char *s = s_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &s, NULL) < 0, String(), "rlp format s failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_array_end(&rlp0) < 0, String(), "eth_rlp_array failed");
-
-	char *txn;
-	ERR_FAIL_COND_V_MSG(eth_rlp_to_hex(&txn, &rlp0) < 0, String(), "eth_rlp_to_hex failed");
-	ERR_FAIL_COND_V_MSG(eth_rlp_free(&rlp0) < 0, String(), "eth_rlp_free failed");
-
-	String res = String(txn);
-	free(txn);
-	return "0x" + res;
+	const EncodingCache *cache = _get_encoding(true);
+	if (cache == nullptr) {
+		return String();
+	}
+	if (!cache->hex_valid) {
+		m_signed_cache.hex = "0x" + String::hex_encode_buffer(cache->encoded.ptr(), cache->encoded.size());
+		m_signed_cache.hex_valid = true;
+	}
+	return cache->hex;
 }
 
 PackedByteArray LegacyTx::hash() {
-	struct eth_rlp rlp0;
-	uint8_t *rlp0_bytes;
-	size_t rlp0_len;
-
-	// Get the rlp format of the transaction
-	ERR_FAIL_COND_V_MSG(eth_rlp_init(&rlp0, ETH_RLP_ENCODE) < 0, PackedByteArray(), "eth_rlp_init failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_array(&rlp0) < 0, PackedByteArray(), "eth_rlp_array failed");
-		// rlp format for nonce
-		CharString nonce_cstr = this->get_nonce_hex().utf8();
-		char* nonce = nonce_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &nonce, NULL) < 0, PackedByteArray(), "rlp format nonce failed");
-
-		// rlp format for gas price
-		CharString gas_price_cstr = m_gas_price->to_hex().utf8();
-		char *gas_price = gas_price_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_price, NULL) < 0, PackedByteArray(), "rlp format gas price failed");
-
-		// rlp format for gas limit
-		CharString gas_limit_cstr = uint64_to_hex_string(this->m_gas_limit).utf8();
-		char *gas_limit = gas_limit_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &gas_limit, NULL) < 0, PackedByteArray(), "rlp format gas limit failed");
-
-		// rlp format for to address
-		print_line("rlp_hash format to address start.");
-		CharString to_cstr = m_to.utf8();
-		char *to = to_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_address(&rlp0, &to) < 0, PackedByteArray(), "rlp format to address failed");
-		print_line("rlp_hash format to address done.");
-
-		// rlp format for value
-		CharString value_cstr = m_value->to_hex().utf8();
-		char *value = value_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &value, NULL) < 0, PackedByteArray(), "rlp format value failed");
-
-		// rlp format for data
-		uint8_t *data_bytes = new uint8_t[m_data.size()];
-		memcpy(data_bytes, m_data.ptr(), m_data.size());
-		size_t data_len = m_data.size();
-		ERR_FAIL_COND_V_MSG(eth_rlp_bytes(&rlp0, &data_bytes, &data_len) < 0, PackedByteArray(), "rlp foramt data bytes failed");
-
-		// rlp format for v
-		ERR_FAIL_COND_V_MSG(m_v->is_zero(), PackedByteArray(), "rlp format failed: chain id should not be zero");
-		CharString v_cstr = m_v->to_hex().utf8();
-		char *v = v_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &v, NULL) < 0, PackedByteArray(), "rlp format chain id failed");
-
-		// rlp format for r
-		ERR_FAIL_COND_V_MSG(m_r.is_null(), PackedByteArray(), "rlp format failed: r is zero");
-		CharString r_cstr = m_r->to_hex().utf8();
-		char *r = r_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &r, NULL) < 0, PackedByteArray(), "rlp format r failed");
-
-		// rlp format for s
-		ERR_FAIL_COND_V_MSG(m_s.is_null(), PackedByteArray(), "rlp format failed: r is zero");
-		CharString s_cstr = m_s->to_hex().utf8();
-		char *s = s_cstr.ptrw();
-		ERR_FAIL_COND_V_MSG(eth_rlp_hex(&rlp0, &s, NULL) < 0, PackedByteArray(), "rlp format s failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_array_end(&rlp0) < 0, PackedByteArray(), "eth_rlp_array failed");
-
-	ERR_FAIL_COND_V_MSG(eth_rlp_to_bytes(&rlp0_bytes, &rlp0_len, &rlp0) < 0, PackedByteArray(), "eth_rlp_to_bytes failed");
-	ERR_FAIL_COND_V_MSG(eth_rlp_free(&rlp0) < 0, PackedByteArray(), "eth_rlp_free failed");
-
-	// compute the keccak hash of the rlp encoded transaction
-	uint8_t hash[32];
-	eth_keccak256(hash, rlp0_bytes, rlp0_len);
-    free(rlp0_bytes);
+	const uint8_t *hash = _get_hash(true);
+	if (hash == nullptr) {
+		return PackedByteArray();
+	}
 
 	PackedByteArray result;
 	result.resize(32);
@@ -512,6 +306,47 @@ PackedByteArray LegacyTx::hash() {
 	return result;
 }
 
+static Ref<BigInt> _u256_to_big_int(const u256 &value) {
+	Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+	u256_to_mpz(number->m_number, value);
+	return number;
+}
+
+Ref<LegacyTx> LegacyTx::from_raw(const PackedByteArray &raw) {
+	TransactionDecoder::RawTx tx;
+	ERR_FAIL_COND_V_MSG(!TransactionDecoder::parse(raw.ptr(), raw.size(), tx), Ref<LegacyTx>(), "Invalid raw transaction");
+	ERR_FAIL_COND_V_MSG(tx.type != TransactionDecoder::TYPE_LEGACY, Ref<LegacyTx>(), "Typed transaction, use AccessListTx.from_raw, DynamicFeeTx.from_raw or TransactionDecoder.decode");
+
+	Ref<LegacyTx> result = Ref<LegacyTx>(memnew(LegacyTx));
+	Fields &fields = result->m_fields;
+	ERR_FAIL_COND_V_MSG(!SignedSchema::read(tx.fields, tx.field_count, fields), Ref<LegacyTx>(), "Invalid transaction fields");
+
+	if (fields.to.present) {
+		result->m_to = TransactionDecoder::address_to_hex(fields.to.bytes);
+	}
+	result->m_gas_price = _u256_to_big_int(fields.gas_price);
+	result->m_value = _u256_to_big_int(fields.value);
+	result->m_v = _u256_to_big_int(fields.v);
+	result->m_r = _u256_to_big_int(fields.r);
+	result->m_s = _u256_to_big_int(fields.s);
+
+	// EIP-155: v = chain_id * 2 + 35 + recid, older signatures carry no chain id.
+	u256 chain_id;
+	if (!u256_sub(chain_id, fields.v, u256_from_u64(35))) {
+		u256_shr(chain_id, chain_id, 1);
+		result->m_chain_id = _u256_to_big_int(chain_id);
+	}
+	return result;
+}
+
+String LegacyTx::recover_sender() const {
+	const EncodingCache *cache = _get_encoding(true);
+	ERR_FAIL_NULL_V(cache, String());
+	uint8_t address[20];
+	ERR_FAIL_COND_V_MSG(!TransactionDecoder::recover_address(nullptr, cache->encoded.ptr(), cache->encoded.size(), address), String(), "Failed to recover sender");
+	return TransactionDecoder::address_to_hex(address);
+}
+
 void LegacyTx::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_chain_id", "chain_id"), &LegacyTx::set_chain_id);
 	ClassDB::bind_method(D_METHOD("get_chain_id"), &LegacyTx::get_chain_id);
@@ -549,5 +384,7 @@ void LegacyTx::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("sign_tx", "signer"), &LegacyTx::sign_tx);
 	ClassDB::bind_method(D_METHOD("sign_tx_by_account", "signer"), &LegacyTx::sign_tx_by_account);
 	ClassDB::bind_method(D_METHOD("signedtx_marshal_binary"), &LegacyTx::signedtx_marshal_binary);
+	ClassDB::bind_method(D_METHOD("recover_sender"), &LegacyTx::recover_sender);
+	ClassDB::bind_static_method("LegacyTx", D_METHOD("from_raw", "raw"), &LegacyTx::from_raw);
 }
 
@@ -11,32 +11,92 @@
 #include "core/variant/variant.h"
 
 #include "big_int.h"
-#include "rlp.h"
-#include "keccak256.h"
+#include "tx_schema.h"
 #include "secp256k1_wrapper.h"
 #include "eth_account_wrapper.h"
+#include "transaction_decoder.h"
+#include "u256_math.h"
 
 
 class LegacyTx : public RefCounted {
 	GDCLASS(LegacyTx, RefCounted);
 
+	friend class BatchSigner;
+	friend class TxBatch;
+
+public:
+	// Values as written to RLP, the BigInt fields are mirrored here when encoding.
+	struct Fields {
+		uint64_t nonce = 0;
+		u256 gas_price = {};
+		uint64_t gas_limit = 0;
+		TxAddress to;
+		u256 value = {};
+		PackedByteArray data;
+		u256 chain_id = {};
+		u256 v = {};
+		u256 r = {};
+		u256 s = {};
+	};
+
+	typedef RlpSchema<
+			RlpField<&Fields::nonce>,
+			RlpField<&Fields::gas_price>,
+			RlpField<&Fields::gas_limit>,
+			RlpField<&Fields::to>,
+			RlpField<&Fields::value>,
+			RlpField<&Fields::data>>
+			BaseSchema;
+	// EIP-155 signing payload: chain id, 0, 0 in place of v, r, s.
+	typedef BaseSchema::Append<RlpField<&Fields::chain_id>, RlpEmptyField, RlpEmptyField> SigningSchema;
+	typedef BaseSchema::Append<RlpField<&Fields::v>, RlpField<&Fields::r>, RlpField<&Fields::s>> SignedSchema;
+
+private:
 	// chain information
 	Ref<BigInt> m_chain_id;
 
-	// transaction information
-	uint64_t m_nonce; // nonce of sender account
+	// transaction information, nonce, gas limit, to and data live in m_fields
 	Ref<BigInt> m_gas_price; // wei per gas
-	uint64_t m_gas_limit; // gas limit
-	String m_to; // null means contract creation
-	// To       *common.Address `rlp:"nil"`
+	String m_to; // empty means contract creation
 	Ref<BigInt> m_value; // wei amount
-	PackedByteArray m_data; // contract invocation input data
 
 	// signature values
 	Ref<BigInt> m_v;
 	Ref<BigInt> m_r;
 	Ref<BigInt> m_s;
 
+	mutable Fields m_fields;
+
+	// BigInts last mirrored into m_fields, a different object or value marks
+	// the encodings using it dirty (this catches in-place arithmetic too).
+	mutable const BigInt *m_gas_price_source = nullptr;
+	mutable const BigInt *m_value_source = nullptr;
+	mutable const BigInt *m_chain_id_source = nullptr;
+	mutable const BigInt *m_v_source = nullptr;
+	mutable const BigInt *m_r_source = nullptr;
+	mutable const BigInt *m_s_source = nullptr;
+
+	// An encoding and its keccak, rebuilt only after a field it covers changed.
+	struct EncodingCache {
+		PackedByteArray encoded;
+		uint8_t hash[32];
+		String hex;
+		bool dirty = true;
+		bool hashed = false;
+		bool hex_valid = false;
+	};
+
+	// EIP-155 signing payload and signed transaction.
+	mutable EncodingCache m_unsigned_cache;
+	mutable EncodingCache m_signed_cache;
+
+	void _invalidate(bool p_unsigned, bool p_signed);
+	bool _sync_uint(const Ref<BigInt> &p_number, const BigInt *&r_source, u256 &r_value, bool &r_changed) const;
+	bool _sync_fields(bool p_signed) const;
+	const EncodingCache *_get_encoding(bool p_signed) const;
+	const uint8_t *_get_hash(bool p_signed) const;
+	int _apply_signature(const PackedByteArray &signature);
+
 protected:
 	static void _bind_methods();
 
@@ -81,6 +141,19 @@ public:
 	int sign_tx_by_account(Ref<EthAccount> signer);
 	String signedtx_marshal_binary();
 	String get_nonce_hex() const;
+
+	/**
+	 * @brief  Decodes a signed legacy transaction, typed envelopes are
+	 *         rejected (use TransactionDecoder.decode for those).
+	 * @return The transaction, null on error.
+	 */
+	static Ref<LegacyTx> from_raw(const PackedByteArray &raw);
+
+	/**
+	 * @brief  Recovers the address that signed the transaction.
+	 * @return 0x-prefixed address, empty on error.
+	 */
+	String recover_sender() const;
 };
 
 #endif // LEGACY_TX_H
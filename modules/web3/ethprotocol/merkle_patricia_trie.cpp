@@ -0,0 +1,534 @@
+#include "merkle_patricia_trie.h"
+
+#include "big_int.h"
+#include "keccak256.h"
+#include "rlp_writer.h"
+#include "transaction_decoder.h"
+#include "u256.h"
+#include "u256_math.h"
+
+const uint8_t MerklePatriciaTrie::EMPTY_ROOT[32] = {
+	0x56, 0xe8, 0x1f, 0x17, 0x1b, 0xcc, 0x55, 0xa6, 0xff, 0x83, 0x45, 0xe6, 0x92, 0xc0, 0xf8, 0x6e,
+	0x5b, 0x48, 0xe0, 0x1b, 0x99, 0x6c, 0xad, 0xc0, 0x01, 0x62, 0x2f, 0xb5, 0xe3, 0x63, 0xb4, 0x21
+};
+
+const uint8_t MerklePatriciaTrie::EMPTY_CODE_HASH[32] = {
+	0xc5, 0xd2, 0x46, 0x01, 0x86, 0xf7, 0x23, 0x3c, 0x92, 0x7e, 0x7d, 0xb2, 0xdc, 0xc7, 0x03, 0xc0,
+	0xe5, 0x00, 0xb6, 0x53, 0xca, 0x82, 0x27, 0x3b, 0x7b, 0xfa, 0xd8, 0x04, 0x5d, 0x85, 0xa4, 0x70
+};
+
+static inline uint8_t _nibble(const uint8_t *p_key, uint32_t p_index) {
+	uint8_t byte = p_key[p_index >> 1];
+	return (p_index & 1) ? (byte & 0x0f) : (byte >> 4);
+}
+
+// Hex-prefix encoding of the path, see the yellow paper appendix C.
+// Returns the number of nibbles, -1 if the encoding is invalid.
+static int _decode_path(const eth_rlp_item &p_item, bool &r_leaf, const uint8_t *&r_bytes, bool &r_odd) {
+	if (p_item.is_list || p_item.len == 0) {
+		return -1;
+	}
+	uint8_t flag = p_item.payload[0] >> 4;
+	if (flag > 3 || (!(flag & 1) && (p_item.payload[0] & 0x0f) != 0)) {
+		return -1;
+	}
+	r_leaf = flag >= 2;
+	r_odd = flag & 1;
+	r_bytes = p_item.payload;
+	return (int)(p_item.len - 1) * 2 + (r_odd ? 1 : 0);
+}
+
+// Nibble i of a decoded path.
+static inline uint8_t _path_nibble(const uint8_t *p_bytes, bool p_odd, int p_index) {
+	// Odd paths start in the low nibble of the flag byte, even ones after it.
+	return _nibble(p_bytes, p_index + (p_odd ? 1 : 2));
+}
+
+bool MerklePatriciaTrie::verify(const uint8_t *p_root, const uint8_t *p_key, size_t p_key_len, const PackedByteArray *p_nodes, int p_node_count, PackedByteArray &r_value) {
+	r_value.clear();
+	if (memcmp(p_root, EMPTY_ROOT, 32) == 0) {
+		return true;
+	}
+
+	LocalVector<uint8_t> hashes;
+	hashes.resize(p_node_count * 32);
+	for (int i = 0; i < p_node_count; i++) {
+		eth_keccak256(hashes.ptr() + i * 32, p_nodes[i].ptr(), p_nodes[i].size());
+	}
+
+	const uint32_t key_nibbles = p_key_len * 2;
+	uint32_t pos = 0;
+	const uint8_t *hash = p_root;
+	eth_rlp_item node;
+	eth_rlp_item child;
+	eth_rlp_item items[17];
+
+	// Every step consumes at least one nibble, plus the final value lookup.
+	for (uint32_t step = 0; step <= key_nibbles; step++) {
+		if (hash != nullptr) {
+			int found = -1;
+			for (int i = 0; i < p_node_count && found < 0; i++) {
+				if (memcmp(hashes.ptr() + i * 32, hash, 32) == 0) {
+					found = i;
+				}
+			}
+			if (found < 0 || eth_rlp_read_exact(&node, p_nodes[found].ptr(), p_nodes[found].size()) <= 0) {
+				return false;
+			}
+		}
+		if (!node.is_list) {
+			return false;
+		}
+
+		int count = eth_rlp_read_list(items, 17, &node);
+		if (count == 17) {
+			if (pos == key_nibbles) {
+				child = items[16];
+				if (child.is_list) {
+					return false;
+				}
+				r_value.resize(child.len);
+				if (child.len > 0) {
+					memcpy(r_value.ptrw(), child.payload, child.len);
+				}
+				return true;
+			}
+			child = items[_nibble(p_key, pos++)];
+			if (!child.is_list && child.len == 0) {
+				return true; // empty slot, the key is absent
+			}
+		} else if (count == 2) {
+			bool leaf, odd;
+			const uint8_t *path;
+			int path_nibbles = _decode_path(items[0], leaf, path, odd);
+			if (path_nibbles < 0 || (!leaf && path_nibbles == 0)) {
+				return false;
+			}
+			bool matches = pos + path_nibbles <= key_nibbles && (!leaf || pos + path_nibbles == key_nibbles);
+			for (int i = 0; i < path_nibbles && matches; i++) {
+				matches = _path_nibble(path, odd, i) == _nibble(p_key, pos + i);
+			}
+			if (!matches) {
+				return true; // the path diverges, the key is absent
+			}
+			pos += path_nibbles;
+			child = items[1];
+			if (leaf) {
+				if (child.is_list) {
+					return false;
+				}
+				r_value.resize(child.len);
+				if (child.len > 0) {
+					memcpy(r_value.ptrw(), child.payload, child.len);
+				}
+				return true;
+			}
+		} else {
+			return false;
+		}
+
+		// Nodes shorter than 32 bytes are embedded in their parent.
+		if (child.is_list) {
+			if (child.raw_len >= 32) {
+				return false;
+			}
+			node = child;
+			hash = nullptr;
+		} else if (child.len == 32) {
+			hash = child.payload;
+		} else {
+			return false;
+		}
+	}
+	return false;
+}
+
+struct MptEntryCompare {
+	_FORCE_INLINE_ bool operator()(const MerklePatriciaTrie::Entry &p_a, const MerklePatriciaTrie::Entry &p_b) const {
+		uint32_t len = MIN(p_a.key_len, p_b.key_len);
+		int cmp = len > 0 ? memcmp(p_a.key, p_b.key, len) : 0;
+		return cmp < 0 || (cmp == 0 && p_a.key_len < p_b.key_len);
+	}
+};
+
+static void _append(LocalVector<uint8_t> &r_out, const uint8_t *p_bytes, size_t p_len) {
+	uint32_t offset = r_out.size();
+	r_out.resize(offset + p_len);
+	if (p_len > 0) {
+		memcpy(r_out.ptr() + offset, p_bytes, p_len);
+	}
+}
+
+static void _append_rlp_bytes(LocalVector<uint8_t> &r_out, const uint8_t *p_bytes, size_t p_len) {
+	uint32_t offset = r_out.size();
+	r_out.resize(offset + eth_rlp_sizeof_bytes(p_bytes, p_len));
+	eth_rlp_put_bytes(r_out.ptr() + offset, p_bytes, p_len);
+}
+
+// Appends the reference to an encoded node: the node itself if shorter than
+// 32 bytes, its hash otherwise.
+static void _append_ref(LocalVector<uint8_t> &r_out, const LocalVector<uint8_t> &p_node) {
+	if (p_node.size() < 32) {
+		_append(r_out, p_node.ptr(), p_node.size());
+		return;
+	}
+	uint8_t hash[32];
+	eth_keccak256(hash, p_node.ptr(), p_node.size());
+	_append_rlp_bytes(r_out, hash, 32);
+}
+
+// Appends the hex-prefix encoded nibbles [p_from, p_to) of a key.
+static void _append_path(LocalVector<uint8_t> &r_out, const uint8_t *p_key, uint32_t p_from, uint32_t p_to, bool p_leaf) {
+	uint8_t path[33];
+	uint32_t count = p_to - p_from;
+	bool odd = count & 1;
+	path[0] = (uint8_t)(((p_leaf ? 2 : 0) + (odd ? 1 : 0)) << 4);
+	uint32_t i = p_from;
+	if (odd) {
+		path[0] |= _nibble(p_key, i++);
+	}
+	uint32_t len = 1;
+	for (; i < p_to; i += 2) {
+		path[len++] = (uint8_t)((_nibble(p_key, i) << 4) | _nibble(p_key, i + 1));
+	}
+	_append_rlp_bytes(r_out, path, len);
+}
+
+static void _wrap_list(LocalVector<uint8_t> &r_node, const LocalVector<uint8_t> &p_payload) {
+	r_node.resize(eth_rlp_sizeof_list(p_payload.size()));
+	uint8_t *out = eth_rlp_put_list(r_node.ptr(), p_payload.size());
+	if (p_payload.size() > 0) {
+		memcpy(out, p_payload.ptr(), p_payload.size());
+	}
+}
+
+// Encodes the node holding p_entries (sorted, sharing their first p_depth
+// nibbles). Keys are at most 32 bytes, the recursion is at most 64 deep.
+static void _encode_node(const MerklePatriciaTrie::Entry *p_entries, uint32_t p_count, uint32_t p_depth, LocalVector<uint8_t> &r_node) {
+	LocalVector<uint8_t> payload;
+	LocalVector<uint8_t> child;
+	const MerklePatriciaTrie::Entry &first = p_entries[0];
+
+	if (p_count == 1) {
+		_append_path(payload, first.key, p_depth, first.key_len * 2, true);
+		_append_rlp_bytes(payload, first.value, first.value_len);
+		_wrap_list(r_node, payload);
+		return;
+	}
+
+	// Sorted, so the prefix shared by the first and last keys is shared by all.
+	const MerklePatriciaTrie::Entry &last = p_entries[p_count - 1];
+	uint32_t end = MIN(first.key_len, last.key_len) * 2;
+	uint32_t common = p_depth;
+	while (common < end && _nibble(first.key, common) == _nibble(last.key, common)) {
+		common++;
+	}
+	if (common > p_depth) {
+		_encode_node(p_entries, p_count, common, child);
+		_append_path(payload, first.key, p_depth, common, false);
+		_append_ref(payload, child);
+		_wrap_list(r_node, payload);
+		return;
+	}
+
+	// Branch. A key ending here sorts first and becomes the branch value.
+	uint32_t i = 0;
+	const MerklePatriciaTrie::Entry *value = nullptr;
+	if (first.key_len * 2 == p_depth) {
+		value = &first;
+		i = 1;
+	}
+	for (uint8_t slot = 0; slot < 16; slot++) {
+		uint32_t start = i;
+		while (i < p_count && _nibble(p_entries[i].key, p_depth) == slot) {
+			i++;
+		}
+		if (i == start) {
+			payload.push_back(0x80);
+			continue;
+		}
+		_encode_node(p_entries + start, i - start, p_depth + 1, child);
+		_append_ref(payload, child);
+	}
+	if (value != nullptr) {
+		_append_rlp_bytes(payload, value->value, value->value_len);
+	} else {
+		payload.push_back(0x80);
+	}
+	_wrap_list(r_node, payload);
+}
+
+bool MerklePatriciaTrie::compute_root(LocalVector<Entry> &p_entries, uint8_t *r_root) {
+	// An empty value deletes the key.
+	for (uint32_t i = 0; i < p_entries.size();) {
+		if (p_entries[i].value_len == 0) {
+			p_entries.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+	if (p_entries.is_empty()) {
+		memcpy(r_root, EMPTY_ROOT, 32);
+		return true;
+	}
+
+	for (uint32_t i = 0; i < p_entries.size(); i++) {
+		ERR_FAIL_COND_V_MSG(p_entries[i].key_len > 32, false, "Trie keys are at most 32 bytes");
+	}
+	p_entries.sort_custom<MptEntryCompare>();
+	for (uint32_t i = 1; i < p_entries.size(); i++) {
+		const Entry &a = p_entries[i - 1];
+		const Entry &b = p_entries[i];
+		ERR_FAIL_COND_V_MSG(a.key_len == b.key_len && (a.key_len == 0 || memcmp(a.key, b.key, a.key_len) == 0), false, "Duplicate trie key");
+	}
+
+	LocalVector<uint8_t> root;
+	_encode_node(p_entries.ptr(), p_entries.size(), 0, root);
+	eth_keccak256(r_root, root.ptr(), root.size());
+	return true;
+}
+
+// Bytes of a PackedByteArray or of a hex string with or without 0x.
+static PackedByteArray _to_bytes(const Variant &p_value) {
+	if (p_value.get_type() == Variant::PACKED_BYTE_ARRAY) {
+		return p_value;
+	}
+	String hex = p_value;
+	if (hex.begins_with("0x") || hex.begins_with("0X")) {
+		hex = hex.substr(2);
+	}
+	return hex.hex_decode();
+}
+
+static bool _to_root(const Variant &p_value, uint8_t *r_root) {
+	PackedByteArray bytes = _to_bytes(p_value);
+	ERR_FAIL_COND_V_MSG(bytes.size() != 32, false, "root must be 32 bytes");
+	memcpy(r_root, bytes.ptr(), 32);
+	return true;
+}
+
+// Hex quantity ("0x1a") or big-endian bytes to u256.
+static bool _to_u256(const Variant &p_value, u256 &r_value) {
+	if (p_value.get_type() == Variant::PACKED_BYTE_ARRAY) {
+		PackedByteArray bytes = p_value;
+		return u256_from_be_bytes(r_value, bytes.ptr(), bytes.size());
+	}
+	CharString hex = String(p_value).utf8();
+	const char *str = hex.get_data();
+	size_t len = hex.length();
+	if (len >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+		str += 2;
+		len -= 2;
+	}
+	return len > 0 && u256_from_hex(r_value, str, len);
+}
+
+static Ref<BigInt> _to_big_int(const u256 &p_value) {
+	Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+	u256_to_mpz(number->m_number, p_value);
+	return number;
+}
+
+static bool _verify_array(const uint8_t *p_root, const uint8_t *p_key, size_t p_key_len, const Array &p_proof, PackedByteArray &r_value) {
+	LocalVector<PackedByteArray> nodes;
+	nodes.resize(p_proof.size());
+	for (int i = 0; i < p_proof.size(); i++) {
+		nodes[i] = _to_bytes(p_proof[i]);
+	}
+	return MerklePatriciaTrie::verify(p_root, p_key, p_key_len, nodes.ptr(), nodes.size(), r_value);
+}
+
+Dictionary MerklePatriciaTrie::verify_proof(const Variant &root, const PackedByteArray &key, const Array &proof) {
+	Dictionary result;
+	result["valid"] = false;
+	uint8_t root_hash[32];
+	if (!_to_root(root, root_hash)) {
+		return result;
+	}
+	PackedByteArray value;
+	result["valid"] = _verify_array(root_hash, key.ptr(), key.size(), proof, value);
+	result["value"] = value;
+	return result;
+}
+
+Dictionary MerklePatriciaTrie::verify_account_proof(const Variant &state_root, const String &address, const Array &proof) {
+	Dictionary result;
+	result["valid"] = false;
+	uint8_t root[32];
+	uint8_t address_bytes[20];
+	if (!_to_root(state_root, root)) {
+		return result;
+	}
+	ERR_FAIL_COND_V_MSG(!TransactionDecoder::parse_hex(address, address_bytes, 20), result, "Invalid address: " + address);
+
+	// The state trie is keyed by keccak256(address).
+	uint8_t key[32];
+	eth_keccak256(key, address_bytes, 20);
+	PackedByteArray value;
+	if (!_verify_array(root, key, 32, proof, value)) {
+		return result;
+	}
+
+	u256 nonce = {};
+	u256 balance = {};
+	const uint8_t *storage_hash = EMPTY_ROOT;
+	const uint8_t *code_hash = EMPTY_CODE_HASH;
+	if (!value.is_empty()) {
+		// rlp([nonce, balance, storageRoot, codeHash])
+		eth_rlp_item account, fields[4];
+		if (eth_rlp_read_exact(&account, value.ptr(), value.size()) <= 0 || eth_rlp_read_list(fields, 4, &account) != 4) {
+			return result;
+		}
+		if (eth_rlp_item_is_uint(&fields[0], 32) <= 0 || eth_rlp_item_is_uint(&fields[1], 32) <= 0 ||
+				fields[2].is_list || fields[2].len != 32 || fields[3].is_list || fields[3].len != 32) {
+			return result;
+		}
+		u256_from_be_bytes(nonce, fields[0].payload, fields[0].len);
+		u256_from_be_bytes(balance, fields[1].payload, fields[1].len);
+		// Nonces are capped at 2^64 - 1 (EIP-2681), a larger one would be truncated.
+		if (!u256_fits_u64(nonce)) {
+			return result;
+		}
+		storage_hash = fields[2].payload;
+		code_hash = fields[3].payload;
+	}
+
+	result["valid"] = true;
+	result["exists"] = !value.is_empty();
+	result["nonce"] = (int64_t)nonce.limbs[0];
+	result["balance"] = _to_big_int(balance);
+	result["storageHash"] = "0x" + String::hex_encode_buffer(storage_hash, 32);
+	result["codeHash"] = "0x" + String::hex_encode_buffer(code_hash, 32);
+	return result;
+}
+
+Dictionary MerklePatriciaTrie::verify_storage_proof(const Variant &storage_root, const Variant &slot, const Array &proof) {
+	Dictionary result;
+	result["valid"] = false;
+	uint8_t root[32];
+	u256 slot_value;
+	if (!_to_root(storage_root, root)) {
+		return result;
+	}
+	ERR_FAIL_COND_V_MSG(!_to_u256(slot, slot_value), result, "Invalid storage slot");
+
+	// Storage tries are keyed by keccak256(slot as 32 bytes).
+	uint8_t slot_bytes[32];
+	uint8_t key[32];
+	u256_to_be_bytes(slot_value, slot_bytes);
+	eth_keccak256(key, slot_bytes, 32);
+	PackedByteArray value;
+	if (!_verify_array(root, key, 32, proof, value)) {
+		return result;
+	}
+
+	// Values are stored as rlp(uint), absent slots are zero.
+	u256 number = {};
+	if (!value.is_empty()) {
+		eth_rlp_item item;
+		if (eth_rlp_read_exact(&item, value.ptr(), value.size()) <= 0 || eth_rlp_item_is_uint(&item, 32) <= 0) {
+			return result;
+		}
+		u256_from_be_bytes(number, item.payload, item.len);
+	}
+	result["valid"] = true;
+	result["value"] = _to_big_int(number);
+	return result;
+}
+
+bool MerklePatriciaTrie::verify_get_proof(const Variant &state_root, const Dictionary &response) {
+	Dictionary account = verify_account_proof(state_root, response.get("address", String()), response.get("accountProof", Array()));
+	if (!bool(account["valid"])) {
+		return false;
+	}
+
+	u256 nonce, balance, expected;
+	Ref<BigInt> proven_balance = account["balance"];
+	if (!_to_u256(response.get("nonce", "0x0"), nonce) || !_to_u256(response.get("balance", "0x0"), balance) ||
+			!u256_from_mpz(expected, proven_balance->m_number)) {
+		return false;
+	}
+	if (!u256_fits_u64(nonce) || nonce.limbs[0] != (uint64_t)(int64_t)account["nonce"] || u256_cmp(balance, expected) != 0) {
+		return false;
+	}
+	if (String(response.get("storageHash", "")).to_lower() != String(account["storageHash"]) ||
+			String(response.get("codeHash", "")).to_lower() != String(account["codeHash"])) {
+		return false;
+	}
+
+	Array storage_proofs = response.get("storageProof", Array());
+	for (int i = 0; i < storage_proofs.size(); i++) {
+		Dictionary entry = storage_proofs[i];
+		Dictionary storage = verify_storage_proof(account["storageHash"], entry.get("key", ""), entry.get("proof", Array()));
+		if (!bool(storage["valid"])) {
+			return false;
+		}
+		u256 value;
+		Ref<BigInt> proven_value = storage["value"];
+		if (!_to_u256(entry.get("value", "0x0"), value) || !u256_from_mpz(expected, proven_value->m_number) || u256_cmp(value, expected) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+PackedByteArray MerklePatriciaTrie::trie_root(const Array &keys, const Array &values) {
+	ERR_FAIL_COND_V_MSG(keys.size() != values.size(), PackedByteArray(), "keys and values must have the same size");
+	int count = keys.size();
+	LocalVector<PackedByteArray> key_bytes;
+	LocalVector<PackedByteArray> value_bytes;
+	LocalVector<Entry> entries;
+	key_bytes.resize(count);
+	value_bytes.resize(count);
+	entries.resize(count);
+	for (int i = 0; i < count; i++) {
+		key_bytes[i] = _to_bytes(keys[i]);
+		value_bytes[i] = _to_bytes(values[i]);
+		entries[i].key = key_bytes[i].ptr();
+		entries[i].key_len = key_bytes[i].size();
+		entries[i].value = value_bytes[i].ptr();
+		entries[i].value_len = value_bytes[i].size();
+	}
+
+	PackedByteArray root;
+	root.resize(32);
+	if (!compute_root(entries, root.ptrw())) {
+		return PackedByteArray();
+	}
+	return root;
+}
+
+PackedByteArray MerklePatriciaTrie::ordered_trie_root(const Array &values) {
+	int count = values.size();
+	// rlp(i) takes at most 9 bytes.
+	LocalVector<uint8_t> key_bytes;
+	LocalVector<PackedByteArray> value_bytes;
+	LocalVector<Entry> entries;
+	key_bytes.resize(count * 9);
+	value_bytes.resize(count);
+	entries.resize(count);
+	for (int i = 0; i < count; i++) {
+		uint8_t *key = key_bytes.ptr() + i * 9;
+		value_bytes[i] = _to_bytes(values[i]);
+		entries[i].key = key;
+		entries[i].key_len = eth_rlp_put_uint(key, i) - key;
+		entries[i].value = value_bytes[i].ptr();
+		entries[i].value_len = value_bytes[i].size();
+	}
+
+	PackedByteArray root;
+	root.resize(32);
+	if (!compute_root(entries, root.ptrw())) {
+		return PackedByteArray();
+	}
+	return root;
+}
+
+void MerklePatriciaTrie::_bind_methods() {
+	ClassDB::bind_static_method("MerklePatriciaTrie", D_METHOD("verify_proof", "root", "key", "proof"), &MerklePatriciaTrie::verify_proof);
+	ClassDB::bind_static_method("MerklePatriciaTrie", D_METHOD("verify_account_proof", "state_root", "address", "proof"), &MerklePatriciaTrie::verify_account_proof);
+	ClassDB::bind_static_method("MerklePatriciaTrie", D_METHOD("verify_storage_proof", "storage_root", "slot", "proof"), &MerklePatriciaTrie::verify_storage_proof);
+	ClassDB::bind_static_method("MerklePatriciaTrie", D_METHOD("verify_get_proof", "state_root", "response"), &MerklePatriciaTrie::verify_get_proof);
+	ClassDB::bind_static_method("MerklePatriciaTrie", D_METHOD("trie_root", "keys", "values"), &MerklePatriciaTrie::trie_root);
+	ClassDB::bind_static_method("MerklePatriciaTrie", D_METHOD("ordered_trie_root", "values"), &MerklePatriciaTrie::ordered_trie_root);
+}
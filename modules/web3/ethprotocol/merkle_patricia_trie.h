@@ -0,0 +1,89 @@
+#ifndef MERKLE_PATRICIA_TRIE_H
+#define MERKLE_PATRICIA_TRIE_H
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+#include "rlp_reader.h"
+
+// Merkle Patricia Trie proof verification (eth_getProof) and root computation
+// (transactionsRoot, receiptsRoot). Nodes are read with the RLP reader in
+// place, roots are built from sorted keys without materializing a trie.
+class MerklePatriciaTrie : public RefCounted {
+	GDCLASS(MerklePatriciaTrie, RefCounted);
+
+public:
+	// keccak256(rlp("")), the root of an empty trie.
+	static const uint8_t EMPTY_ROOT[32];
+	// keccak256(""), the code hash of accounts without code.
+	static const uint8_t EMPTY_CODE_HASH[32];
+
+	struct Entry {
+		const uint8_t *key = nullptr;
+		uint32_t key_len = 0;
+		const uint8_t *value = nullptr;
+		uint32_t value_len = 0;
+	};
+
+	// Looks p_key up in the trie of p_root, p_nodes are the proof nodes in any
+	// order. Returns false if the proof does not lead from the root to a
+	// value or to a proven absence. r_value is empty when the key is absent.
+	static bool verify(const uint8_t *p_root, const uint8_t *p_key, size_t p_key_len, const PackedByteArray *p_nodes, int p_node_count, PackedByteArray &r_value);
+	// Root of the trie holding the entries, empty values are skipped.
+	// Returns false on duplicate keys or keys longer than 32 bytes.
+	static bool compute_root(LocalVector<Entry> &p_entries, uint8_t *r_root);
+
+protected:
+	static void _bind_methods();
+
+public:
+	/**
+	 * @brief  Verifies a proof for a raw key (not hashed).
+	 * @param  root 32-byte root, as bytes or hex string.
+	 * @param  proof Proof nodes, as bytes or hex strings.
+	 * @return {"valid": bool, "value": PackedByteArray}, value is empty if
+	 *         the key is absent.
+	 */
+	static Dictionary verify_proof(const Variant &root, const PackedByteArray &key, const Array &proof);
+
+	/**
+	 * @brief  Verifies the accountProof of eth_getProof against a state root.
+	 * @return {"valid", "exists", "nonce", "balance" (BigInt), "storageHash",
+	 *         "codeHash"}, absent accounts have the empty values.
+	 */
+	static Dictionary verify_account_proof(const Variant &state_root, const String &address, const Array &proof);
+
+	/**
+	 * @brief  Verifies one storageProof entry against an account storage root.
+	 * @param  slot Storage slot as hex quantity (e.g. "0x0") or 32 bytes.
+	 * @return {"valid", "value" (BigInt)}, absent slots are zero.
+	 */
+	static Dictionary verify_storage_proof(const Variant &storage_root, const Variant &slot, const Array &proof);
+
+	/**
+	 * @brief  Verifies a whole eth_getProof result: the account fields and
+	 *         every storageProof value must be proven by the state root.
+	 */
+	static bool verify_get_proof(const Variant &state_root, const Dictionary &response);
+
+	/**
+	 * @brief  Root of the trie mapping keys[i] to values[i].
+	 * @return 32-byte root, empty on error.
+	 */
+	static PackedByteArray trie_root(const Array &keys, const Array &values);
+
+	/**
+	 * @brief  Root of the trie mapping rlp(i) to values[i], as used for the
+	 *         transactionsRoot and receiptsRoot of a block. Values are the
+	 *         encoded transactions (typed ones as type || rlp) or receipts.
+	 * @return 32-byte root, empty on error.
+	 */
+	static PackedByteArray ordered_trie_root(const Array &values);
+};
+
+#endif // MERKLE_PATRICIA_TRIE_H
@@ -0,0 +1,272 @@
+#include "presign_queue.h"
+
+#include "transaction_decoder.h"
+#include "u256.h"
+
+PresignQueue::~PresignQueue() {
+	stop();
+}
+
+bool PresignQueue::_set_uint(const Ref<BigInt> &p_number, u256 &r_field) {
+	ERR_FAIL_COND_V_MSG(p_number.is_null(), false, "value must not be null");
+	u256 value;
+	ERR_FAIL_COND_V_MSG(!u256_from_mpz(value, p_number->m_number), false, "value must be between 0 and 2^256 - 1");
+	MutexLock lock(m_mutex);
+	if (u256_cmp(value, r_field) != 0) {
+		r_field = value;
+		_invalidate();
+	}
+	return true;
+}
+
+// Both are called with m_mutex held.
+void PresignQueue::_invalidate() {
+	m_generation++;
+	m_entries.clear();
+	m_semaphore.post();
+}
+
+void PresignQueue::_drop_outside_window() {
+	for (uint32_t i = 0; i < m_entries.size();) {
+		uint64_t nonce = m_entries[i].nonce;
+		if (nonce < m_nonce_base || nonce >= m_nonce_base + m_depth) {
+			m_entries.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+	m_semaphore.post();
+}
+
+void PresignQueue::set_account(Ref<EthAccount> account) {
+	MutexLock lock(m_mutex);
+	m_account = account;
+	_invalidate();
+}
+
+void PresignQueue::set_chain_id(Ref<BigInt> chain_id) {
+	_set_uint(chain_id, m_template.chain_id);
+}
+
+void PresignQueue::set_to_address(const String &to) {
+	TxAddress address;
+	if (!to.is_empty()) {
+		ERR_FAIL_COND_MSG(!TransactionDecoder::parse_hex(to, address.bytes, 20), "Invalid to address: " + to);
+		address.present = true;
+	}
+	MutexLock lock(m_mutex);
+	m_template.to = address;
+	_invalidate();
+}
+
+void PresignQueue::set_value(Ref<BigInt> value) {
+	_set_uint(value, m_template.value);
+}
+
+void PresignQueue::set_data(const PackedByteArray &data) {
+	MutexLock lock(m_mutex);
+	m_data = data;
+	_invalidate();
+}
+
+void PresignQueue::set_gas_limit(uint64_t gas_limit) {
+	MutexLock lock(m_mutex);
+	if (m_template.gas_limit != gas_limit) {
+		m_template.gas_limit = gas_limit;
+		_invalidate();
+	}
+}
+
+void PresignQueue::set_gas_price(Ref<BigInt> gas_price) {
+	_set_uint(gas_price, m_template.gas_price);
+}
+
+void PresignQueue::set_nonce_base(uint64_t nonce) {
+	MutexLock lock(m_mutex);
+	m_nonce_base = nonce;
+	m_nonce_known = true;
+	_drop_outside_window();
+}
+
+uint64_t PresignQueue::get_nonce_base() const {
+	MutexLock lock(m_mutex);
+	return m_nonce_base;
+}
+
+void PresignQueue::set_depth(int depth) {
+	ERR_FAIL_COND_MSG(depth < 1, "depth must be at least 1");
+	MutexLock lock(m_mutex);
+	m_depth = depth;
+	_drop_outside_window();
+}
+
+int PresignQueue::get_depth() const {
+	MutexLock lock(m_mutex);
+	return m_depth;
+}
+
+int PresignQueue::get_ready_count() const {
+	MutexLock lock(m_mutex);
+	int ready = 0;
+	bool found = true;
+	while (found) {
+		found = false;
+		for (uint32_t i = 0; i < m_entries.size(); i++) {
+			if (m_entries[i].nonce == m_nonce_base + ready) {
+				ready++;
+				found = true;
+				break;
+			}
+		}
+	}
+	return ready;
+}
+
+Dictionary PresignQueue::take() {
+	Dictionary result;
+	MutexLock lock(m_mutex);
+	for (uint32_t i = 0; i < m_entries.size(); i++) {
+		if (m_entries[i].nonce != m_nonce_base) {
+			continue;
+		}
+		result["nonce"] = m_entries[i].nonce;
+		result["raw"] = m_entries[i].raw;
+		result["hash"] = m_entries[i].hash;
+		m_entries.remove_at_unordered(i);
+		m_nonce_base++;
+		// The window moved, sign the nonce that entered it.
+		m_semaphore.post();
+		break;
+	}
+	return result;
+}
+
+bool PresignQueue::_sign_next(const secp256k1_context *p_ctx) {
+	Ref<EthAccount> account;
+	TxRecord record;
+	PackedByteArray data;
+	uint64_t generation;
+	{
+		MutexLock lock(m_mutex);
+		if (m_account.is_null() || !m_nonce_known || u256_is_zero(m_template.chain_id)) {
+			return false;
+		}
+
+		// Lowest nonce of the window without an entry.
+		uint64_t nonce = m_nonce_base;
+		for (; nonce < m_nonce_base + m_depth; nonce++) {
+			bool signed_already = false;
+			for (uint32_t i = 0; i < m_entries.size() && !signed_already; i++) {
+				signed_already = m_entries[i].nonce == nonce;
+			}
+			if (!signed_already) {
+				break;
+			}
+		}
+		if (nonce == m_nonce_base + m_depth) {
+			return false;
+		}
+
+		account = m_account;
+		record = m_template;
+		record.nonce = nonce;
+		data = m_data;
+		generation = m_generation;
+	}
+
+	// Signed outside the lock, take() stays instant while this runs.
+	record.data.ptr = data.ptr();
+	record.data.len = data.size();
+	ERR_FAIL_COND_V_MSG(!TxBatch::sign_record(record, account.ptr(), p_ctx), false, "Failed to sign transaction");
+
+	Entry entry;
+	entry.nonce = record.nonce;
+	entry.raw = TxBatch::encode_raw(record);
+	entry.hash.resize(32);
+	TxBatch::SignedSchema::hash(record, TX_TYPE_LEGACY, entry.hash.ptrw());
+
+	MutexLock lock(m_mutex);
+	// The template changed or the nonce left the window while signing,
+	// returning true makes the caller look for the next missing nonce.
+	if (generation != m_generation || entry.nonce < m_nonce_base || entry.nonce >= m_nonce_base + m_depth) {
+		return true;
+	}
+	for (uint32_t i = 0; i < m_entries.size(); i++) {
+		if (m_entries[i].nonce == entry.nonce) {
+			return true;
+		}
+	}
+	m_entries.push_back(entry);
+	return true;
+}
+
+int PresignQueue::refill() {
+	const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+	ERR_FAIL_NULL_V_MSG(ctx, 0, "Failed to create secp256k1 context");
+	// Bounded, a template that keeps changing must not spin here forever.
+	int attempts = get_depth() * 2;
+	while (attempts-- > 0 && _sign_next(ctx)) {
+	}
+	eth_ecdsa_context_release(ctx);
+	return get_ready_count();
+}
+
+void PresignQueue::_thread_func(void *p_userdata) {
+	PresignQueue *queue = static_cast<PresignQueue *>(p_userdata);
+	Thread::set_name("PresignQueue");
+
+	while (!queue->m_exit.is_set()) {
+		queue->m_semaphore.wait();
+		// Borrowed per wake-up, holding it while idle would keep the shared
+		// context from being re-randomized.
+		// Returning would leave is_running() true with nothing refilling, the
+		// next wake-up tries again instead.
+		const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+		ERR_CONTINUE_MSG(ctx == nullptr, "Failed to create secp256k1 context");
+		while (!queue->m_exit.is_set() && queue->_sign_next(ctx)) {
+		}
+		eth_ecdsa_context_release(ctx);
+	}
+}
+
+Error PresignQueue::start() {
+	ERR_FAIL_COND_V_MSG(m_thread.is_started(), ERR_ALREADY_IN_USE, "PresignQueue is already running");
+	m_exit.clear();
+	m_thread.start(&PresignQueue::_thread_func, this);
+	m_semaphore.post();
+	return OK;
+}
+
+void PresignQueue::stop() {
+	if (!m_thread.is_started()) {
+		return;
+	}
+	m_exit.set();
+	m_semaphore.post();
+	m_thread.wait_to_finish();
+}
+
+bool PresignQueue::is_running() const {
+	return m_thread.is_started();
+}
+
+void PresignQueue::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_account", "account"), &PresignQueue::set_account);
+	ClassDB::bind_method(D_METHOD("set_chain_id", "chain_id"), &PresignQueue::set_chain_id);
+	ClassDB::bind_method(D_METHOD("set_to_address", "to"), &PresignQueue::set_to_address);
+	ClassDB::bind_method(D_METHOD("set_value", "value"), &PresignQueue::set_value);
+	ClassDB::bind_method(D_METHOD("set_data", "data"), &PresignQueue::set_data);
+	ClassDB::bind_method(D_METHOD("set_gas_limit", "gas_limit"), &PresignQueue::set_gas_limit);
+	ClassDB::bind_method(D_METHOD("set_gas_price", "gas_price"), &PresignQueue::set_gas_price);
+	ClassDB::bind_method(D_METHOD("set_nonce_base", "nonce"), &PresignQueue::set_nonce_base);
+	ClassDB::bind_method(D_METHOD("get_nonce_base"), &PresignQueue::get_nonce_base);
+	ClassDB::bind_method(D_METHOD("set_depth", "depth"), &PresignQueue::set_depth);
+	ClassDB::bind_method(D_METHOD("get_depth"), &PresignQueue::get_depth);
+
+	ClassDB::bind_method(D_METHOD("get_ready_count"), &PresignQueue::get_ready_count);
+	ClassDB::bind_method(D_METHOD("take"), &PresignQueue::take);
+	ClassDB::bind_method(D_METHOD("refill"), &PresignQueue::refill);
+	ClassDB::bind_method(D_METHOD("start"), &PresignQueue::start);
+	ClassDB::bind_method(D_METHOD("stop"), &PresignQueue::stop);
+	ClassDB::bind_method(D_METHOD("is_running"), &PresignQueue::is_running);
+}
@@ -0,0 +1,96 @@
+#ifndef PRESIGN_QUEUE_H
+#define PRESIGN_QUEUE_H
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+#include "big_int.h"
+#include "eth_account_wrapper.h"
+#include "tx_batch.h"
+
+// Keeps the next `depth` nonces of an account signed ahead of time for one
+// transaction template (to, value, call data, gas settings), so a game action
+// only has to pick up a ready raw transaction instead of signing it.
+//
+// Signing runs on a background thread started by start(), refill() does the
+// same work on the calling thread. Changing the template or the gas price
+// drops every signed entry (a generation counter rejects entries that were
+// being signed meanwhile); moving the nonce base keeps the entries that are
+// still in the new window.
+class PresignQueue : public RefCounted {
+	GDCLASS(PresignQueue, RefCounted);
+
+	struct Entry {
+		uint64_t nonce = 0;
+		String raw;
+		PackedByteArray hash;
+	};
+
+	mutable Mutex m_mutex;
+	Semaphore m_semaphore;
+	Thread m_thread;
+	SafeFlag m_exit;
+
+	// Guarded by m_mutex.
+	Ref<EthAccount> m_account;
+	TxRecord m_template;
+	PackedByteArray m_data; // call data, m_template.data is set per signing
+	uint64_t m_nonce_base = 0;
+	bool m_nonce_known = false;
+	int m_depth = 8;
+	uint64_t m_generation = 0;
+	LocalVector<Entry> m_entries;
+
+	static void _thread_func(void *p_userdata);
+	// Signs one missing nonce, returns false when the window is full or the
+	// queue is not configured.
+	bool _sign_next(const secp256k1_context *p_ctx);
+	void _invalidate();
+	void _drop_outside_window();
+	bool _set_uint(const Ref<BigInt> &p_number, u256 &r_field);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_account(Ref<EthAccount> account);
+	void set_chain_id(Ref<BigInt> chain_id);
+	void set_to_address(const String &to);
+	void set_value(Ref<BigInt> value);
+	// Function selector and arguments, as for LegacyTx.set_data.
+	void set_data(const PackedByteArray &data);
+	void set_gas_limit(uint64_t gas_limit);
+	// Signed entries are re-signed when the price differs.
+	void set_gas_price(Ref<BigInt> gas_price);
+	// Next nonce to use, e.g. from Optimism.nonce_at.
+	void set_nonce_base(uint64_t nonce);
+	uint64_t get_nonce_base() const;
+	// Number of nonces kept signed ahead.
+	void set_depth(int depth);
+	int get_depth() const;
+
+	// Number of consecutive nonces from the base that are ready.
+	int get_ready_count() const;
+	// Returns {"nonce", "raw", "hash"} for the base nonce and advances the
+	// base, or an empty Dictionary when that nonce is not signed yet.
+	Dictionary take();
+	// Signs the missing entries on the calling thread, returns get_ready_count().
+	int refill();
+
+	Error start();
+	void stop();
+	bool is_running() const;
+
+	PresignQueue() {}
+	~PresignQueue();
+};
+
+#endif // PRESIGN_QUEUE_H
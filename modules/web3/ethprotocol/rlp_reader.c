@@ -0,0 +1,127 @@
+#include "rlp_reader.h"
+
+int eth_rlp_read(struct eth_rlp_item *item, const uint8_t *buf, size_t len) {
+  uint8_t prefix;
+  size_t header, payload_len, n, i;
+
+  if (item == NULL || buf == NULL || len == 0)
+    return -1;
+
+  prefix = buf[0];
+
+  if (prefix < 0x80) {
+    item->raw = buf;
+    item->raw_len = 1;
+    item->payload = buf;
+    item->len = 1;
+    item->is_list = 0;
+    return 1;
+  }
+
+  item->is_list = prefix >= 0xc0;
+
+  if (prefix <= 0xb7 || (prefix >= 0xc0 && prefix <= 0xf7)) {
+    header = 1;
+    payload_len = prefix - (item->is_list ? 0xc0 : 0x80);
+  } else {
+    n = prefix - (item->is_list ? 0xf7 : 0xb7);
+    if (n > sizeof(size_t) || 1 + n > len)
+      return -1;
+
+    /* length of the length must not have leading zeros */
+    if (buf[1] == 0)
+      return -1;
+
+    payload_len = 0;
+    for (i = 0; i < n; i++)
+      payload_len = (payload_len << 8) | buf[1 + i];
+
+    /* the long form is only valid for payloads over 55 bytes */
+    if (payload_len <= 55)
+      return -1;
+
+    header = 1 + n;
+  }
+
+  if (payload_len > len - header)
+    return -1;
+
+  /* a single byte below 0x80 must be encoded as itself */
+  if (!item->is_list && payload_len == 1 && buf[1] < 0x80)
+    return -1;
+
+  item->raw = buf;
+  item->raw_len = header + payload_len;
+  item->payload = buf + header;
+  item->len = payload_len;
+  return 1;
+}
+
+int eth_rlp_read_exact(struct eth_rlp_item *item, const uint8_t *buf, size_t len) {
+  if (eth_rlp_read(item, buf, len) <= 0)
+    return -1;
+
+  return item->raw_len == len ? 1 : -1;
+}
+
+int eth_rlp_iter_init(struct eth_rlp_iter *iter, const struct eth_rlp_item *list) {
+  if (iter == NULL || list == NULL || !list->is_list)
+    return -1;
+
+  iter->pos = list->payload;
+  iter->end = list->payload + list->len;
+  return 1;
+}
+
+int eth_rlp_iter_next(struct eth_rlp_iter *iter, struct eth_rlp_item *item) {
+  if (iter->pos >= iter->end)
+    return 0;
+
+  if (eth_rlp_read(item, iter->pos, (size_t)(iter->end - iter->pos)) <= 0)
+    return -1;
+
+  iter->pos += item->raw_len;
+  return 1;
+}
+
+int eth_rlp_read_list(struct eth_rlp_item *items, int max, const struct eth_rlp_item *list) {
+  struct eth_rlp_iter iter;
+  struct eth_rlp_item item;
+  int count = 0, r;
+
+  if (eth_rlp_iter_init(&iter, list) <= 0)
+    return -1;
+
+  while ((r = eth_rlp_iter_next(&iter, &item)) > 0) {
+    if (count >= max)
+      return -1;
+    items[count++] = item;
+  }
+
+  return r < 0 ? -1 : count;
+}
+
+int eth_rlp_item_is_uint(const struct eth_rlp_item *item, size_t max_len) {
+  if (item == NULL || item->is_list || item->len > max_len)
+    return -1;
+
+  /* integers have no leading zero bytes, zero is the empty string */
+  if (item->len > 0 && item->payload[0] == 0)
+    return -1;
+
+  return 1;
+}
+
+int eth_rlp_item_uint64(const struct eth_rlp_item *item, uint64_t *value) {
+  size_t i;
+  uint64_t v = 0;
+
+  if (value == NULL || eth_rlp_item_is_uint(item, 8) <= 0)
+    return -1;
+
+  for (i = 0; i < item->len; i++)
+    v = (v << 8) | item->payload[i];
+
+  *value = v;
+  return 1;
+}
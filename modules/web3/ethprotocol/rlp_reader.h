@@ -0,0 +1,89 @@
+#ifndef ETHC_RLP_READER_H
+#define ETHC_RLP_READER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ethc-common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Zero-copy RLP decoder.
+ *
+ * Items are views into the caller's buffer, nothing is copied or allocated.
+ * The buffer must stay alive and unchanged while items referencing it are used.
+ * Only canonical encodings are accepted.
+ */
+
+/*! @brief A decoded RLP item. */
+struct eth_rlp_item {
+  /*! @brief Start of the encoded item, header included. */
+  const uint8_t *raw;
+  /*! @brief Length of the encoded item, header included. */
+  size_t raw_len;
+  /*! @brief String bytes, or the concatenated encoded items of a list. */
+  const uint8_t *payload;
+  /*! @brief Length of the payload. */
+  size_t len;
+  /*! @brief `1` for lists, `0` for strings. */
+  int is_list;
+};
+
+/*! @brief Cursor over the items of a list. */
+struct eth_rlp_iter {
+  const uint8_t *pos;
+  const uint8_t *end;
+};
+
+/*!
+ * @brief Decodes the item at the start of buf.
+ *
+ * @param[out] item Decoded item.
+ * @param[in] buf Encoded data.
+ * @param[in] len Length of buf, the item may be shorter.
+ * @return `1` on success, `-1` if the data is truncated or not canonical.
+ */
+ETHC_EXPORT int eth_rlp_read(struct eth_rlp_item *item, const uint8_t *buf, size_t len);
+
+/*!
+ * @brief Same as `eth_rlp_read`, but the item must span the whole buffer.
+ */
+ETHC_EXPORT int eth_rlp_read_exact(struct eth_rlp_item *item, const uint8_t *buf, size_t len);
+
+/*!
+ * @brief Starts iterating over the items of a list.
+ * @return `1` on success, `-1` if the item is not a list.
+ */
+ETHC_EXPORT int eth_rlp_iter_init(struct eth_rlp_iter *iter, const struct eth_rlp_item *list);
+
+/*!
+ * @brief Reads the next item of a list.
+ * @return `1` when an item was read, `0` at the end of the list, `-1` on malformed data.
+ */
+ETHC_EXPORT int eth_rlp_iter_next(struct eth_rlp_iter *iter, struct eth_rlp_item *item);
+
+/*!
+ * @brief Decodes up to max items of a list into items.
+ * @return Number of items in the list, `-1` on malformed data or if the list has more than max items.
+ */
+ETHC_EXPORT int eth_rlp_read_list(struct eth_rlp_item *items, int max, const struct eth_rlp_item *list);
+
+/*!
+ * @brief Reads a canonical unsigned integer of at most 8 bytes.
+ * @return `1` on success, `-1` otherwise.
+ */
+ETHC_EXPORT int eth_rlp_item_uint64(const struct eth_rlp_item *item, uint64_t *value);
+
+/*!
+ * @brief Checks that a string item is a canonical unsigned integer of at most max_len bytes.
+ * @return `1` on success, `-1` otherwise.
+ */
+ETHC_EXPORT int eth_rlp_item_is_uint(const struct eth_rlp_item *item, size_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
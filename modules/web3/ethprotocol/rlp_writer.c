@@ -0,0 +1,115 @@
+#include <string.h>
+#include "rlp_writer.h"
+
+static size_t eth_rlp_len_of_len(size_t len) {
+  size_t n = 0;
+
+  while (len != 0) {
+    n++;
+    len >>= 8;
+  }
+
+  return n;
+}
+
+static uint8_t *eth_rlp_put_header(uint8_t *out, uint8_t base, size_t payload_len) {
+  size_t n, i;
+
+  if (payload_len <= 55) {
+    *out++ = (uint8_t)(base + payload_len);
+    return out;
+  }
+
+  n = eth_rlp_len_of_len(payload_len);
+  *out++ = (uint8_t)(base + 55 + n);
+  for (i = 0; i < n; i++)
+    out[i] = (uint8_t)(payload_len >> ((n - 1 - i) * 8));
+
+  return out + n;
+}
+
+static size_t eth_rlp_strip_zeros(const uint8_t **bytes, size_t len) {
+  const uint8_t *p = *bytes;
+
+  while (len > 0 && *p == 0) {
+    p++;
+    len--;
+  }
+
+  *bytes = p;
+  return len;
+}
+
+static size_t eth_rlp_uint_to_be(uint8_t *buf, uint64_t value) {
+  size_t n = 0, i;
+  uint64_t v = value;
+
+  while (v != 0) {
+    n++;
+    v >>= 8;
+  }
+
+  for (i = 0; i < n; i++)
+    buf[i] = (uint8_t)(value >> ((n - 1 - i) * 8));
+
+  return n;
+}
+
+size_t eth_rlp_sizeof_header(size_t payload_len) {
+  if (payload_len <= 55)
+    return 1;
+
+  return 1 + eth_rlp_len_of_len(payload_len);
+}
+
+size_t eth_rlp_sizeof_bytes(const uint8_t *bytes, size_t len) {
+  if (len == 1 && bytes[0] < 0x80)
+    return 1;
+
+  return eth_rlp_sizeof_header(len) + len;
+}
+
+size_t eth_rlp_sizeof_uint(uint64_t value) {
+  uint8_t buf[8];
+  size_t n = eth_rlp_uint_to_be(buf, value);
+
+  return eth_rlp_sizeof_bytes(buf, n);
+}
+
+size_t eth_rlp_sizeof_be_uint(const uint8_t *bytes, size_t len) {
+  len = eth_rlp_strip_zeros(&bytes, len);
+  return eth_rlp_sizeof_bytes(bytes, len);
+}
+
+size_t eth_rlp_sizeof_list(size_t payload_len) {
+  return eth_rlp_sizeof_header(payload_len) + payload_len;
+}
+
+uint8_t *eth_rlp_put_bytes(uint8_t *out, const uint8_t *bytes, size_t len) {
+  if (len == 1 && bytes[0] < 0x80) {
+    *out++ = bytes[0];
+    return out;
+  }
+
+  out = eth_rlp_put_header(out, 0x80, len);
+  if (len > 0)
+    memcpy(out, bytes, len);
+
+  return out + len;
+}
+
+uint8_t *eth_rlp_put_uint(uint8_t *out, uint64_t value) {
+  uint8_t buf[8];
+  size_t n = eth_rlp_uint_to_be(buf, value);
+
+  return eth_rlp_put_bytes(out, buf, n);
+}
+
+uint8_t *eth_rlp_put_be_uint(uint8_t *out, const uint8_t *bytes, size_t len) {
+  len = eth_rlp_strip_zeros(&bytes, len);
+  return eth_rlp_put_bytes(out, bytes, len);
+}
+
+uint8_t *eth_rlp_put_list(uint8_t *out, size_t payload_len) {
+  return eth_rlp_put_header(out, 0xc0, payload_len);
+}
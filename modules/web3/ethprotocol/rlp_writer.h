@@ -0,0 +1,76 @@
+#ifndef ETHC_RLP_WRITER_H
+#define ETHC_RLP_WRITER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ethc-common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Two-pass RLP encoder.
+ *
+ * Unlike `eth_rlp_*` in rlp.h, nothing here allocates: callers first add up
+ * the `eth_rlp_sizeof_*` lengths of every item, allocate (or reuse) a single
+ * buffer of that size and then write the items in order with `eth_rlp_put_*`.
+ * Each writer returns the position right after the bytes it wrote.
+ *
+ * Integers are encoded canonically: zero is the empty string (0x80) and no
+ * leading zero bytes are emitted.
+ */
+
+/*!
+ * @brief Length of the header of a string or list with the given payload length.
+ */
+ETHC_EXPORT size_t eth_rlp_sizeof_header(size_t payload_len);
+
+/*!
+ * @brief Encoded length of a byte string.
+ */
+ETHC_EXPORT size_t eth_rlp_sizeof_bytes(const uint8_t *bytes, size_t len);
+
+/*!
+ * @brief Encoded length of an unsigned integer.
+ */
+ETHC_EXPORT size_t eth_rlp_sizeof_uint(uint64_t value);
+
+/*!
+ * @brief Encoded length of a big-endian unsigned integer, leading zero bytes are ignored.
+ */
+ETHC_EXPORT size_t eth_rlp_sizeof_be_uint(const uint8_t *bytes, size_t len);
+
+/*!
+ * @brief Encoded length of a list whose items take payload_len bytes.
+ */
+ETHC_EXPORT size_t eth_rlp_sizeof_list(size_t payload_len);
+
+/*!
+ * @brief Writes a byte string.
+ *
+ * @param[out] out Destination, must have eth_rlp_sizeof_bytes(bytes, len) bytes available.
+ * @return Pointer past the written data.
+ */
+ETHC_EXPORT uint8_t *eth_rlp_put_bytes(uint8_t *out, const uint8_t *bytes, size_t len);
+
+/*!
+ * @brief Writes an unsigned integer.
+ */
+ETHC_EXPORT uint8_t *eth_rlp_put_uint(uint8_t *out, uint64_t value);
+
+/*!
+ * @brief Writes a big-endian unsigned integer, leading zero bytes are stripped.
+ */
+ETHC_EXPORT uint8_t *eth_rlp_put_be_uint(uint8_t *out, const uint8_t *bytes, size_t len);
+
+/*!
+ * @brief Writes a list header, the caller then writes payload_len bytes of items.
+ */
+ETHC_EXPORT uint8_t *eth_rlp_put_list(uint8_t *out, size_t payload_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,127 @@
+#include "signer_cache.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/mutex.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/lru.h"
+#include "core/templates/safe_refcount.h"
+
+#include "keccak256.h"
+
+namespace {
+
+// Message hash, r, s and recovery id.
+struct SignerKey {
+	uint8_t bytes[97];
+
+	bool operator==(const SignerKey &p_other) const {
+		return memcmp(bytes, p_other.bytes, sizeof(bytes)) == 0;
+	}
+};
+
+struct SignerKeyHasher {
+	static uint32_t hash(const SignerKey &p_key) {
+		return hash_murmur3_buffer(p_key.bytes, sizeof(p_key.bytes));
+	}
+};
+
+struct RecoveredSigner {
+	uint8_t public_key[64];
+	uint8_t address[20];
+};
+
+Mutex signer_cache_mutex;
+LRUCache<SignerKey, RecoveredSigner, SignerKeyHasher> signer_cache(SignerCache::DEFAULT_CAPACITY);
+int signer_cache_capacity = SignerCache::DEFAULT_CAPACITY;
+SafeNumeric<uint64_t> signer_cache_hits;
+SafeNumeric<uint64_t> signer_cache_misses;
+
+void _copy_signer(const RecoveredSigner &p_signer, uint8_t *r_public_key, uint8_t *r_address) {
+	if (r_public_key != nullptr) {
+		memcpy(r_public_key, p_signer.public_key, 64);
+	}
+	if (r_address != nullptr) {
+		memcpy(r_address, p_signer.address, 20);
+	}
+}
+
+} // namespace
+
+bool SignerCache::recover(const secp256k1_context *p_ctx, const uint8_t *p_hash, const eth_ecdsa_signature &p_signature, uint8_t *r_public_key, uint8_t *r_address) {
+	if (p_signature.recid < 0 || p_signature.recid > 3) {
+		return false;
+	}
+
+	SignerKey key;
+	memcpy(key.bytes, p_hash, 32);
+	memcpy(key.bytes + 32, p_signature.r, 32);
+	memcpy(key.bytes + 64, p_signature.s, 32);
+	key.bytes[96] = (uint8_t)p_signature.recid;
+
+	{
+		MutexLock lock(signer_cache_mutex);
+		if (signer_cache_capacity > 0) {
+			const RecoveredSigner *signer = signer_cache.getptr(key);
+			if (signer != nullptr) {
+				_copy_signer(*signer, r_public_key, r_address);
+				signer_cache_hits.increment();
+				return true;
+			}
+		}
+	}
+	signer_cache_misses.increment();
+
+	// Recovered outside the lock, a concurrent miss on the same key only
+	// inserts the same signer twice.
+	RecoveredSigner signer;
+	int r = p_ctx != nullptr ? eth_ecdsa_recover_with_context(p_ctx, signer.public_key, &p_signature, p_hash) : eth_ecdsa_recover(signer.public_key, &p_signature, p_hash);
+	if (r <= 0) {
+		return false;
+	}
+	uint8_t public_key_hash[32];
+	eth_keccak256(public_key_hash, signer.public_key, 64);
+	memcpy(signer.address, public_key_hash + 12, 20);
+	_copy_signer(signer, r_public_key, r_address);
+
+	MutexLock lock(signer_cache_mutex);
+	if (signer_cache_capacity > 0) {
+		signer_cache.insert(key, signer);
+	}
+	return true;
+}
+
+void SignerCache::clear() {
+	MutexLock lock(signer_cache_mutex);
+	signer_cache.clear();
+	signer_cache_hits.set(0);
+	signer_cache_misses.set(0);
+}
+
+void SignerCache::set_capacity(int p_capacity) {
+	ERR_FAIL_COND_MSG(p_capacity < 0, "Signer cache capacity must not be negative");
+	MutexLock lock(signer_cache_mutex);
+	signer_cache_capacity = p_capacity;
+	if (p_capacity == 0) {
+		signer_cache.clear();
+	} else {
+		signer_cache.set_capacity(p_capacity);
+	}
+}
+
+int SignerCache::get_capacity() {
+	MutexLock lock(signer_cache_mutex);
+	return signer_cache_capacity;
+}
+
+int SignerCache::get_size() {
+	MutexLock lock(signer_cache_mutex);
+	return signer_cache.get_size();
+}
+
+uint64_t SignerCache::get_hits() {
+	return signer_cache_hits.get();
+}
+
+uint64_t SignerCache::get_misses() {
+	return signer_cache_misses.get();
+}
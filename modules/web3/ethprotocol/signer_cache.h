@@ -0,0 +1,31 @@
+#ifndef SIGNER_CACHE_H
+#define SIGNER_CACHE_H
+
+#include <stdint.h>
+
+#include "eth_ecdsa.h"
+
+// Process-wide LRU of recovered signers keyed by (message hash, signature).
+// Signatures seen again, e.g. orders of an order book or mempool transactions,
+// are looked up instead of running the EC recovery. Thread safe.
+class SignerCache {
+public:
+	static const int DEFAULT_CAPACITY = 4096;
+
+	// Recovers the signer of a signature over a 32-byte hash, from the cache
+	// when possible. r_public_key receives 64 bytes (x || y), r_address 20
+	// bytes, either may be null. p_ctx may be null, the shared context is
+	// used then.
+	static bool recover(const secp256k1_context *p_ctx, const uint8_t *p_hash, const eth_ecdsa_signature &p_signature, uint8_t *r_public_key, uint8_t *r_address);
+
+	// Drops the entries and resets the counters.
+	static void clear();
+	// Number of signers kept, 0 disables the cache.
+	static void set_capacity(int p_capacity);
+	static int get_capacity();
+	static int get_size();
+	static uint64_t get_hits();
+	static uint64_t get_misses();
+};
+
+#endif // SIGNER_CACHE_H
@@ -0,0 +1,455 @@
+#include "transaction_decoder.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+
+#include "big_int.h"
+#include "keccak256.h"
+#include "rlp_writer.h"
+#include "signer_cache.h"
+#include "u256_math.h"
+
+static int _expected_field_count(int type) {
+	switch (type) {
+		case TransactionDecoder::TYPE_LEGACY:
+			return 9;
+		case TransactionDecoder::TYPE_ACCESS_LIST:
+			return 11;
+		case TransactionDecoder::TYPE_DYNAMIC_FEE:
+			return 12;
+		case TransactionDecoder::TYPE_BLOB:
+			return 14;
+		default:
+			return -1;
+	}
+}
+
+bool TransactionDecoder::parse(const uint8_t *p_raw, size_t p_len, RawTx &r_tx) {
+	if (p_raw == nullptr || p_len == 0) {
+		return false;
+	}
+
+	eth_rlp_item list;
+	if (p_raw[0] >= 0xc0) {
+		r_tx.type = TYPE_LEGACY;
+		if (eth_rlp_read_exact(&list, p_raw, p_len) <= 0) {
+			return false;
+		}
+	} else if (p_raw[0] < 0x80) {
+		// EIP-2718 reserves 0x00 so a typed envelope is never taken for legacy.
+		if (p_raw[0] < TYPE_ACCESS_LIST || p_raw[0] > TYPE_BLOB) {
+			return false;
+		}
+		r_tx.type = p_raw[0];
+		if (eth_rlp_read_exact(&list, p_raw + 1, p_len - 1) <= 0 || !list.is_list) {
+			return false;
+		}
+	} else {
+		// Typed envelope wrapped in an RLP string.
+		eth_rlp_item wrapper;
+		if (eth_rlp_read_exact(&wrapper, p_raw, p_len) <= 0 || wrapper.len == 0 || wrapper.payload[0] >= 0x80) {
+			return false;
+		}
+		return parse(wrapper.payload, wrapper.len, r_tx);
+	}
+
+	int expected = _expected_field_count(r_tx.type);
+	if (expected < 0) {
+		return false;
+	}
+	r_tx.field_count = eth_rlp_read_list(r_tx.fields, MAX_FIELDS, &list);
+	if (r_tx.field_count != expected) {
+		return false;
+	}
+
+	// Signature values are integers of at most 256 bits.
+	for (int i = r_tx.field_count - 3; i < r_tx.field_count; i++) {
+		if (eth_rlp_item_is_uint(&r_tx.fields[i], 32) <= 0) {
+			return false;
+		}
+	}
+
+	r_tx.envelope = p_raw;
+	r_tx.envelope_len = p_len;
+	return true;
+}
+
+static void _item_to_word(const eth_rlp_item &item, uint8_t *r_word) {
+	memset(r_word, 0, 32);
+	memcpy(r_word + 32 - item.len, item.payload, item.len);
+}
+
+// Hashes type || list(fields[0..count)) (no type byte for legacy) followed by
+// the already encoded extra items, without copying when the payload is small.
+static void _hash_payload(const TransactionDecoder::RawTx &p_tx, int p_count, const uint8_t *p_extra, size_t p_extra_len, uint8_t *r_hash) {
+	const uint8_t *fields_begin = p_tx.fields[0].raw;
+	const eth_rlp_item &last = p_tx.fields[p_count - 1];
+	size_t fields_len = (last.raw + last.raw_len) - fields_begin;
+	size_t payload_len = fields_len + p_extra_len;
+	size_t size = (p_tx.type != TransactionDecoder::TYPE_LEGACY ? 1 : 0) + eth_rlp_sizeof_list(payload_len);
+
+	uint8_t stack_buffer[1024];
+	LocalVector<uint8_t> heap_buffer;
+	uint8_t *buffer = stack_buffer;
+	if (size > sizeof(stack_buffer)) {
+		heap_buffer.resize(size);
+		buffer = heap_buffer.ptr();
+	}
+
+	uint8_t *out = buffer;
+	if (p_tx.type != TransactionDecoder::TYPE_LEGACY) {
+		*out++ = (uint8_t)p_tx.type;
+	}
+	out = eth_rlp_put_list(out, payload_len);
+	memcpy(out, fields_begin, fields_len);
+	if (p_extra_len > 0) {
+		memcpy(out + fields_len, p_extra, p_extra_len);
+	}
+	eth_keccak256(r_hash, buffer, size);
+}
+
+bool TransactionDecoder::signing_hash(const RawTx &p_tx, uint8_t *r_hash, eth_ecdsa_signature &r_signature) {
+	int n = p_tx.field_count;
+	_item_to_word(p_tx.fields[n - 2], r_signature.r);
+	_item_to_word(p_tx.fields[n - 1], r_signature.s);
+
+	if (p_tx.type != TYPE_LEGACY) {
+		uint64_t y_parity;
+		if (eth_rlp_item_uint64(&p_tx.fields[n - 3], &y_parity) <= 0 || y_parity > 1) {
+			return false;
+		}
+		r_signature.recid = (int)y_parity;
+		_hash_payload(p_tx, n - 3, nullptr, 0, r_hash);
+		return true;
+	}
+
+	u256 v;
+	u256_from_be_bytes(v, p_tx.fields[6].payload, p_tx.fields[6].len);
+	if (u256_fits_u64(v) && (v.limbs[0] == 27 || v.limbs[0] == 28)) {
+		// Pre EIP-155 signature, the chain id is not part of the payload.
+		r_signature.recid = (int)(v.limbs[0] - 27);
+		_hash_payload(p_tx, 6, nullptr, 0, r_hash);
+		return true;
+	}
+
+	// EIP-155: v = chain_id * 2 + 35 + recid, payload ends with chain_id, 0, 0.
+	u256 chain_id;
+	if (u256_sub(chain_id, v, u256_from_u64(35))) {
+		return false;
+	}
+	r_signature.recid = (int)(chain_id.limbs[0] & 1);
+	u256_shr(chain_id, chain_id, 1);
+	if (u256_is_zero(chain_id)) {
+		return false;
+	}
+
+	uint8_t chain_id_bytes[32];
+	uint8_t extra[35];
+	size_t chain_id_len = u256_to_be_bytes_min(chain_id, chain_id_bytes);
+	uint8_t *out = eth_rlp_put_bytes(extra, chain_id_bytes, chain_id_len);
+	*out++ = 0x80;
+	*out++ = 0x80;
+	_hash_payload(p_tx, 6, extra, out - extra, r_hash);
+	return true;
+}
+
+bool TransactionDecoder::recover_address(const secp256k1_context *p_ctx, const uint8_t *p_raw, size_t p_len, uint8_t *r_address) {
+	RawTx tx;
+	if (!parse(p_raw, p_len, tx)) {
+		return false;
+	}
+
+	uint8_t hash[32];
+	eth_ecdsa_signature signature;
+	if (!signing_hash(tx, hash, signature)) {
+		return false;
+	}
+
+	return SignerCache::recover(p_ctx, hash, signature, nullptr, r_address);
+}
+
+String TransactionDecoder::address_to_hex(const uint8_t *p_address) {
+	return "0x" + String::hex_encode_buffer(p_address, 20);
+}
+
+static int _hex_value(char32_t c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+bool TransactionDecoder::parse_hex(const String &p_hex, uint8_t *r_bytes, int p_len) {
+	const char32_t *hex = p_hex.ptr();
+	int len = p_hex.length();
+	if (len >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+		hex += 2;
+		len -= 2;
+	}
+	if (len != 2 * p_len) {
+		return false;
+	}
+	for (int i = 0; i < p_len; i++) {
+		int hi = _hex_value(hex[2 * i]);
+		int lo = _hex_value(hex[2 * i + 1]);
+		if (hi < 0 || lo < 0) {
+			return false;
+		}
+		r_bytes[i] = (uint8_t)((hi << 4) | lo);
+	}
+	return true;
+}
+
+static Ref<BigInt> _item_to_big_int(const eth_rlp_item &item) {
+	Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+	if (item.len > 0) {
+		number->set_bytes(const_cast<uint8_t *>(item.payload), item.len);
+	}
+	return number;
+}
+
+static String _item_to_hex(const eth_rlp_item &item) {
+	return "0x" + String::hex_encode_buffer(item.payload, item.len);
+}
+
+static PackedByteArray _item_to_bytes(const eth_rlp_item &item) {
+	PackedByteArray bytes;
+	bytes.resize(item.len);
+	if (item.len > 0) {
+		memcpy(bytes.ptrw(), item.payload, item.len);
+	}
+	return bytes;
+}
+
+bool TransactionDecoder::access_list_to_array(const eth_rlp_item &item, Array &r_access_list) {
+	eth_rlp_iter entries;
+	eth_rlp_item entry;
+	int r;
+	if (eth_rlp_iter_init(&entries, &item) <= 0) {
+		return false;
+	}
+	while ((r = eth_rlp_iter_next(&entries, &entry)) > 0) {
+		// [address, [storage_key, ...]]
+		eth_rlp_item parts[2];
+		if (eth_rlp_read_list(parts, 2, &entry) != 2 || parts[0].is_list || parts[0].len != 20) {
+			return false;
+		}
+		PackedStringArray storage_keys;
+		eth_rlp_iter keys;
+		eth_rlp_item key;
+		int k;
+		if (eth_rlp_iter_init(&keys, &parts[1]) <= 0) {
+			return false;
+		}
+		while ((k = eth_rlp_iter_next(&keys, &key)) > 0) {
+			if (key.is_list || key.len != 32) {
+				return false;
+			}
+			storage_keys.push_back(_item_to_hex(key));
+		}
+		if (k < 0) {
+			return false;
+		}
+		Dictionary tuple;
+		tuple["address"] = _item_to_hex(parts[0]);
+		tuple["storageKeys"] = storage_keys;
+		r_access_list.push_back(tuple);
+	}
+	return r == 0;
+}
+
+Dictionary TransactionDecoder::decode(const PackedByteArray &raw, bool with_sender) {
+	RawTx tx;
+	ERR_FAIL_COND_V_MSG(!parse(raw.ptr(), raw.size(), tx), Dictionary(), "Invalid raw transaction");
+
+	const eth_rlp_item *f = tx.fields;
+	int n = tx.field_count;
+	Dictionary result;
+	result["type"] = tx.type;
+
+	// Index of the first field shared by every layout (nonce), and of gas.
+	int nonce_index = tx.type == TYPE_LEGACY ? 0 : 1;
+	int gas_index;
+	if (tx.type == TYPE_LEGACY || tx.type == TYPE_ACCESS_LIST) {
+		ERR_FAIL_COND_V_MSG(eth_rlp_item_is_uint(&f[nonce_index + 1], 32) <= 0, Dictionary(), "Invalid gas price");
+		result["gasPrice"] = _item_to_big_int(f[nonce_index + 1]);
+		gas_index = nonce_index + 2;
+	} else {
+		ERR_FAIL_COND_V_MSG(eth_rlp_item_is_uint(&f[2], 32) <= 0 || eth_rlp_item_is_uint(&f[3], 32) <= 0, Dictionary(), "Invalid fee cap");
+		result["maxPriorityFeePerGas"] = _item_to_big_int(f[2]);
+		result["maxFeePerGas"] = _item_to_big_int(f[3]);
+		gas_index = 4;
+	}
+
+	uint64_t nonce, gas;
+	ERR_FAIL_COND_V_MSG(eth_rlp_item_uint64(&f[nonce_index], &nonce) <= 0, Dictionary(), "Invalid nonce");
+	ERR_FAIL_COND_V_MSG(eth_rlp_item_uint64(&f[gas_index], &gas) <= 0, Dictionary(), "Invalid gas limit");
+	const eth_rlp_item &to = f[gas_index + 1];
+	const eth_rlp_item &value = f[gas_index + 2];
+	const eth_rlp_item &data = f[gas_index + 3];
+	ERR_FAIL_COND_V_MSG(to.is_list || (to.len != 20 && (to.len != 0 || tx.type == TYPE_BLOB)), Dictionary(), "Invalid to address");
+	ERR_FAIL_COND_V_MSG(eth_rlp_item_is_uint(&value, 32) <= 0, Dictionary(), "Invalid value");
+	ERR_FAIL_COND_V_MSG(data.is_list, Dictionary(), "Invalid input data");
+
+	result["nonce"] = nonce;
+	result["gas"] = gas;
+	result["to"] = to.len > 0 ? _item_to_hex(to) : String();
+	result["value"] = _item_to_big_int(value);
+	result["input"] = _item_to_bytes(data);
+
+	if (tx.type == TYPE_LEGACY) {
+		result["v"] = _item_to_big_int(f[6]);
+		Ref<BigInt> chain_id;
+		u256 v;
+		u256_from_be_bytes(v, f[6].payload, f[6].len);
+		if (u256_cmp(v, u256_from_u64(35)) >= 0) {
+			u256_sub(v, v, u256_from_u64(35));
+			u256_shr(v, v, 1);
+			uint8_t chain_id_bytes[32];
+			u256_to_be_bytes(v, chain_id_bytes);
+			chain_id = Ref<BigInt>(memnew(BigInt));
+			chain_id->set_bytes(chain_id_bytes, 32);
+		}
+		result["chainId"] = chain_id;
+	} else {
+		ERR_FAIL_COND_V_MSG(eth_rlp_item_is_uint(&f[0], 32) <= 0, Dictionary(), "Invalid chain id");
+		result["chainId"] = _item_to_big_int(f[0]);
+		Array access_list;
+		ERR_FAIL_COND_V_MSG(!access_list_to_array(f[gas_index + 4], access_list), Dictionary(), "Invalid access list");
+		result["accessList"] = access_list;
+		uint64_t y_parity;
+		ERR_FAIL_COND_V_MSG(eth_rlp_item_uint64(&f[n - 3], &y_parity) <= 0 || y_parity > 1, Dictionary(), "Invalid y parity");
+		result["yParity"] = y_parity;
+		result["v"] = _item_to_big_int(f[n - 3]);
+	}
+
+	if (tx.type == TYPE_BLOB) {
+		ERR_FAIL_COND_V_MSG(eth_rlp_item_is_uint(&f[9], 32) <= 0, Dictionary(), "Invalid blob fee cap");
+		result["maxFeePerBlobGas"] = _item_to_big_int(f[9]);
+		PackedStringArray blob_hashes;
+		eth_rlp_iter hashes;
+		eth_rlp_item hash;
+		int r;
+		ERR_FAIL_COND_V_MSG(eth_rlp_iter_init(&hashes, &f[10]) <= 0, Dictionary(), "Invalid blob hashes");
+		while ((r = eth_rlp_iter_next(&hashes, &hash)) > 0) {
+			ERR_FAIL_COND_V_MSG(hash.is_list || hash.len != 32, Dictionary(), "Invalid blob hash");
+			blob_hashes.push_back(_item_to_hex(hash));
+		}
+		ERR_FAIL_COND_V_MSG(r < 0, Dictionary(), "Invalid blob hashes");
+		result["blobVersionedHashes"] = blob_hashes;
+	}
+
+	result["r"] = _item_to_big_int(f[n - 2]);
+	result["s"] = _item_to_big_int(f[n - 1]);
+
+	uint8_t tx_hash[32];
+	eth_keccak256(tx_hash, tx.envelope, tx.envelope_len);
+	result["hash"] = "0x" + String::hex_encode_buffer(tx_hash, 32);
+
+	if (with_sender) {
+		uint8_t address[20];
+		ERR_FAIL_COND_V_MSG(!recover_address(nullptr, tx.envelope, tx.envelope_len, address), Dictionary(), "Failed to recover sender");
+		result["from"] = address_to_hex(address);
+	}
+	return result;
+}
+
+String TransactionDecoder::recover_sender(const PackedByteArray &raw) {
+	uint8_t address[20];
+	ERR_FAIL_COND_V_MSG(!recover_address(nullptr, raw.ptr(), raw.size(), address), String(), "Failed to recover sender");
+	return address_to_hex(address);
+}
+
+// Batch below which recovering inline is cheaper than dispatching to the pool.
+static const int PARALLEL_RECOVER_THRESHOLD = 8;
+
+struct RecoverBatch {
+	const secp256k1_context *ctx = nullptr;
+	LocalVector<const uint8_t *> raws;
+	LocalVector<size_t> lengths;
+	LocalVector<uint8_t> addresses; // 20 bytes per transaction
+	LocalVector<uint8_t> recovered;
+};
+
+static void _recover_one(void *p_userdata, uint32_t p_index) {
+	RecoverBatch *batch = static_cast<RecoverBatch *>(p_userdata);
+	batch->recovered[p_index] = TransactionDecoder::recover_address(batch->ctx, batch->raws[p_index], batch->lengths[p_index], batch->addresses.ptr() + p_index * 20) ? 1 : 0;
+}
+
+static PackedStringArray _run_recover_batch(RecoverBatch &batch) {
+	uint32_t count = batch.raws.size();
+	PackedStringArray result;
+	if (count == 0) {
+		return result;
+	}
+	batch.addresses.resize(count * 20);
+	batch.recovered.resize(count);
+
+	// The shared context is only read by the workers.
+	const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+	ERR_FAIL_NULL_V_MSG(ctx, result, "Failed to create secp256k1 context");
+	batch.ctx = ctx;
+
+	if (count < PARALLEL_RECOVER_THRESHOLD) {
+		for (uint32_t i = 0; i < count; i++) {
+			_recover_one(&batch, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_recover_one, &batch, count, -1, true, "Recover transaction senders");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	eth_ecdsa_context_release(ctx);
+
+	result.resize(count);
+	String *out = result.ptrw();
+	for (uint32_t i = 0; i < count; i++) {
+		out[i] = batch.recovered[i] ? TransactionDecoder::address_to_hex(batch.addresses.ptr() + i * 20) : String();
+	}
+	return result;
+}
+
+PackedStringArray TransactionDecoder::recover_senders(const Array &raws) {
+	// Keep the byte arrays referenced while the workers read them.
+	LocalVector<PackedByteArray> buffers;
+	RecoverBatch batch;
+	buffers.resize(raws.size());
+	batch.raws.resize(raws.size());
+	batch.lengths.resize(raws.size());
+	for (int i = 0; i < raws.size(); i++) {
+		buffers[i] = raws[i];
+		batch.raws[i] = buffers[i].ptr();
+		batch.lengths[i] = buffers[i].size();
+	}
+	return _run_recover_batch(batch);
+}
+
+PackedStringArray TransactionDecoder::recover_block_senders(const PackedByteArray &transactions) {
+	eth_rlp_item list;
+	ERR_FAIL_COND_V_MSG(eth_rlp_read_exact(&list, transactions.ptr(), transactions.size()) <= 0 || !list.is_list, PackedStringArray(), "Invalid transaction list");
+
+	RecoverBatch batch;
+	eth_rlp_iter iter;
+	eth_rlp_item item;
+	int r;
+	eth_rlp_iter_init(&iter, &list);
+	while ((r = eth_rlp_iter_next(&iter, &item)) > 0) {
+		// Legacy transactions are embedded as lists, typed ones as strings.
+		batch.raws.push_back(item.is_list ? item.raw : item.payload);
+		batch.lengths.push_back(item.is_list ? item.raw_len : item.len);
+	}
+	ERR_FAIL_COND_V_MSG(r < 0, PackedStringArray(), "Invalid transaction list");
+	return _run_recover_batch(batch);
+}
+
+void TransactionDecoder::_bind_methods() {
+	ClassDB::bind_static_method("TransactionDecoder", D_METHOD("decode", "raw", "with_sender"), &TransactionDecoder::decode, DEFVAL(false));
+	ClassDB::bind_static_method("TransactionDecoder", D_METHOD("recover_sender", "raw"), &TransactionDecoder::recover_sender);
+	ClassDB::bind_static_method("TransactionDecoder", D_METHOD("recover_senders", "raws"), &TransactionDecoder::recover_senders);
+	ClassDB::bind_static_method("TransactionDecoder", D_METHOD("recover_block_senders", "transactions"), &TransactionDecoder::recover_block_senders);
+}
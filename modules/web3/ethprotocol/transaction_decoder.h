@@ -0,0 +1,66 @@
+#ifndef TRANSACTION_DECODER_H
+#define TRANSACTION_DECODER_H
+
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+#include "core/error/error_macros.h"
+
+#include "rlp_reader.h"
+#include "eth_ecdsa.h"
+
+// Decodes signed raw transactions (legacy and EIP-2718 typed envelopes) and
+// recovers their senders. Parsing works on views into the input buffer, the
+// signing payload is rebuilt from the original field encodings.
+class TransactionDecoder : public RefCounted {
+	GDCLASS(TransactionDecoder, RefCounted);
+
+public:
+	static const int TYPE_LEGACY = 0;
+	static const int TYPE_ACCESS_LIST = 1;
+	static const int TYPE_DYNAMIC_FEE = 2;
+	static const int TYPE_BLOB = 3;
+
+	static const int MAX_FIELDS = 14;
+
+	// A parsed transaction, fields point into the raw buffer.
+	struct RawTx {
+		int type = TYPE_LEGACY;
+		// Bytes whose keccak is the transaction hash (type byte included).
+		const uint8_t *envelope = nullptr;
+		size_t envelope_len = 0;
+		eth_rlp_item fields[MAX_FIELDS];
+		int field_count = 0;
+	};
+
+	// Accepts a legacy RLP list, a typed envelope (type || rlp) or a typed
+	// envelope wrapped in an RLP string, as found in block bodies.
+	static bool parse(const uint8_t *p_raw, size_t p_len, RawTx &r_tx);
+	// Hash of the payload the sender signed, and the signature to recover from.
+	static bool signing_hash(const RawTx &p_tx, uint8_t *r_hash, eth_ecdsa_signature &r_signature);
+	// p_ctx may be null, a temporary verification context is used then.
+	static bool recover_address(const secp256k1_context *p_ctx, const uint8_t *p_raw, size_t p_len, uint8_t *r_address);
+	static String address_to_hex(const uint8_t *p_address);
+	// Parses exactly p_len bytes of hex, the 0x prefix is optional.
+	static bool parse_hex(const String &p_hex, uint8_t *r_bytes, int p_len);
+	// Converts an encoded access list to [{address, storageKeys}, ...].
+	static bool access_list_to_array(const eth_rlp_item &p_list, Array &r_access_list);
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Returns the transaction fields with JSON-RPC names, empty on error.
+	static Dictionary decode(const PackedByteArray &raw, bool with_sender = false);
+	// Returns the 0x-prefixed sender address, empty on error.
+	static String recover_sender(const PackedByteArray &raw);
+	// Recovers the senders of many raw transactions on the worker thread pool.
+	// Entries that fail to decode or recover are empty strings.
+	static PackedStringArray recover_senders(const Array &raws);
+	// Same as recover_senders for the RLP encoded transaction list of a block body.
+	static PackedStringArray recover_block_senders(const PackedByteArray &transactions);
+};
+
+#endif // TRANSACTION_DECODER_H
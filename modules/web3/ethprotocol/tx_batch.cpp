@@ -0,0 +1,345 @@
+#include "tx_batch.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/memory.h"
+
+#include "keccak256.h"
+#include "transaction_decoder.h"
+#include "u256.h"
+
+void *TxArena::alloc(size_t p_size, size_t p_align) {
+	uintptr_t pos = ((uintptr_t)m_pos + p_align - 1) & ~(uintptr_t)(p_align - 1);
+	if (m_pos == nullptr || pos + p_size > (uintptr_t)m_end) {
+		// Oversized requests get a block of their own.
+		size_t block_size = MAX(BLOCK_SIZE, p_size + p_align);
+		uint8_t *block = (uint8_t *)memalloc(block_size);
+		ERR_FAIL_NULL_V(block, nullptr);
+		m_blocks.push_back(block);
+		m_allocated += block_size;
+		m_pos = block;
+		m_end = block + block_size;
+		pos = ((uintptr_t)m_pos + p_align - 1) & ~(uintptr_t)(p_align - 1);
+	}
+	m_pos = (uint8_t *)(pos + p_size);
+	return (void *)pos;
+}
+
+const uint8_t *TxArena::copy(const uint8_t *p_data, size_t p_len) {
+	if (p_len == 0) {
+		return nullptr;
+	}
+	uint8_t *dest = (uint8_t *)alloc(p_len, 1);
+	ERR_FAIL_NULL_V(dest, nullptr);
+	memcpy(dest, p_data, p_len);
+	return dest;
+}
+
+void TxArena::reset() {
+	for (uint32_t i = 0; i < m_blocks.size(); i++) {
+		memfree(m_blocks[i]);
+	}
+	m_blocks.clear();
+	m_pos = nullptr;
+	m_end = nullptr;
+	m_allocated = 0;
+}
+
+TxRecord *TxBatch::_new_record(const TxRecord &p_source) {
+	TxRecord *record = (TxRecord *)m_arena.alloc(sizeof(TxRecord), alignof(TxRecord));
+	ERR_FAIL_NULL_V(record, nullptr);
+	memcpy(record, &p_source, sizeof(TxRecord));
+	record->is_signed = false;
+	m_records.push_back(record);
+	return record;
+}
+
+const TxRecord *TxBatch::_get_record(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)m_records.size(), nullptr);
+	return m_records[p_index];
+}
+
+bool TxBatch::_set_uint(const Ref<BigInt> &p_number, u256 &r_field) {
+	ERR_FAIL_COND_V_MSG(p_number.is_null(), false, "value must not be null");
+	ERR_FAIL_COND_V_MSG(!u256_from_mpz(r_field, p_number->m_number), false, "value must be between 0 and 2^256 - 1");
+	return true;
+}
+
+void TxBatch::set_chain_id(Ref<BigInt> chain_id) {
+	_set_uint(chain_id, m_template.chain_id);
+}
+
+void TxBatch::set_gas_price(Ref<BigInt> gas_price) {
+	_set_uint(gas_price, m_template.gas_price);
+}
+
+void TxBatch::set_gas_limit(uint64_t gas_limit) {
+	m_template.gas_limit = gas_limit;
+}
+
+void TxBatch::set_data(PackedByteArray data) {
+	// Records already added keep pointing at the previous copy.
+	m_template.data.ptr = m_arena.copy(data.ptr(), data.size());
+	m_template.data.len = data.size();
+}
+
+int TxBatch::add(const String &to, Ref<BigInt> value, uint64_t nonce) {
+	TxRecord source = m_template;
+	source.nonce = nonce;
+	if (!to.is_empty()) {
+		ERR_FAIL_COND_V_MSG(!TransactionDecoder::parse_hex(to, source.to.bytes, 20), -1, "Invalid to address: " + to);
+		source.to.present = true;
+	}
+	if (!_set_uint(value, source.value)) {
+		return -1;
+	}
+	return _new_record(source) != nullptr ? (int)m_records.size() - 1 : -1;
+}
+
+int TxBatch::add_transfers(const PackedStringArray &to_addresses, const Array &values, uint64_t first_nonce) {
+	ERR_FAIL_COND_V_MSG(to_addresses.size() != values.size(), 0, "values must have one entry per address");
+	m_records.reserve(m_records.size() + to_addresses.size());
+
+	int added = 0;
+	for (int i = 0; i < to_addresses.size(); i++) {
+		Ref<BigInt> value = Ref<BigInt>(Object::cast_to<BigInt>(values[i].operator Object *()));
+		if (add(to_addresses[i], value, first_nonce + added) < 0) {
+			break;
+		}
+		added++;
+	}
+	return added;
+}
+
+int TxBatch::add_transaction(Ref<LegacyTx> tx) {
+	ERR_FAIL_COND_V(tx.is_null(), -1);
+	if (!tx->_sync_fields(false)) {
+		return -1;
+	}
+
+	const LegacyTx::Fields &fields = tx->m_fields;
+	TxRecord source;
+	source.nonce = fields.nonce;
+	source.gas_price = fields.gas_price;
+	source.gas_limit = fields.gas_limit;
+	source.to = fields.to;
+	source.value = fields.value;
+	source.data.ptr = m_arena.copy(fields.data.ptr(), fields.data.size());
+	source.data.len = fields.data.size();
+	source.chain_id = fields.chain_id;
+	return _new_record(source) != nullptr ? (int)m_records.size() - 1 : -1;
+}
+
+int TxBatch::clone_with_nonce(int index, uint64_t nonce) {
+	const TxRecord *source = _get_record(index);
+	ERR_FAIL_NULL_V(source, -1);
+	TxRecord *record = _new_record(*source);
+	ERR_FAIL_NULL_V(record, -1);
+	record->nonce = nonce;
+	return (int)m_records.size() - 1;
+}
+
+int TxBatch::size() const {
+	return m_records.size();
+}
+
+void TxBatch::clear() {
+	m_records.clear();
+	m_arena.reset();
+	m_template.data = TxBytes();
+}
+
+int64_t TxBatch::get_memory_usage() const {
+	return m_arena.get_allocated() + m_records.size() * sizeof(TxRecord *);
+}
+
+struct TxSignBatch {
+	const secp256k1_context *ctx = nullptr;
+	const EthAccount *signer = nullptr;
+	TxRecord **records = nullptr;
+	LocalVector<uint8_t> signed_ok;
+};
+
+bool TxBatch::sign_record(TxRecord &r_record, const EthAccount *p_signer, const secp256k1_context *p_ctx) {
+	if (u256_is_zero(r_record.chain_id)) {
+		return false;
+	}
+
+	uint8_t hash[32];
+	uint8_t signature[65];
+	SigningSchema::hash(r_record, TX_TYPE_LEGACY, hash);
+	if (!p_signer->sign_hash32(hash, signature, p_ctx)) {
+		return false;
+	}
+
+	// v = chain_id * 2 + 35 + recid
+	u256 v;
+	u256_shl(v, r_record.chain_id, 1);
+	if (u256_add(v, v, u256_from_u64(35 + signature[64]))) {
+		return false;
+	}
+	r_record.v = v;
+	u256_from_be_bytes(r_record.r, signature, 32);
+	u256_from_be_bytes(r_record.s, signature + 32, 32);
+	r_record.is_signed = true;
+	return true;
+}
+
+String TxBatch::encode_raw(const TxRecord &p_record) {
+	size_t size = SignedSchema::encoded_size(p_record, TX_TYPE_LEGACY);
+	uint8_t stack_buffer[1024];
+	LocalVector<uint8_t> heap_buffer;
+	uint8_t *buffer = stack_buffer;
+	if (size > sizeof(stack_buffer)) {
+		heap_buffer.resize(size);
+		buffer = heap_buffer.ptr();
+	}
+	SignedSchema::write(buffer, p_record, TX_TYPE_LEGACY);
+	return "0x" + String::hex_encode_buffer(buffer, size);
+}
+
+static void _sign_record(void *p_userdata, uint32_t p_index) {
+	TxSignBatch *batch = static_cast<TxSignBatch *>(p_userdata);
+	TxRecord *record = batch->records[p_index];
+	if (!record->is_signed && TxBatch::sign_record(*record, batch->signer, batch->ctx)) {
+		batch->signed_ok[p_index] = 1;
+	}
+}
+
+int TxBatch::sign(Ref<EthAccount> signer) {
+	ERR_FAIL_COND_V(signer.is_null(), 0);
+	int count = m_records.size();
+	if (count == 0) {
+		return 0;
+	}
+
+	TxSignBatch batch;
+	batch.signer = signer.ptr();
+	batch.records = m_records.ptr();
+	batch.signed_ok.resize(count);
+	memset(batch.signed_ok.ptr(), 0, count);
+
+	// Signing only reads the shared context, all workers use it.
+	const secp256k1_context *ctx = eth_ecdsa_context_acquire();
+	ERR_FAIL_NULL_V_MSG(ctx, 0, "Failed to create secp256k1 context");
+	batch.ctx = ctx;
+
+	if (count < PARALLEL_SIGN_THRESHOLD) {
+		for (int i = 0; i < count; i++) {
+			_sign_record(&batch, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_sign_record, &batch, count, -1, true, "Sign transaction batch");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	eth_ecdsa_context_release(ctx);
+
+	int signed_count = 0;
+	for (int i = 0; i < count; i++) {
+		signed_count += batch.signed_ok[i];
+	}
+	return signed_count;
+}
+
+bool TxBatch::is_signed(int index) const {
+	const TxRecord *record = _get_record(index);
+	return record != nullptr && record->is_signed;
+}
+
+uint64_t TxBatch::get_nonce(int index) const {
+	const TxRecord *record = _get_record(index);
+	ERR_FAIL_NULL_V(record, 0);
+	return record->nonce;
+}
+
+String TxBatch::get_to_address(int index) const {
+	const TxRecord *record = _get_record(index);
+	ERR_FAIL_NULL_V(record, String());
+	return record->to.present ? TransactionDecoder::address_to_hex(record->to.bytes) : String();
+}
+
+String TxBatch::get_raw(int index) const {
+	const TxRecord *record = _get_record(index);
+	if (record == nullptr || !record->is_signed) {
+		return String();
+	}
+
+	return encode_raw(*record);
+}
+
+PackedStringArray TxBatch::get_raw_transactions() const {
+	PackedStringArray result;
+	result.resize(m_records.size());
+	String *raws = result.ptrw();
+	for (uint32_t i = 0; i < m_records.size(); i++) {
+		raws[i] = get_raw(i);
+	}
+	return result;
+}
+
+PackedByteArray TxBatch::get_hash(int index) const {
+	const TxRecord *record = _get_record(index);
+	if (record == nullptr || !record->is_signed) {
+		return PackedByteArray();
+	}
+	PackedByteArray result;
+	result.resize(32);
+	SignedSchema::hash(*record, TX_TYPE_LEGACY, result.ptrw());
+	return result;
+}
+
+static Ref<BigInt> _to_big_int(const u256 &p_value) {
+	Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+	u256_to_mpz(number->m_number, p_value);
+	return number;
+}
+
+Ref<LegacyTx> TxBatch::get_transaction(int index) const {
+	const TxRecord *record = _get_record(index);
+	ERR_FAIL_NULL_V(record, Ref<LegacyTx>());
+
+	Ref<LegacyTx> tx = Ref<LegacyTx>(memnew(LegacyTx));
+	tx->set_nonce(record->nonce);
+	tx->set_gas_price(_to_big_int(record->gas_price));
+	tx->set_gas_limit(record->gas_limit);
+	if (record->to.present) {
+		tx->set_to_address(TransactionDecoder::address_to_hex(record->to.bytes));
+	}
+	tx->set_value(_to_big_int(record->value));
+	PackedByteArray data;
+	data.resize(record->data.len);
+	if (record->data.len > 0) {
+		memcpy(data.ptrw(), record->data.ptr, record->data.len);
+	}
+	tx->set_data(data);
+	tx->set_chain_id(_to_big_int(record->chain_id));
+	if (record->is_signed) {
+		tx->set_sign_v(_to_big_int(record->v));
+		tx->set_sign_r(_to_big_int(record->r));
+		tx->set_sign_s(_to_big_int(record->s));
+	}
+	return tx;
+}
+
+void TxBatch::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_chain_id", "chain_id"), &TxBatch::set_chain_id);
+	ClassDB::bind_method(D_METHOD("set_gas_price", "gas_price"), &TxBatch::set_gas_price);
+	ClassDB::bind_method(D_METHOD("set_gas_limit", "gas_limit"), &TxBatch::set_gas_limit);
+	ClassDB::bind_method(D_METHOD("set_data", "data"), &TxBatch::set_data);
+
+	ClassDB::bind_method(D_METHOD("add", "to", "value", "nonce"), &TxBatch::add);
+	ClassDB::bind_method(D_METHOD("add_transfers", "to_addresses", "values", "first_nonce"), &TxBatch::add_transfers);
+	ClassDB::bind_method(D_METHOD("add_transaction", "tx"), &TxBatch::add_transaction);
+	ClassDB::bind_method(D_METHOD("clone_with_nonce", "index", "nonce"), &TxBatch::clone_with_nonce);
+	ClassDB::bind_method(D_METHOD("size"), &TxBatch::size);
+	ClassDB::bind_method(D_METHOD("clear"), &TxBatch::clear);
+	ClassDB::bind_method(D_METHOD("get_memory_usage"), &TxBatch::get_memory_usage);
+
+	ClassDB::bind_method(D_METHOD("sign", "signer"), &TxBatch::sign);
+	ClassDB::bind_method(D_METHOD("is_signed", "index"), &TxBatch::is_signed);
+	ClassDB::bind_method(D_METHOD("get_nonce", "index"), &TxBatch::get_nonce);
+	ClassDB::bind_method(D_METHOD("get_to_address", "index"), &TxBatch::get_to_address);
+	ClassDB::bind_method(D_METHOD("get_raw", "index"), &TxBatch::get_raw);
+	ClassDB::bind_method(D_METHOD("get_raw_transactions"), &TxBatch::get_raw_transactions);
+	ClassDB::bind_method(D_METHOD("get_hash", "index"), &TxBatch::get_hash);
+	ClassDB::bind_method(D_METHOD("get_transaction", "index"), &TxBatch::get_transaction);
+}
@@ -0,0 +1,133 @@
+#ifndef TX_BATCH_H
+#define TX_BATCH_H
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/variant.h"
+
+#include "big_int.h"
+#include "eth_account_wrapper.h"
+#include "legacy_tx.h"
+#include "tx_schema.h"
+#include "u256_math.h"
+
+// Bump allocator, memory is only released all at once by reset() or the
+// destructor. Not thread safe.
+class TxArena {
+	static const size_t BLOCK_SIZE = 64 * 1024;
+
+	LocalVector<uint8_t *> m_blocks;
+	uint8_t *m_pos = nullptr;
+	uint8_t *m_end = nullptr;
+	size_t m_allocated = 0;
+
+public:
+	void *alloc(size_t p_size, size_t p_align = alignof(uint64_t));
+	const uint8_t *copy(const uint8_t *p_data, size_t p_len);
+	void reset();
+	// Bytes reserved from the system, whole blocks.
+	size_t get_allocated() const { return m_allocated; }
+
+	TxArena() {}
+	~TxArena() { reset(); }
+};
+
+// Legacy transaction as plain data: fixed-width values, inline address and
+// call data in the arena. Copying a record is a memcpy, the data is shared.
+struct TxRecord {
+	uint64_t nonce = 0;
+	u256 gas_price = {};
+	uint64_t gas_limit = 0;
+	TxAddress to;
+	u256 value = {};
+	TxBytes data;
+	u256 chain_id = {};
+	u256 v = {};
+	u256 r = {};
+	u256 s = {};
+	bool is_signed = false;
+};
+
+// Builds, signs and encodes many legacy transactions with a few allocations:
+// records and call data live in one arena, nothing is reference counted until
+// a transaction is turned back into a LegacyTx. Meant for payout batches of
+// thousands of transfers that share chain id, gas price, gas limit and data.
+class TxBatch : public RefCounted {
+	GDCLASS(TxBatch, RefCounted);
+
+public:
+	typedef RlpSchema<
+			RlpField<&TxRecord::nonce>,
+			RlpField<&TxRecord::gas_price>,
+			RlpField<&TxRecord::gas_limit>,
+			RlpField<&TxRecord::to>,
+			RlpField<&TxRecord::value>,
+			RlpField<&TxRecord::data>>
+			BaseSchema;
+	typedef BaseSchema::Append<RlpField<&TxRecord::chain_id>, RlpEmptyField, RlpEmptyField> SigningSchema;
+	typedef BaseSchema::Append<RlpField<&TxRecord::v>, RlpField<&TxRecord::r>, RlpField<&TxRecord::s>> SignedSchema;
+
+	// Signs a record in place (EIP-155 v), p_ctx may be null.
+	static bool sign_record(TxRecord &r_record, const EthAccount *p_signer, const secp256k1_context *p_ctx);
+	// 0x-prefixed signed encoding of a signed record.
+	static String encode_raw(const TxRecord &p_record);
+
+	// Batch below which signing inline is cheaper than dispatching to the pool.
+	static const int PARALLEL_SIGN_THRESHOLD = 4;
+
+private:
+	TxArena m_arena;
+	LocalVector<TxRecord *> m_records;
+	// Fields copied into every record created by add().
+	TxRecord m_template;
+
+	TxRecord *_new_record(const TxRecord &p_source);
+	const TxRecord *_get_record(int p_index) const;
+	bool _set_uint(const Ref<BigInt> &p_number, u256 &r_field);
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Template for add() and add_transfers().
+	void set_chain_id(Ref<BigInt> chain_id);
+	void set_gas_price(Ref<BigInt> gas_price);
+	void set_gas_limit(uint64_t gas_limit);
+	void set_data(PackedByteArray data);
+
+	// Adds a transaction from the template, returns its index or -1.
+	int add(const String &to, Ref<BigInt> value, uint64_t nonce);
+	// Adds one transfer per address with consecutive nonces from first_nonce,
+	// values holds one BigInt per address. Returns the number added.
+	int add_transfers(const PackedStringArray &to_addresses, const Array &values, uint64_t first_nonce);
+	// Copies the unsigned fields of a LegacyTx, returns its index or -1.
+	int add_transaction(Ref<LegacyTx> tx);
+	// Copies a transaction with another nonce, unsigned. Returns the new index.
+	int clone_with_nonce(int index, uint64_t nonce);
+
+	int size() const;
+	void clear();
+	// Arena memory in use, in bytes.
+	int64_t get_memory_usage() const;
+
+	// Signs every unsigned transaction, returns the number signed.
+	int sign(Ref<EthAccount> signer);
+	bool is_signed(int index) const;
+	uint64_t get_nonce(int index) const;
+	String get_to_address(int index) const;
+	// 0x-prefixed signed raw transaction, empty if not signed.
+	String get_raw(int index) const;
+	PackedStringArray get_raw_transactions() const;
+	// Hash of the signed transaction, empty if not signed.
+	PackedByteArray get_hash(int index) const;
+	// A LegacyTx with the fields (and signature) of the record.
+	Ref<LegacyTx> get_transaction(int index) const;
+
+	TxBatch() {}
+	~TxBatch() {}
+};
+
+#endif // TX_BATCH_H
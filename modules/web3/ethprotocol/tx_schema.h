@@ -0,0 +1,269 @@
+#ifndef TX_SCHEMA_H
+#define TX_SCHEMA_H
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+#include "keccak256.h"
+#include "rlp_reader.h"
+#include "rlp_writer.h"
+#include "u256_math.h"
+
+// Compile-time RLP schemas for transactions.
+//
+// A transaction type is described once as a list of fields, each one a pointer
+// to a member of its record struct:
+//
+//     typedef RlpSchema<RlpField<&Record::nonce>, RlpField<&Record::to>, ...> Schema;
+//
+// and the schema generates size computation, encoding, decoding and hashing.
+// The codec of a field is picked from the member type (uint64_t, u256,
+// TxAddress, PackedByteArray, TxBytes or TxAccessList), so no per-type
+// encoding code is written by hand. Encoded sizes are computed first, the
+// output is written in one pass with the `eth_rlp_put_*` writers.
+
+// Optional 20-byte address, absent means contract creation.
+struct TxAddress {
+	bool present = false;
+	uint8_t bytes[20] = {};
+};
+
+// EIP-2930 access list, kept as the payload of its encoded RLP list.
+struct TxAccessList {
+	PackedByteArray payload;
+};
+
+// Type byte of EIP-2718 envelopes, legacy transactions have none.
+static const int TX_TYPE_LEGACY = 0;
+
+// uint64_t: canonical integer.
+static inline size_t tx_field_size(const uint64_t &p_value) {
+	return eth_rlp_sizeof_uint(p_value);
+}
+
+static inline uint8_t *tx_field_write(uint8_t *r_out, const uint64_t &p_value) {
+	return eth_rlp_put_uint(r_out, p_value);
+}
+
+static inline bool tx_field_read(const eth_rlp_item &p_item, uint64_t &r_value) {
+	return eth_rlp_item_uint64(&p_item, &r_value) > 0;
+}
+
+// u256: canonical integer of at most 32 bytes.
+static inline size_t tx_field_size(const u256 &p_value) {
+	uint8_t bytes[32];
+	size_t len = u256_to_be_bytes_min(p_value, bytes);
+	return eth_rlp_sizeof_bytes(bytes, len);
+}
+
+static inline uint8_t *tx_field_write(uint8_t *r_out, const u256 &p_value) {
+	uint8_t bytes[32];
+	size_t len = u256_to_be_bytes_min(p_value, bytes);
+	return eth_rlp_put_bytes(r_out, bytes, len);
+}
+
+static inline bool tx_field_read(const eth_rlp_item &p_item, u256 &r_value) {
+	return eth_rlp_item_is_uint(&p_item, 32) > 0 && u256_from_be_bytes(r_value, p_item.payload, p_item.len);
+}
+
+// TxAddress: 20 bytes, or the empty string.
+static inline size_t tx_field_size(const TxAddress &p_address) {
+	return p_address.present ? 21 : 1;
+}
+
+static inline uint8_t *tx_field_write(uint8_t *r_out, const TxAddress &p_address) {
+	return eth_rlp_put_bytes(r_out, p_address.bytes, p_address.present ? 20 : 0);
+}
+
+static inline bool tx_field_read(const eth_rlp_item &p_item, TxAddress &r_address) {
+	if (p_item.is_list || (p_item.len != 0 && p_item.len != 20)) {
+		return false;
+	}
+	r_address.present = p_item.len == 20;
+	if (r_address.present) {
+		memcpy(r_address.bytes, p_item.payload, 20);
+	}
+	return true;
+}
+
+// PackedByteArray: byte string.
+static inline size_t tx_field_size(const PackedByteArray &p_bytes) {
+	return eth_rlp_sizeof_bytes(p_bytes.ptr(), p_bytes.size());
+}
+
+static inline uint8_t *tx_field_write(uint8_t *r_out, const PackedByteArray &p_bytes) {
+	return eth_rlp_put_bytes(r_out, p_bytes.ptr(), p_bytes.size());
+}
+
+static inline bool tx_field_read(const eth_rlp_item &p_item, PackedByteArray &r_bytes) {
+	if (p_item.is_list) {
+		return false;
+	}
+	r_bytes.resize(p_item.len);
+	if (p_item.len > 0) {
+		memcpy(r_bytes.ptrw(), p_item.payload, p_item.len);
+	}
+	return true;
+}
+
+// Byte string owned elsewhere, e.g. by a TxArena.
+struct TxBytes {
+	const uint8_t *ptr = nullptr;
+	uint32_t len = 0;
+};
+
+static inline size_t tx_field_size(const TxBytes &p_bytes) {
+	return eth_rlp_sizeof_bytes(p_bytes.ptr, p_bytes.len);
+}
+
+static inline uint8_t *tx_field_write(uint8_t *r_out, const TxBytes &p_bytes) {
+	return eth_rlp_put_bytes(r_out, p_bytes.ptr, p_bytes.len);
+}
+
+// Checks the [[address, [storage_key, ...]], ...] layout of an access list.
+static inline bool tx_access_list_is_valid(const eth_rlp_item &p_list) {
+	eth_rlp_iter entries, keys;
+	eth_rlp_item entry, key;
+	eth_rlp_item parts[2];
+	int r, k;
+
+	if (eth_rlp_iter_init(&entries, &p_list) <= 0) {
+		return false;
+	}
+	while ((r = eth_rlp_iter_next(&entries, &entry)) > 0) {
+		if (eth_rlp_read_list(parts, 2, &entry) != 2 || parts[0].is_list || parts[0].len != 20) {
+			return false;
+		}
+		if (eth_rlp_iter_init(&keys, &parts[1]) <= 0) {
+			return false;
+		}
+		while ((k = eth_rlp_iter_next(&keys, &key)) > 0) {
+			if (key.is_list || key.len != 32) {
+				return false;
+			}
+		}
+		if (k < 0) {
+			return false;
+		}
+	}
+	return r == 0;
+}
+
+// TxAccessList: list of [address, [storage_key, ...]].
+static inline size_t tx_field_size(const TxAccessList &p_access_list) {
+	return eth_rlp_sizeof_list(p_access_list.payload.size());
+}
+
+static inline uint8_t *tx_field_write(uint8_t *r_out, const TxAccessList &p_access_list) {
+	size_t len = p_access_list.payload.size();
+	r_out = eth_rlp_put_list(r_out, len);
+	if (len > 0) {
+		memcpy(r_out, p_access_list.payload.ptr(), len);
+	}
+	return r_out + len;
+}
+
+static inline bool tx_field_read(const eth_rlp_item &p_item, TxAccessList &r_access_list) {
+	if (!tx_access_list_is_valid(p_item)) {
+		return false;
+	}
+	r_access_list.payload.resize(p_item.len);
+	if (p_item.len > 0) {
+		memcpy(r_access_list.payload.ptrw(), p_item.payload, p_item.len);
+	}
+	return true;
+}
+
+// A record member encoded with the codec of its type.
+template <auto Member>
+struct RlpField {
+	template <typename R>
+	static size_t size(const R &p_record) { return tx_field_size(p_record.*Member); }
+
+	template <typename R>
+	static uint8_t *write(uint8_t *r_out, const R &p_record) { return tx_field_write(r_out, p_record.*Member); }
+
+	template <typename R>
+	static bool read(const eth_rlp_item &p_item, R &r_record) { return tx_field_read(p_item, r_record.*Member); }
+};
+
+// Always the empty string, e.g. the trailing 0, 0 of the EIP-155 signing payload.
+struct RlpEmptyField {
+	template <typename R>
+	static size_t size(const R &) { return 1; }
+
+	template <typename R>
+	static uint8_t *write(uint8_t *r_out, const R &) {
+		*r_out = 0x80;
+		return r_out + 1;
+	}
+
+	template <typename R>
+	static bool read(const eth_rlp_item &p_item, R &) { return !p_item.is_list && p_item.len == 0; }
+};
+
+template <typename... Fields>
+struct RlpSchema {
+	static constexpr int FIELD_COUNT = sizeof...(Fields);
+
+	// The schema extended with more fields, e.g. the signature values.
+	template <typename... More>
+	using Append = RlpSchema<Fields..., More...>;
+
+	template <typename R>
+	static size_t payload_size(const R &p_record) {
+		return (Fields::size(p_record) + ... + 0);
+	}
+
+	// Size of the envelope: type byte (typed transactions only) and RLP list.
+	template <typename R>
+	static size_t encoded_size(const R &p_record, int p_type) {
+		return (p_type != TX_TYPE_LEGACY ? 1 : 0) + eth_rlp_sizeof_list(payload_size(p_record));
+	}
+
+	// r_out must have encoded_size() bytes available.
+	template <typename R>
+	static uint8_t *write(uint8_t *r_out, const R &p_record, int p_type) {
+		if (p_type != TX_TYPE_LEGACY) {
+			*r_out++ = (uint8_t)p_type;
+		}
+		r_out = eth_rlp_put_list(r_out, payload_size(p_record));
+		((r_out = Fields::write(r_out, p_record)), ...);
+		return r_out;
+	}
+
+	template <typename R>
+	static PackedByteArray encode(const R &p_record, int p_type) {
+		PackedByteArray encoded;
+		encoded.resize(encoded_size(p_record, p_type));
+		write(encoded.ptrw(), p_record, p_type);
+		return encoded;
+	}
+
+	// keccak256 of the envelope, small envelopes are encoded on the stack.
+	template <typename R>
+	static void hash(const R &p_record, int p_type, uint8_t *r_hash) {
+		size_t size = encoded_size(p_record, p_type);
+		uint8_t stack_buffer[1024];
+		LocalVector<uint8_t> heap_buffer;
+		uint8_t *buffer = stack_buffer;
+		if (size > sizeof(stack_buffer)) {
+			heap_buffer.resize(size);
+			buffer = heap_buffer.ptr();
+		}
+		write(buffer, p_record, p_type);
+		eth_keccak256(r_hash, buffer, size);
+	}
+
+	// Reads the items of an already parsed list.
+	template <typename R>
+	static bool read(const eth_rlp_item *p_items, int p_count, R &r_record) {
+		if (p_count != FIELD_COUNT) {
+			return false;
+		}
+		int i = 0;
+		return (Fields::read(p_items[i++], r_record) && ... && true);
+	}
+};
+
+#endif // TX_SCHEMA_H
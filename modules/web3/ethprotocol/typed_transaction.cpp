@@ -0,0 +1,283 @@
+#include "typed_transaction.h"
+
+#include "u256.h"
+
+void TypedTransaction::_invalidate() {
+	m_signing_hash_valid = false;
+	m_signed_encoding = PackedByteArray();
+	m_has_signature = false;
+	m_fields.y_parity = 0;
+	u256_set_zero(m_fields.r);
+	u256_set_zero(m_fields.s);
+}
+
+void TypedTransaction::_invalidate_signature() {
+	m_signed_encoding = PackedByteArray();
+}
+
+bool TypedTransaction::_set_uint(const Ref<BigInt> &p_number, u256 &r_field) {
+	ERR_FAIL_COND_V_MSG(p_number.is_null(), false, "value must not be null");
+	ERR_FAIL_COND_V_MSG(!u256_from_mpz(r_field, p_number->m_number), false, "value must be between 0 and 2^256 - 1");
+	_invalidate();
+	return true;
+}
+
+Ref<BigInt> TypedTransaction::_to_big_int(const u256 &p_value) {
+	Ref<BigInt> number = Ref<BigInt>(memnew(BigInt));
+	u256_to_mpz(number->m_number, p_value);
+	return number;
+}
+
+int TypedTransaction::get_tx_type() const {
+	return _get_type();
+}
+
+void TypedTransaction::set_chain_id(Ref<BigInt> chain_id) {
+	_set_uint(chain_id, m_fields.chain_id);
+}
+
+void TypedTransaction::set_nonce(uint64_t nonce) {
+	m_fields.nonce = nonce;
+	_invalidate();
+}
+
+void TypedTransaction::set_gas_limit(uint64_t gas_limit) {
+	m_fields.gas_limit = gas_limit;
+	_invalidate();
+}
+
+void TypedTransaction::set_to_address(String to) {
+	if (to.is_empty()) {
+		m_fields.to.present = false;
+		_invalidate();
+		return;
+	}
+	uint8_t to_bytes[20];
+	ERR_FAIL_COND_MSG(!TransactionDecoder::parse_hex(to, to_bytes, 20), "Invalid to address: " + to);
+	m_fields.to.present = true;
+	memcpy(m_fields.to.bytes, to_bytes, 20);
+	_invalidate();
+}
+
+void TypedTransaction::set_value(Ref<BigInt> value) {
+	_set_uint(value, m_fields.value);
+}
+
+void TypedTransaction::set_data(PackedByteArray data) {
+	m_fields.data = data;
+	_invalidate();
+}
+
+void TypedTransaction::set_access_list(Array access_list) {
+	// Encoded once here, the list is then copied as is into every encoding.
+	LocalVector<uint8_t> payload;
+	for (int i = 0; i < access_list.size(); i++) {
+		Dictionary tuple = access_list[i];
+		uint8_t address[20];
+		ERR_FAIL_COND_MSG(!TransactionDecoder::parse_hex(tuple.get("address", String()), address, 20), "Invalid access list address");
+		Array keys = tuple.get("storageKeys", Array());
+
+		size_t keys_len = keys.size() * 33;
+		size_t entry_len = 21 + eth_rlp_sizeof_list(keys_len);
+		size_t offset = payload.size();
+		payload.resize(offset + eth_rlp_sizeof_list(entry_len));
+
+		uint8_t *out = eth_rlp_put_list(payload.ptr() + offset, entry_len);
+		out = eth_rlp_put_bytes(out, address, 20);
+		out = eth_rlp_put_list(out, keys_len);
+		for (int k = 0; k < keys.size(); k++) {
+			uint8_t key[32];
+			ERR_FAIL_COND_MSG(!TransactionDecoder::parse_hex(keys[k], key, 32), "Invalid access list storage key");
+			out = eth_rlp_put_bytes(out, key, 32);
+		}
+	}
+
+	m_fields.access_list.payload.resize(payload.size());
+	if (payload.size() > 0) {
+		memcpy(m_fields.access_list.payload.ptrw(), payload.ptr(), payload.size());
+	}
+	_invalidate();
+}
+
+Ref<BigInt> TypedTransaction::get_chain_id() const {
+	return _to_big_int(m_fields.chain_id);
+}
+
+uint64_t TypedTransaction::get_nonce() const {
+	return m_fields.nonce;
+}
+
+uint64_t TypedTransaction::get_gas_limit() const {
+	return m_fields.gas_limit;
+}
+
+String TypedTransaction::get_to_address() const {
+	return m_fields.to.present ? TransactionDecoder::address_to_hex(m_fields.to.bytes) : String();
+}
+
+Ref<BigInt> TypedTransaction::get_value() const {
+	return _to_big_int(m_fields.value);
+}
+
+PackedByteArray TypedTransaction::get_data() const {
+	return m_fields.data;
+}
+
+Array TypedTransaction::get_access_list() const {
+	eth_rlp_item list;
+	list.raw = nullptr;
+	list.raw_len = 0;
+	list.payload = m_fields.access_list.payload.ptr();
+	list.len = m_fields.access_list.payload.size();
+	list.is_list = 1;
+
+	Array result;
+	TransactionDecoder::access_list_to_array(list, result);
+	return result;
+}
+
+int TypedTransaction::get_y_parity() const {
+	return (int)m_fields.y_parity;
+}
+
+Ref<BigInt> TypedTransaction::get_sign_r() const {
+	return _to_big_int(m_fields.r);
+}
+
+Ref<BigInt> TypedTransaction::get_sign_s() const {
+	return _to_big_int(m_fields.s);
+}
+
+const uint8_t *TypedTransaction::_get_signing_hash() const {
+	if (!m_signing_hash_valid) {
+		ERR_FAIL_COND_V_MSG(u256_is_zero(m_fields.chain_id), nullptr, "rlp format failed: chain id should not be zero");
+		_hash(m_signing_hash);
+		m_signing_hash_valid = true;
+	}
+	return m_signing_hash;
+}
+
+const PackedByteArray &TypedTransaction::_get_signed_encoding() const {
+	if (m_signed_encoding.is_empty() && m_has_signature) {
+		m_signed_encoding = _encode(true);
+	}
+	return m_signed_encoding;
+}
+
+PackedByteArray TypedTransaction::rlp_hash() {
+	const uint8_t *hash = _get_signing_hash();
+	if (hash == nullptr) {
+		return PackedByteArray();
+	}
+
+	PackedByteArray result;
+	result.resize(32);
+	memcpy(result.ptrw(), hash, 32);
+	return result;
+}
+
+PackedByteArray TypedTransaction::rlp_encode() {
+	return _encode(false);
+}
+
+PackedByteArray TypedTransaction::hash() {
+	const PackedByteArray &encoded = _get_signed_encoding();
+	ERR_FAIL_COND_V_MSG(encoded.is_empty(), PackedByteArray(), "transaction is not signed");
+
+	PackedByteArray result;
+	result.resize(32);
+	eth_keccak256(result.ptrw(), encoded.ptr(), encoded.size());
+	return result;
+}
+
+int TypedTransaction::_apply_signature(const uint8_t *p_signature) {
+	// Typed transactions carry the recovery id as is (y parity), no chain id in v.
+	u256_from_be_bytes(m_fields.r, p_signature, 32);
+	u256_from_be_bytes(m_fields.s, p_signature + 32, 32);
+	m_fields.y_parity = p_signature[64];
+	m_has_signature = true;
+	_invalidate_signature();
+	return 0;
+}
+
+int TypedTransaction::sign_tx(Ref<Secp256k1Wrapper> signer) {
+	ERR_FAIL_COND_V(signer.is_null(), -1);
+	PackedByteArray hash = rlp_hash();
+	if (hash.size() != 32) {
+		return -1;
+	}
+	PackedByteArray signature = signer->sign(hash);
+	if (signature.size() != 65) {
+		return -1;
+	}
+	return _apply_signature(signature.ptr());
+}
+
+int TypedTransaction::sign_tx_by_account(Ref<EthAccount> signer) {
+	ERR_FAIL_COND_V(signer.is_null(), -1);
+	const uint8_t *hash = _get_signing_hash();
+	if (hash == nullptr) {
+		return -1;
+	}
+	uint8_t signature[65];
+	if (!signer->sign_hash32(hash, signature)) {
+		return -1;
+	}
+	return _apply_signature(signature);
+}
+
+String TypedTransaction::signedtx_marshal_binary() {
+	const PackedByteArray &encoded = _get_signed_encoding();
+	ERR_FAIL_COND_V_MSG(encoded.is_empty(), String(), "transaction is not signed");
+	return "0x" + String::hex_encode_buffer(encoded.ptr(), encoded.size());
+}
+
+String TypedTransaction::recover_sender() const {
+	const PackedByteArray &encoded = _get_signed_encoding();
+	ERR_FAIL_COND_V_MSG(encoded.is_empty(), String(), "transaction is not signed");
+	uint8_t address[20];
+	ERR_FAIL_COND_V_MSG(!TransactionDecoder::recover_address(nullptr, encoded.ptr(), encoded.size(), address), String(), "Failed to recover sender");
+	return TransactionDecoder::address_to_hex(address);
+}
+
+bool TypedTransaction::_decode_raw(const PackedByteArray &p_raw) {
+	TransactionDecoder::RawTx tx;
+	ERR_FAIL_COND_V_MSG(!TransactionDecoder::parse(p_raw.ptr(), p_raw.size(), tx), false, "Invalid raw transaction");
+	ERR_FAIL_COND_V_MSG(tx.type != _get_type(), false, vformat("Expected a type %d transaction, got type %d", _get_type(), tx.type));
+	_invalidate();
+	ERR_FAIL_COND_V_MSG(!_read(tx.fields, tx.field_count), false, "Invalid transaction fields");
+	ERR_FAIL_COND_V_MSG(m_fields.y_parity > 1, false, "Invalid y parity");
+	m_has_signature = true;
+	return true;
+}
+
+void TypedTransaction::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_tx_type"), &TypedTransaction::get_tx_type);
+
+	ClassDB::bind_method(D_METHOD("set_chain_id", "chain_id"), &TypedTransaction::set_chain_id);
+	ClassDB::bind_method(D_METHOD("get_chain_id"), &TypedTransaction::get_chain_id);
+	ClassDB::bind_method(D_METHOD("set_nonce", "nonce"), &TypedTransaction::set_nonce);
+	ClassDB::bind_method(D_METHOD("get_nonce"), &TypedTransaction::get_nonce);
+	ClassDB::bind_method(D_METHOD("set_gas_limit", "gas_limit"), &TypedTransaction::set_gas_limit);
+	ClassDB::bind_method(D_METHOD("get_gas_limit"), &TypedTransaction::get_gas_limit);
+	ClassDB::bind_method(D_METHOD("set_to_address", "to"), &TypedTransaction::set_to_address);
+	ClassDB::bind_method(D_METHOD("get_to_address"), &TypedTransaction::get_to_address);
+	ClassDB::bind_method(D_METHOD("set_value", "value"), &TypedTransaction::set_value);
+	ClassDB::bind_method(D_METHOD("get_value"), &TypedTransaction::get_value);
+	ClassDB::bind_method(D_METHOD("set_data", "data"), &TypedTransaction::set_data);
+	ClassDB::bind_method(D_METHOD("get_data"), &TypedTransaction::get_data);
+	ClassDB::bind_method(D_METHOD("set_access_list", "access_list"), &TypedTransaction::set_access_list);
+	ClassDB::bind_method(D_METHOD("get_access_list"), &TypedTransaction::get_access_list);
+
+	ClassDB::bind_method(D_METHOD("get_y_parity"), &TypedTransaction::get_y_parity);
+	ClassDB::bind_method(D_METHOD("get_sign_r"), &TypedTransaction::get_sign_r);
+	ClassDB::bind_method(D_METHOD("get_sign_s"), &TypedTransaction::get_sign_s);
+
+	ClassDB::bind_method(D_METHOD("rlp_hash"), &TypedTransaction::rlp_hash);
+	ClassDB::bind_method(D_METHOD("rlp_encode"), &TypedTransaction::rlp_encode);
+	ClassDB::bind_method(D_METHOD("hash"), &TypedTransaction::hash);
+	ClassDB::bind_method(D_METHOD("sign_tx", "signer"), &TypedTransaction::sign_tx);
+	ClassDB::bind_method(D_METHOD("sign_tx_by_account", "signer"), &TypedTransaction::sign_tx_by_account);
+	ClassDB::bind_method(D_METHOD("signedtx_marshal_binary"), &TypedTransaction::signedtx_marshal_binary);
+	ClassDB::bind_method(D_METHOD("recover_sender"), &TypedTransaction::recover_sender);
+}
@@ -0,0 +1,133 @@
+#ifndef TYPED_TRANSACTION_H
+#define TYPED_TRANSACTION_H
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/variant/array.h"
+#include "core/variant/variant.h"
+
+#include "big_int.h"
+#include "eth_account_wrapper.h"
+#include "secp256k1_wrapper.h"
+#include "transaction_decoder.h"
+#include "tx_schema.h"
+
+// Common part of the EIP-2718 typed transactions (AccessListTx, DynamicFeeTx).
+// Subclasses only describe their RLP schema, encoding, hashing and decoding
+// are generated from it by TypedTransactionSchema. Values are copied into fixed-width fields when set,
+// getters return new BigInt objects.
+class TypedTransaction : public RefCounted {
+	GDCLASS(TypedTransaction, RefCounted);
+
+public:
+	// Union of the fields of the supported types, each schema picks its own.
+	struct Fields {
+		u256 chain_id = {};
+		uint64_t nonce = 0;
+		u256 gas_price = {}; // EIP-2930
+		u256 max_priority_fee_per_gas = {}; // EIP-1559
+		u256 max_fee_per_gas = {}; // EIP-1559
+		uint64_t gas_limit = 0;
+		TxAddress to;
+		u256 value = {};
+		PackedByteArray data;
+		TxAccessList access_list;
+		uint64_t y_parity = 0;
+		u256 r = {};
+		u256 s = {};
+	};
+
+protected:
+	Fields m_fields;
+	bool m_has_signature = false;
+
+	// Cached signing hash and signed envelope, cleared when a field changes.
+	mutable bool m_signing_hash_valid = false;
+	mutable uint8_t m_signing_hash[32];
+	mutable PackedByteArray m_signed_encoding;
+
+	virtual int _get_type() const = 0;
+	// Signing payload (p_signed false) or signed envelope, type byte included.
+	virtual PackedByteArray _encode(bool p_signed) const = 0;
+	// Hash of the signing payload.
+	virtual void _hash(uint8_t *r_hash) const = 0;
+	virtual bool _read(const eth_rlp_item *p_items, int p_count) = 0;
+
+	// Drops the cached encodings and the signature, which no longer matches.
+	void _invalidate();
+	void _invalidate_signature();
+	bool _set_uint(const Ref<BigInt> &p_number, u256 &r_field);
+	static Ref<BigInt> _to_big_int(const u256 &p_value);
+	const uint8_t *_get_signing_hash() const;
+	const PackedByteArray &_get_signed_encoding() const;
+	int _apply_signature(const uint8_t *p_signature);
+	bool _decode_raw(const PackedByteArray &p_raw);
+
+	static void _bind_methods();
+
+public:
+	int get_tx_type() const;
+
+	void set_chain_id(Ref<BigInt> chain_id);
+	void set_nonce(uint64_t nonce);
+	void set_gas_limit(uint64_t gas_limit);
+	void set_to_address(String to);
+	void set_value(Ref<BigInt> value);
+	void set_data(PackedByteArray data);
+	// access_list is [{"address": String, "storageKeys": [String, ...]}, ...].
+	void set_access_list(Array access_list);
+
+	Ref<BigInt> get_chain_id() const;
+	uint64_t get_nonce() const;
+	uint64_t get_gas_limit() const;
+	String get_to_address() const;
+	Ref<BigInt> get_value() const;
+	PackedByteArray get_data() const;
+	Array get_access_list() const;
+	int get_y_parity() const;
+	Ref<BigInt> get_sign_r() const;
+	Ref<BigInt> get_sign_s() const;
+
+	// Hash and encoding of the signing payload: type || rlp(fields).
+	PackedByteArray rlp_hash();
+	PackedByteArray rlp_encode();
+
+	// Hash of the signed transaction, empty until signed.
+	PackedByteArray hash();
+
+	int sign_tx(Ref<Secp256k1Wrapper> signer);
+	int sign_tx_by_account(Ref<EthAccount> signer);
+	String signedtx_marshal_binary();
+	String recover_sender() const;
+
+	TypedTransaction() {}
+	virtual ~TypedTransaction() {}
+};
+
+// Implements the codec of a TypedTransaction subclass T from T::TYPE,
+// T::SigningSchema and T::SignedSchema:
+//
+//     class DynamicFeeTx : public TypedTransactionSchema<DynamicFeeTx> {
+//         GDCLASS(DynamicFeeTx, TypedTransaction);
+template <typename T>
+class TypedTransactionSchema : public TypedTransaction {
+protected:
+	virtual int _get_type() const override {
+		return T::TYPE;
+	}
+
+	virtual PackedByteArray _encode(bool p_signed) const override {
+		return p_signed ? T::SignedSchema::encode(m_fields, T::TYPE) : T::SigningSchema::encode(m_fields, T::TYPE);
+	}
+
+	virtual void _hash(uint8_t *r_hash) const override {
+		T::SigningSchema::hash(m_fields, T::TYPE, r_hash);
+	}
+
+	virtual bool _read(const eth_rlp_item *p_items, int p_count) override {
+		return T::SignedSchema::read(p_items, p_count, m_fields);
+	}
+};
+
+#endif // TYPED_TRANSACTION_H
@@ -0,0 +1,62 @@
+#include "keccak_hasher.h"
+
+KeccakHasher::KeccakHasher() {
+	reset();
+}
+
+void KeccakHasher::reset() {
+	eth_keccak256_init(&m_ctx);
+	m_finalized = false;
+}
+
+void KeccakHasher::update(const PackedByteArray &data) {
+	ERR_FAIL_COND_MSG(m_finalized, "Hasher is finalized, call reset() first.");
+	eth_keccak256_update(&m_ctx, data.ptr(), data.size());
+}
+
+void KeccakHasher::update_range(const PackedByteArray &data, int offset, int length) {
+	ERR_FAIL_COND_MSG(m_finalized, "Hasher is finalized, call reset() first.");
+	if (length < 0) {
+		length = data.size() - offset;
+	}
+	ERR_FAIL_COND_MSG(offset < 0 || length < 0 || offset > data.size() - length, vformat("Range [%d, %d) is out of the %d bytes of data.", offset, offset + length, data.size()));
+	if (length > 0) {
+		eth_keccak256_update(&m_ctx, data.ptr() + offset, length);
+	}
+}
+
+void KeccakHasher::update_string(const String &text) {
+	ERR_FAIL_COND_MSG(m_finalized, "Hasher is finalized, call reset() first.");
+	CharString utf8 = text.utf8();
+	eth_keccak256_update(&m_ctx, (const uint8_t *)utf8.get_data(), utf8.length());
+}
+
+PackedByteArray KeccakHasher::finalize() {
+	ERR_FAIL_COND_V_MSG(m_finalized, PackedByteArray(), "Hasher is finalized, call reset() first.");
+	PackedByteArray result;
+	result.resize(32);
+	eth_keccak256_final(&m_ctx, result.ptrw());
+	m_finalized = true;
+	return result;
+}
+
+bool KeccakHasher::is_finalized() const {
+	return m_finalized;
+}
+
+Ref<KeccakHasher> KeccakHasher::clone() const {
+	Ref<KeccakHasher> copy = Ref<KeccakHasher>(memnew(KeccakHasher));
+	copy->m_ctx = m_ctx;
+	copy->m_finalized = m_finalized;
+	return copy;
+}
+
+void KeccakHasher::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("reset"), &KeccakHasher::reset);
+	ClassDB::bind_method(D_METHOD("update", "data"), &KeccakHasher::update);
+	ClassDB::bind_method(D_METHOD("update_range", "data", "offset", "length"), &KeccakHasher::update_range, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("update_string", "text"), &KeccakHasher::update_string);
+	ClassDB::bind_method(D_METHOD("finalize"), &KeccakHasher::finalize);
+	ClassDB::bind_method(D_METHOD("is_finalized"), &KeccakHasher::is_finalized);
+	ClassDB::bind_method(D_METHOD("clone"), &KeccakHasher::clone);
+}
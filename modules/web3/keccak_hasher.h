@@ -0,0 +1,61 @@
+#ifndef KECCAK_HASHER_H
+#define KECCAK_HASHER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "keccak256.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+
+// Incremental keccak256: hashes data given in pieces (large calldata, ABI
+// packed fields, file chunks) without concatenating it first. A hasher can
+// be cloned to hash several messages sharing a prefix.
+class KeccakHasher : public RefCounted {
+	GDCLASS(KeccakHasher, RefCounted);
+
+private:
+	eth_keccak256_ctx m_ctx;
+	bool m_finalized = false;
+
+protected:
+	static void _bind_methods();
+
+public:
+	KeccakHasher();
+
+	// Starts a new hash.
+	void reset();
+
+	void update(const PackedByteArray &data);
+
+	/**
+	 * @brief  Absorbs data[offset, offset + length), length -1 for the rest
+	 *         of data.
+	 */
+	void update_range(const PackedByteArray &data, int offset, int length = -1);
+
+	// Absorbs the UTF-8 encoding of text.
+	void update_string(const String &text);
+
+	/**
+	 * @brief  Returns the 32-byte hash of everything absorbed. The hasher
+	 *         must be reset before being updated again.
+	 */
+	PackedByteArray finalize();
+
+	bool is_finalized() const;
+
+	// A hasher in the same state, updating one does not affect the other.
+	Ref<KeccakHasher> clone() const;
+};
+
+#endif // KECCAK_HASHER_H
@@ -25,7 +25,59 @@ PackedByteArray KeccakWrapper::keccak256_hash(const PackedByteArray &data) {
 	return result;
 }
 
+PackedByteArray KeccakWrapper::keccak256_hash_batch(const Array &inputs) {
+	PackedByteArray result;
+	int count = inputs.size();
+	if (count == 0) {
+		return result;
+	}
+
+	// Keeps the buffers referenced while their pointers are used.
+	LocalVector<PackedByteArray> buffers;
+	LocalVector<const uint8_t *> ptrs;
+	LocalVector<size_t> lens;
+	buffers.resize(count);
+	ptrs.resize(count);
+	lens.resize(count);
+	for (int i = 0; i < count; i++) {
+		ERR_FAIL_COND_V_MSG(inputs[i].get_type() != Variant::PACKED_BYTE_ARRAY, PackedByteArray(), vformat("Input %d is not a PackedByteArray", i));
+		buffers[i] = inputs[i];
+		ptrs[i] = buffers[i].ptr();
+		lens[i] = buffers[i].size();
+	}
+
+	result.resize(count * 32);
+	ERR_FAIL_COND_V(eth_keccak256_batch(result.ptrw(), ptrs.ptr(), lens.ptr(), count) < 0, PackedByteArray());
+	return result;
+}
+
+PackedByteArray KeccakWrapper::keccak256_hash_packed(const PackedByteArray &data, const PackedInt32Array &offsets) {
+	PackedByteArray result;
+	int count = offsets.size();
+	if (count == 0) {
+		return result;
+	}
+
+	LocalVector<const uint8_t *> ptrs;
+	LocalVector<size_t> lens;
+	ptrs.resize(count);
+	lens.resize(count);
+	for (int i = 0; i < count; i++) {
+		int start = offsets[i];
+		int end = i + 1 < count ? offsets[i + 1] : data.size();
+		ERR_FAIL_COND_V_MSG(start < 0 || start > end || end > data.size(), PackedByteArray(), vformat("Invalid offset %d at index %d", start, i));
+		ptrs[i] = data.ptr() + start;
+		lens[i] = end - start;
+	}
+
+	result.resize(count * 32);
+	ERR_FAIL_COND_V(eth_keccak256_batch(result.ptrw(), ptrs.ptr(), lens.ptr(), count) < 0, PackedByteArray());
+	return result;
+}
+
 void KeccakWrapper::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("keccak256_hash", "data"), &KeccakWrapper::keccak256_hash);
+	ClassDB::bind_method(D_METHOD("keccak256_hash_batch", "inputs"), &KeccakWrapper::keccak256_hash_batch);
+	ClassDB::bind_method(D_METHOD("keccak256_hash_packed", "data", "offsets"), &KeccakWrapper::keccak256_hash_packed);
 }
 
@@ -18,6 +18,7 @@ extern "C" {
 // #include <gmp.h>
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/string/ustring.h"
 #include "core/variant/array.h"
 #include "core/variant/variant.h"
@@ -36,6 +37,20 @@ public:
 	~KeccakWrapper();
 
 	PackedByteArray keccak256_hash(const PackedByteArray &data);
+
+	/**
+	 * @brief  Hashes every PackedByteArray of inputs in one call, four at a
+	 *         time when consecutive inputs have similar sizes.
+	 * @return The 32-byte hashes concatenated in input order, empty on error.
+	 */
+	PackedByteArray keccak256_hash_batch(const Array &inputs);
+
+	/**
+	 * @brief  Same as keccak256_hash_batch for inputs packed in one buffer:
+	 *         input i is data[offsets[i]] up to offsets[i + 1], the last one
+	 *         up to the end of data.
+	 */
+	PackedByteArray keccak256_hash_packed(const PackedByteArray &data, const PackedInt32Array &offsets);
 };
 
 #endif // KECCAK_H
@@ -21,7 +21,16 @@ Please refer to SnP-documentation.h for more details.
 #ifndef _KeccakP_1600_SnP_h_
 #define _KeccakP_1600_SnP_h_
 
+#include <stddef.h>
+
+/* KeccakP-1600-opt64.c is built by default, KeccakP-1600-compact64.c when
+   KeccakP1600_useCompact64 is defined (SCsub option web3_keccak=compact64). */
+#if defined(KeccakP1600_useCompact64)
 #define KeccakP1600_implementation      "64-bit compact implementation"
+#else
+#define KeccakP1600_implementation      "generic 64-bit optimized implementation (lane complementing, 2 rounds unrolled)"
+#define KeccakF1600_FastLoop_supported
+#endif
 #define KeccakP1600_stateSizeInBytes    200
 #define KeccakP1600_stateAlignment      8
 
@@ -36,5 +45,8 @@ void KeccakP1600_Permute_12rounds(void *state);
 void KeccakP1600_Permute_24rounds(void *state);
 void KeccakP1600_ExtractBytes(const void *state, unsigned char *data, unsigned int offset, unsigned int length);
 void KeccakP1600_ExtractAndAddBytes(const void *state, const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length);
+#if defined(KeccakF1600_FastLoop_supported)
+size_t KeccakF1600_FastLoop_Absorb(void *state, unsigned int laneCount, const unsigned char *data, size_t dataByteLen);
+#endif
 
 #endif
@@ -0,0 +1,473 @@
+/*
+The eXtended Keccak Code Package (XKCP)
+https://github.com/XKCP/XKCP
+
+The Keccak-p permutations, designed by Guido Bertoni, Joan Daemen, Michaël Peeters and Gilles Van Assche.
+
+Implementation by Gilles Van Assche and Ronny Van Keer, hereby denoted as "the implementer".
+
+For more information, feedback or questions, please refer to the Keccak Team website:
+https://keccak.team/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+
+---
+
+This file implements Keccak-p[1600] in a SnP-compatible way.
+Please refer to SnP-documentation.h for more details.
+
+This is the generic 64-bit optimized implementation: the state is kept in
+25 local variables, two rounds are unrolled per loop iteration (so that no
+copy is needed between rounds), and the lane complementing transform
+("bebigokimisa") replaces 19 of the 25 NOT operations of chi by OR/ANDN
+forms. With lane complementing, lanes 1, 2, 8, 12, 17 and 20 are stored
+complemented in the state; the SnP functions below take care of it so the
+state layout is invisible to the sponge.
+
+This implementation comes with KeccakP-1600-SnP.h in the same folder and
+replaces KeccakP-1600-compact64.c (only one of the two is built, see SCsub).
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "brg_endian.h"
+#include "KeccakP-1600-SnP.h"
+#include "SnP-Relaned.h"
+
+typedef uint64_t tKeccakLane;
+
+#if defined(_MSC_VER)
+#define ROL64(a, offset) _rotl64(a, offset)
+#else
+#define ROL64(a, offset) ((((uint64_t)a) << offset) ^ (((uint64_t)a) >> (64-offset)))
+#endif
+
+/* Lanes stored complemented in the state: be, bi, go, ki, mi, sa. */
+#define KeccakP1600_IsComplemented(lanePosition) \
+    (((lanePosition) == 1) || ((lanePosition) == 2) || ((lanePosition) == 8) || \
+     ((lanePosition) == 12) || ((lanePosition) == 17) || ((lanePosition) == 20))
+
+static const uint64_t KeccakF1600RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/* ---------------------------------------------------------------- */
+
+#define declareABCDE \
+    uint64_t Aba, Abe, Abi, Abo, Abu; \
+    uint64_t Aga, Age, Agi, Ago, Agu; \
+    uint64_t Aka, Ake, Aki, Ako, Aku; \
+    uint64_t Ama, Ame, Ami, Amo, Amu; \
+    uint64_t Asa, Ase, Asi, Aso, Asu; \
+    uint64_t Bba, Bbe, Bbi, Bbo, Bbu; \
+    uint64_t Bga, Bge, Bgi, Bgo, Bgu; \
+    uint64_t Bka, Bke, Bki, Bko, Bku; \
+    uint64_t Bma, Bme, Bmi, Bmo, Bmu; \
+    uint64_t Bsa, Bse, Bsi, Bso, Bsu; \
+    uint64_t Ca, Ce, Ci, Co, Cu; \
+    uint64_t Da, De, Di, Do, Du; \
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu; \
+    uint64_t Ega, Ege, Egi, Ego, Egu; \
+    uint64_t Eka, Eke, Eki, Eko, Eku; \
+    uint64_t Ema, Eme, Emi, Emo, Emu; \
+    uint64_t Esa, Ese, Esi, Eso, Esu;
+
+#define copyFromState(X, state) \
+    X##ba = state[ 0]; X##be = state[ 1]; X##bi = state[ 2]; X##bo = state[ 3]; X##bu = state[ 4]; \
+    X##ga = state[ 5]; X##ge = state[ 6]; X##gi = state[ 7]; X##go = state[ 8]; X##gu = state[ 9]; \
+    X##ka = state[10]; X##ke = state[11]; X##ki = state[12]; X##ko = state[13]; X##ku = state[14]; \
+    X##ma = state[15]; X##me = state[16]; X##mi = state[17]; X##mo = state[18]; X##mu = state[19]; \
+    X##sa = state[20]; X##se = state[21]; X##si = state[22]; X##so = state[23]; X##su = state[24];
+
+#define copyToState(state, X) \
+    state[ 0] = X##ba; state[ 1] = X##be; state[ 2] = X##bi; state[ 3] = X##bo; state[ 4] = X##bu; \
+    state[ 5] = X##ga; state[ 6] = X##ge; state[ 7] = X##gi; state[ 8] = X##go; state[ 9] = X##gu; \
+    state[10] = X##ka; state[11] = X##ke; state[12] = X##ki; state[13] = X##ko; state[14] = X##ku; \
+    state[15] = X##ma; state[16] = X##me; state[17] = X##mi; state[18] = X##mo; state[19] = X##mu; \
+    state[20] = X##sa; state[21] = X##se; state[22] = X##si; state[23] = X##so; state[24] = X##su;
+
+#define copyStateVariables(X, Y) \
+    X##ba = Y##ba; X##be = Y##be; X##bi = Y##bi; X##bo = Y##bo; X##bu = Y##bu; \
+    X##ga = Y##ga; X##ge = Y##ge; X##gi = Y##gi; X##go = Y##go; X##gu = Y##gu; \
+    X##ka = Y##ka; X##ke = Y##ke; X##ki = Y##ki; X##ko = Y##ko; X##ku = Y##ku; \
+    X##ma = Y##ma; X##me = Y##me; X##mi = Y##mi; X##mo = Y##mo; X##mu = Y##mu; \
+    X##sa = Y##sa; X##se = Y##se; X##si = Y##si; X##so = Y##so; X##su = Y##su;
+
+/* One round from the lanes A into the lanes E, with lane complementing. */
+#define thetaRhoPiChiIota(i, A, E) \
+    Ca = A##ba^A##ga^A##ka^A##ma^A##sa; \
+    Ce = A##be^A##ge^A##ke^A##me^A##se; \
+    Ci = A##bi^A##gi^A##ki^A##mi^A##si; \
+    Co = A##bo^A##go^A##ko^A##mo^A##so; \
+    Cu = A##bu^A##gu^A##ku^A##mu^A##su; \
+    Da = Cu^ROL64(Ce, 1); \
+    De = Ca^ROL64(Ci, 1); \
+    Di = Ce^ROL64(Co, 1); \
+    Do = Ci^ROL64(Cu, 1); \
+    Du = Co^ROL64(Ca, 1); \
+\
+    Bba = A##ba^Da; \
+    Bbe = ROL64(A##ge^De, 44); \
+    Bbi = ROL64(A##ki^Di, 43); \
+    Bbo = ROL64(A##mo^Do, 21); \
+    Bbu = ROL64(A##su^Du, 14); \
+    E##ba =   Bba ^(  Bbe |  Bbi ); \
+    E##ba ^= KeccakF1600RoundConstants[i]; \
+    E##be =   Bbe ^((~Bbi)|  Bbo ); \
+    E##bi =   Bbi ^(  Bbo &  Bbu ); \
+    E##bo =   Bbo ^(  Bbu |  Bba ); \
+    E##bu =   Bbu ^(  Bba &  Bbe ); \
+\
+    Bga = ROL64(A##bo^Do, 28); \
+    Bge = ROL64(A##gu^Du, 20); \
+    Bgi = ROL64(A##ka^Da, 3); \
+    Bgo = ROL64(A##me^De, 45); \
+    Bgu = ROL64(A##si^Di, 61); \
+    E##ga =   Bga ^(  Bge |  Bgi ); \
+    E##ge =   Bge ^(  Bgi &  Bgo ); \
+    E##gi =   Bgi ^(  Bgo |(~Bgu)); \
+    E##go =   Bgo ^(  Bgu |  Bga ); \
+    E##gu =   Bgu ^(  Bga &  Bge ); \
+\
+    Bka = ROL64(A##be^De, 1); \
+    Bke = ROL64(A##gi^Di, 6); \
+    Bki = ROL64(A##ko^Do, 25); \
+    Bko = ROL64(A##mu^Du, 8); \
+    Bku = ROL64(A##sa^Da, 18); \
+    E##ka =   Bka ^(  Bke |  Bki ); \
+    E##ke =   Bke ^(  Bki &  Bko ); \
+    E##ki =   Bki ^((~Bko)&  Bku ); \
+    E##ko = (~Bko)^(  Bku |  Bka ); \
+    E##ku =   Bku ^(  Bka &  Bke ); \
+\
+    Bma = ROL64(A##bu^Du, 27); \
+    Bme = ROL64(A##ga^Da, 36); \
+    Bmi = ROL64(A##ke^De, 10); \
+    Bmo = ROL64(A##mi^Di, 15); \
+    Bmu = ROL64(A##so^Do, 56); \
+    E##ma =   Bma ^(  Bme &  Bmi ); \
+    E##me =   Bme ^(  Bmi |  Bmo ); \
+    E##mi =   Bmi ^((~Bmo)|  Bmu ); \
+    E##mo = (~Bmo)^(  Bmu &  Bma ); \
+    E##mu =   Bmu ^(  Bma |  Bme ); \
+\
+    Bsa = ROL64(A##bi^Di, 62); \
+    Bse = ROL64(A##go^Do, 55); \
+    Bsi = ROL64(A##ku^Du, 39); \
+    Bso = ROL64(A##ma^Da, 41); \
+    Bsu = ROL64(A##se^De, 2); \
+    E##sa =   Bsa ^((~Bse)&  Bsi ); \
+    E##se = (~Bse)^(  Bsi |  Bso ); \
+    E##si =   Bsi ^(  Bso &  Bsu ); \
+    E##so =   Bso ^(  Bsu |  Bsa ); \
+    E##su =   Bsu ^(  Bsa &  Bse );
+
+/* Rounds from firstRound to 23, two per iteration. */
+#define rounds(firstRound) \
+    { \
+        unsigned int i = (firstRound); \
+        if ((i & 1) != 0) { \
+            thetaRhoPiChiIota(i, A, E) \
+            copyStateVariables(A, E) \
+            i++; \
+        } \
+        for (; i < 24; i += 2) { \
+            thetaRhoPiChiIota(i, A, E) \
+            thetaRhoPiChiIota(i + 1, E, A) \
+        } \
+    }
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_Initialize(void *state)
+{
+    memset(state, 0, 200);
+    ((tKeccakLane*)state)[ 1] = ~(tKeccakLane)0;
+    ((tKeccakLane*)state)[ 2] = ~(tKeccakLane)0;
+    ((tKeccakLane*)state)[ 8] = ~(tKeccakLane)0;
+    ((tKeccakLane*)state)[12] = ~(tKeccakLane)0;
+    ((tKeccakLane*)state)[17] = ~(tKeccakLane)0;
+    ((tKeccakLane*)state)[20] = ~(tKeccakLane)0;
+}
+
+/* ---------------------------------------------------------------- */
+
+/* XOR commutes with the complement, so adding needs no special care. */
+void KeccakP1600_AddBytesInLane(void *state, unsigned int lanePosition, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+#if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
+    unsigned int i;
+    unsigned char *bytes = (unsigned char*)state + lanePosition * 8 + offset;
+    for(i=0; i<length; i++)
+        bytes[i] ^= data[i];
+#else
+    unsigned int i;
+    tKeccakLane lane = 0;
+    for(i=0; i<length; i++)
+        lane |= ((tKeccakLane)data[i]) << ((i+offset)*8);
+    ((tKeccakLane*)state)[lanePosition] ^= lane;
+#endif
+}
+
+/* ---------------------------------------------------------------- */
+
+static inline tKeccakLane KeccakP1600_LoadLane(const unsigned char *data)
+{
+#if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
+    tKeccakLane lane;
+    memcpy(&lane, data, 8);
+    return lane;
+#else
+    return (tKeccakLane)data[0]
+        | ((tKeccakLane)data[1] << 8)
+        | ((tKeccakLane)data[2] << 16)
+        | ((tKeccakLane)data[3] << 24)
+        | ((tKeccakLane)data[4] << 32)
+        | ((tKeccakLane)data[5] << 40)
+        | ((tKeccakLane)data[6] << 48)
+        | ((tKeccakLane)data[7] << 56);
+#endif
+}
+
+static inline void KeccakP1600_StoreLane(unsigned char *data, tKeccakLane lane)
+{
+#if (PLATFORM_BYTE_ORDER == IS_LITTLE_ENDIAN)
+    memcpy(data, &lane, 8);
+#else
+    unsigned int j;
+    for(j=0; j<8; j++)
+        data[j] = (lane >> (8*j)) & 0xFF;
+#endif
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_AddLanes(void *state, const unsigned char *data, unsigned int laneCount)
+{
+    unsigned int i;
+    for(i=0; i<laneCount; i++)
+        ((tKeccakLane*)state)[i] ^= KeccakP1600_LoadLane(data + i*8);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_AddByte(void *state, unsigned char byte, unsigned int offset)
+{
+    uint64_t lane = byte;
+    lane <<= (offset%8)*8;
+    ((uint64_t*)state)[offset/8] ^= lane;
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_AddBytes(void *state, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+    SnP_AddBytes(state, data, offset, length, KeccakP1600_AddLanes, KeccakP1600_AddBytesInLane, 8);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_OverwriteBytesInLane(void *state, unsigned int lanePosition, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+    unsigned int i;
+    tKeccakLane lane = ((tKeccakLane*)state)[lanePosition];
+    tKeccakLane complement = KeccakP1600_IsComplemented(lanePosition) ? 0xFF : 0x00;
+    for(i=0; i<length; i++) {
+        lane &= ~(((tKeccakLane)0xFF) << ((i+offset)*8));
+        lane |= ((tKeccakLane)(data[i] ^ complement)) << ((i+offset)*8);
+    }
+    ((tKeccakLane*)state)[lanePosition] = lane;
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_OverwriteLanes(void *state, const unsigned char *data, unsigned int laneCount)
+{
+    unsigned int i;
+    for(i=0; i<laneCount; i++) {
+        tKeccakLane lane = KeccakP1600_LoadLane(data + i*8);
+        ((tKeccakLane*)state)[i] = KeccakP1600_IsComplemented(i) ? ~lane : lane;
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_OverwriteBytes(void *state, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+    SnP_OverwriteBytes(state, data, offset, length, KeccakP1600_OverwriteLanes, KeccakP1600_OverwriteBytesInLane, 8);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_OverwriteWithZeroes(void *state, unsigned int byteCount)
+{
+    unsigned int i, j;
+    for(i=0; i<byteCount/8; i++)
+        ((tKeccakLane*)state)[i] = KeccakP1600_IsComplemented(i) ? ~(tKeccakLane)0 : 0;
+    if (i < 25) {
+        tKeccakLane lane = ((tKeccakLane*)state)[i];
+        tKeccakLane zero = KeccakP1600_IsComplemented(i) ? ~(tKeccakLane)0 : 0;
+        for(j=0; j<byteCount%8; j++) {
+            lane &= ~(((tKeccakLane)0xFF) << (j*8));
+            lane |= zero & (((tKeccakLane)0xFF) << (j*8));
+        }
+        ((tKeccakLane*)state)[i] = lane;
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_Permute_Nrounds(void *argState, unsigned int nr)
+{
+    declareABCDE
+    tKeccakLane *state = (tKeccakLane*)argState;
+
+    copyFromState(A, state)
+    rounds(24 - nr)
+    copyToState(state, A)
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_Permute_12rounds(void *argState)
+{
+    declareABCDE
+    tKeccakLane *state = (tKeccakLane*)argState;
+
+    copyFromState(A, state)
+    rounds(12)
+    copyToState(state, A)
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_Permute_24rounds(void *argState)
+{
+    declareABCDE
+    tKeccakLane *state = (tKeccakLane*)argState;
+
+    copyFromState(A, state)
+    rounds(0)
+    copyToState(state, A)
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_ExtractBytesInLane(const void *state, unsigned int lanePosition, unsigned char *data, unsigned int offset, unsigned int length)
+{
+    unsigned int i;
+    tKeccakLane lane = ((const tKeccakLane*)state)[lanePosition];
+    if (KeccakP1600_IsComplemented(lanePosition))
+        lane = ~lane;
+    lane >>= offset*8;
+    for(i=0; i<length; i++) {
+        data[i] = lane & 0xFF;
+        lane >>= 8;
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_ExtractLanes(const void *state, unsigned char *data, unsigned int laneCount)
+{
+    unsigned int i;
+    for(i=0; i<laneCount; i++) {
+        tKeccakLane lane = ((const tKeccakLane*)state)[i];
+        KeccakP1600_StoreLane(data + i*8, KeccakP1600_IsComplemented(i) ? ~lane : lane);
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_ExtractBytes(const void *state, unsigned char *data, unsigned int offset, unsigned int length)
+{
+    SnP_ExtractBytes(state, data, offset, length, KeccakP1600_ExtractLanes, KeccakP1600_ExtractBytesInLane, 8);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_ExtractAndAddBytesInLane(const void *state, unsigned int lanePosition, const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length)
+{
+    unsigned int i;
+    tKeccakLane lane = ((const tKeccakLane*)state)[lanePosition];
+    if (KeccakP1600_IsComplemented(lanePosition))
+        lane = ~lane;
+    lane >>= offset*8;
+    for(i=0; i<length; i++) {
+        output[i] = input[i] ^ (lane & 0xFF);
+        lane >>= 8;
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_ExtractAndAddLanes(const void *state, const unsigned char *input, unsigned char *output, unsigned int laneCount)
+{
+    unsigned int i;
+    for(i=0; i<laneCount; i++) {
+        tKeccakLane lane = ((const tKeccakLane*)state)[i];
+        if (KeccakP1600_IsComplemented(i))
+            lane = ~lane;
+        KeccakP1600_StoreLane(output + i*8, KeccakP1600_LoadLane(input + i*8) ^ lane);
+    }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_ExtractAndAddBytes(const void *state, const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length)
+{
+    SnP_ExtractAndAddBytes(state, input, output, offset, length, KeccakP1600_ExtractAndAddLanes, KeccakP1600_ExtractAndAddBytesInLane, 8);
+}
+
+/* ---------------------------------------------------------------- */
+
+/* Absorbs whole blocks of laneCount lanes, keeping the state in registers
+   between blocks. Returns the number of bytes absorbed. */
+size_t KeccakF1600_FastLoop_Absorb(void *argState, unsigned int laneCount, const unsigned char *data, size_t dataByteLen)
+{
+    size_t originalDataByteLen = dataByteLen;
+    declareABCDE
+    tKeccakLane *state = (tKeccakLane*)argState;
+
+    copyFromState(A, state)
+    while(dataByteLen >= laneCount*8) {
+        if (laneCount == 17) {
+            /* Keccak-256 rate, the lanes are added in registers. */
+            Aba ^= KeccakP1600_LoadLane(data +   0);
+            Abe ^= KeccakP1600_LoadLane(data +   8);
+            Abi ^= KeccakP1600_LoadLane(data +  16);
+            Abo ^= KeccakP1600_LoadLane(data +  24);
+            Abu ^= KeccakP1600_LoadLane(data +  32);
+            Aga ^= KeccakP1600_LoadLane(data +  40);
+            Age ^= KeccakP1600_LoadLane(data +  48);
+            Agi ^= KeccakP1600_LoadLane(data +  56);
+            Ago ^= KeccakP1600_LoadLane(data +  64);
+            Agu ^= KeccakP1600_LoadLane(data +  72);
+        Aka ^= KeccakP1600_LoadLane(data +  80);
+        Ake ^= KeccakP1600_LoadLane(data +  88);
+        Aki ^= KeccakP1600_LoadLane(data +  96);
+        Ako ^= KeccakP1600_LoadLane(data + 104);
+        Aku ^= KeccakP1600_LoadLane(data + 112);
+            Ama ^= KeccakP1600_LoadLane(data + 120);
+            Ame ^= KeccakP1600_LoadLane(data + 128);
+        }
+        else {
+            copyToState(state, A)
+            KeccakP1600_AddLanes(state, data, laneCount);
+            copyFromState(A, state)
+        }
+        rounds(0)
+        data += laneCount*8;
+        dataByteLen -= laneCount*8;
+    }
+    copyToState(state, A)
+    return originalDataByteLen - dataByteLen;
+}
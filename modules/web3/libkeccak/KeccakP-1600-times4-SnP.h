@@ -0,0 +1,40 @@
+/*
+The eXtended Keccak Code Package (XKCP)
+https://github.com/XKCP/XKCP
+
+The Keccak-p permutations, designed by Guido Bertoni, Joan Daemen, Michaël Peeters and Gilles Van Assche.
+
+Implementation by Gilles Van Assche and Ronny Van Keer, hereby denoted as "the implementer".
+
+For more information, feedback or questions, please refer to the Keccak Team website:
+https://keccak.team/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+
+---
+
+Please refer to PlSnP-documentation.h for more details.
+
+Only the subset of the parallel SnP interface used by eth_keccak256_batch()
+is provided. The four states are interleaved lane by lane: lane i of
+instance j is the 64-bit word states[i*4 + j], in native byte order, and
+the lanes are not complemented.
+*/
+
+#ifndef _KeccakP_1600_times4_SnP_h_
+#define _KeccakP_1600_times4_SnP_h_
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KeccakP1600times4_implementation        "4-way interleaved implementation (compiler vector extensions, AVX2 when available)"
+#else
+#define KeccakP1600times4_implementation        "4-way interleaved implementation (serial fallback)"
+#endif
+#define KeccakP1600times4_statesSizeInBytes     800
+#define KeccakP1600times4_statesAlignment       32
+
+void KeccakP1600times4_InitializeAll(void *states);
+void KeccakP1600times4_PermuteAll_24rounds(void *states);
+
+#endif
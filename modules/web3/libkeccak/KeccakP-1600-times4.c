@@ -0,0 +1,247 @@
+/*
+The eXtended Keccak Code Package (XKCP)
+https://github.com/XKCP/XKCP
+
+The Keccak-p permutations, designed by Guido Bertoni, Joan Daemen, Michaël Peeters and Gilles Van Assche.
+
+Implementation by Gilles Van Assche and Ronny Van Keer, hereby denoted as "the implementer".
+
+For more information, feedback or questions, please refer to the Keccak Team website:
+https://keccak.team/
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+
+---
+
+This file implements 4 interleaved Keccak-p[1600] instances.
+
+With GCC and Clang, a lane is a vector of four 64-bit words and every
+operation of the round applies to the four instances at once. On x86 the
+permutation is also built for AVX2 and chosen at run time when the CPU
+supports it, other targets use pairs of SSE2/NEON operations. Chi uses the
+plain ANDN form, which SIMD units provide, so the lanes are not complemented.
+Other compilers run the same round serially on each instance.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "KeccakP-1600-times4-SnP.h"
+
+static const uint64_t KeccakF1600RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+typedef uint64_t V256 __attribute__((vector_size(32)));
+#define LANES   4
+#define CONST256(c) ((V256){ (c), (c), (c), (c) })
+#else
+typedef uint64_t V256;
+#define LANES   1
+#define CONST256(c) (c)
+#endif
+
+#define ROL64in256(a, o) (((a) << (o)) ^ ((a) >> (64 - (o))))
+
+#define declareABCDE \
+    V256 Aba, Abe, Abi, Abo, Abu; \
+    V256 Aga, Age, Agi, Ago, Agu; \
+    V256 Aka, Ake, Aki, Ako, Aku; \
+    V256 Ama, Ame, Ami, Amo, Amu; \
+    V256 Asa, Ase, Asi, Aso, Asu; \
+    V256 Bba, Bbe, Bbi, Bbo, Bbu; \
+    V256 Bga, Bge, Bgi, Bgo, Bgu; \
+    V256 Bka, Bke, Bki, Bko, Bku; \
+    V256 Bma, Bme, Bmi, Bmo, Bmu; \
+    V256 Bsa, Bse, Bsi, Bso, Bsu; \
+    V256 Ca, Ce, Ci, Co, Cu; \
+    V256 Da, De, Di, Do, Du; \
+    V256 Eba, Ebe, Ebi, Ebo, Ebu; \
+    V256 Ega, Ege, Egi, Ego, Egu; \
+    V256 Eka, Eke, Eki, Eko, Eku; \
+    V256 Ema, Eme, Emi, Emo, Emu; \
+    V256 Esa, Ese, Esi, Eso, Esu;
+
+/* Lane i is the V256 at lanes + i*LANES. */
+#define copyFromState(X, lanes) \
+    memcpy(&X##ba, lanes +  0*LANES, sizeof(V256)); memcpy(&X##be, lanes +  1*LANES, sizeof(V256)); \
+    memcpy(&X##bi, lanes +  2*LANES, sizeof(V256)); memcpy(&X##bo, lanes +  3*LANES, sizeof(V256)); \
+    memcpy(&X##bu, lanes +  4*LANES, sizeof(V256)); memcpy(&X##ga, lanes +  5*LANES, sizeof(V256)); \
+    memcpy(&X##ge, lanes +  6*LANES, sizeof(V256)); memcpy(&X##gi, lanes +  7*LANES, sizeof(V256)); \
+    memcpy(&X##go, lanes +  8*LANES, sizeof(V256)); memcpy(&X##gu, lanes +  9*LANES, sizeof(V256)); \
+    memcpy(&X##ka, lanes + 10*LANES, sizeof(V256)); memcpy(&X##ke, lanes + 11*LANES, sizeof(V256)); \
+    memcpy(&X##ki, lanes + 12*LANES, sizeof(V256)); memcpy(&X##ko, lanes + 13*LANES, sizeof(V256)); \
+    memcpy(&X##ku, lanes + 14*LANES, sizeof(V256)); memcpy(&X##ma, lanes + 15*LANES, sizeof(V256)); \
+    memcpy(&X##me, lanes + 16*LANES, sizeof(V256)); memcpy(&X##mi, lanes + 17*LANES, sizeof(V256)); \
+    memcpy(&X##mo, lanes + 18*LANES, sizeof(V256)); memcpy(&X##mu, lanes + 19*LANES, sizeof(V256)); \
+    memcpy(&X##sa, lanes + 20*LANES, sizeof(V256)); memcpy(&X##se, lanes + 21*LANES, sizeof(V256)); \
+    memcpy(&X##si, lanes + 22*LANES, sizeof(V256)); memcpy(&X##so, lanes + 23*LANES, sizeof(V256)); \
+    memcpy(&X##su, lanes + 24*LANES, sizeof(V256));
+
+#define copyToState(lanes, X) \
+    memcpy(lanes +  0*LANES, &X##ba, sizeof(V256)); memcpy(lanes +  1*LANES, &X##be, sizeof(V256)); \
+    memcpy(lanes +  2*LANES, &X##bi, sizeof(V256)); memcpy(lanes +  3*LANES, &X##bo, sizeof(V256)); \
+    memcpy(lanes +  4*LANES, &X##bu, sizeof(V256)); memcpy(lanes +  5*LANES, &X##ga, sizeof(V256)); \
+    memcpy(lanes +  6*LANES, &X##ge, sizeof(V256)); memcpy(lanes +  7*LANES, &X##gi, sizeof(V256)); \
+    memcpy(lanes +  8*LANES, &X##go, sizeof(V256)); memcpy(lanes +  9*LANES, &X##gu, sizeof(V256)); \
+    memcpy(lanes + 10*LANES, &X##ka, sizeof(V256)); memcpy(lanes + 11*LANES, &X##ke, sizeof(V256)); \
+    memcpy(lanes + 12*LANES, &X##ki, sizeof(V256)); memcpy(lanes + 13*LANES, &X##ko, sizeof(V256)); \
+    memcpy(lanes + 14*LANES, &X##ku, sizeof(V256)); memcpy(lanes + 15*LANES, &X##ma, sizeof(V256)); \
+    memcpy(lanes + 16*LANES, &X##me, sizeof(V256)); memcpy(lanes + 17*LANES, &X##mi, sizeof(V256)); \
+    memcpy(lanes + 18*LANES, &X##mo, sizeof(V256)); memcpy(lanes + 19*LANES, &X##mu, sizeof(V256)); \
+    memcpy(lanes + 20*LANES, &X##sa, sizeof(V256)); memcpy(lanes + 21*LANES, &X##se, sizeof(V256)); \
+    memcpy(lanes + 22*LANES, &X##si, sizeof(V256)); memcpy(lanes + 23*LANES, &X##so, sizeof(V256)); \
+    memcpy(lanes + 24*LANES, &X##su, sizeof(V256));
+
+#define chi(E, x, B0, B1, B2) E##x = B0 ^ (~B1 & B2);
+
+/* One round from the lanes A into the lanes E. */
+#define thetaRhoPiChiIota(i, A, E) \
+    Ca = A##ba^A##ga^A##ka^A##ma^A##sa; \
+    Ce = A##be^A##ge^A##ke^A##me^A##se; \
+    Ci = A##bi^A##gi^A##ki^A##mi^A##si; \
+    Co = A##bo^A##go^A##ko^A##mo^A##so; \
+    Cu = A##bu^A##gu^A##ku^A##mu^A##su; \
+    Da = Cu^ROL64in256(Ce, 1); \
+    De = Ca^ROL64in256(Ci, 1); \
+    Di = Ce^ROL64in256(Co, 1); \
+    Do = Ci^ROL64in256(Cu, 1); \
+    Du = Co^ROL64in256(Ca, 1); \
+\
+    Bba = A##ba^Da; \
+    Bbe = ROL64in256(A##ge^De, 44); \
+    Bbi = ROL64in256(A##ki^Di, 43); \
+    Bbo = ROL64in256(A##mo^Do, 21); \
+    Bbu = ROL64in256(A##su^Du, 14); \
+    chi(E, ba, Bba, Bbe, Bbi) \
+    E##ba ^= CONST256(KeccakF1600RoundConstants[i]); \
+    chi(E, be, Bbe, Bbi, Bbo) \
+    chi(E, bi, Bbi, Bbo, Bbu) \
+    chi(E, bo, Bbo, Bbu, Bba) \
+    chi(E, bu, Bbu, Bba, Bbe) \
+\
+    Bga = ROL64in256(A##bo^Do, 28); \
+    Bge = ROL64in256(A##gu^Du, 20); \
+    Bgi = ROL64in256(A##ka^Da, 3); \
+    Bgo = ROL64in256(A##me^De, 45); \
+    Bgu = ROL64in256(A##si^Di, 61); \
+    chi(E, ga, Bga, Bge, Bgi) \
+    chi(E, ge, Bge, Bgi, Bgo) \
+    chi(E, gi, Bgi, Bgo, Bgu) \
+    chi(E, go, Bgo, Bgu, Bga) \
+    chi(E, gu, Bgu, Bga, Bge) \
+\
+    Bka = ROL64in256(A##be^De, 1); \
+    Bke = ROL64in256(A##gi^Di, 6); \
+    Bki = ROL64in256(A##ko^Do, 25); \
+    Bko = ROL64in256(A##mu^Du, 8); \
+    Bku = ROL64in256(A##sa^Da, 18); \
+    chi(E, ka, Bka, Bke, Bki) \
+    chi(E, ke, Bke, Bki, Bko) \
+    chi(E, ki, Bki, Bko, Bku) \
+    chi(E, ko, Bko, Bku, Bka) \
+    chi(E, ku, Bku, Bka, Bke) \
+\
+    Bma = ROL64in256(A##bu^Du, 27); \
+    Bme = ROL64in256(A##ga^Da, 36); \
+    Bmi = ROL64in256(A##ke^De, 10); \
+    Bmo = ROL64in256(A##mi^Di, 15); \
+    Bmu = ROL64in256(A##so^Do, 56); \
+    chi(E, ma, Bma, Bme, Bmi) \
+    chi(E, me, Bme, Bmi, Bmo) \
+    chi(E, mi, Bmi, Bmo, Bmu) \
+    chi(E, mo, Bmo, Bmu, Bma) \
+    chi(E, mu, Bmu, Bma, Bme) \
+\
+    Bsa = ROL64in256(A##bi^Di, 62); \
+    Bse = ROL64in256(A##go^Do, 55); \
+    Bsi = ROL64in256(A##ku^Du, 39); \
+    Bso = ROL64in256(A##ma^Da, 41); \
+    Bsu = ROL64in256(A##se^De, 2); \
+    chi(E, sa, Bsa, Bse, Bsi) \
+    chi(E, se, Bse, Bsi, Bso) \
+    chi(E, si, Bsi, Bso, Bsu) \
+    chi(E, so, Bso, Bsu, Bsa) \
+    chi(E, su, Bsu, Bsa, Bse)
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600times4_InitializeAll(void *states)
+{
+    memset(states, 0, KeccakP1600times4_statesSizeInBytes);
+}
+
+/* ---------------------------------------------------------------- */
+
+#define permute24(lanes) \
+    { \
+        declareABCDE \
+        unsigned int i; \
+\
+        copyFromState(A, lanes) \
+        for(i = 0; i < 24; i += 2) { \
+            thetaRhoPiChiIota(i, A, E) \
+            thetaRhoPiChiIota(i + 1, E, A) \
+        } \
+        copyToState(lanes, A) \
+    }
+
+static void KeccakP1600times4_Permute24(uint64_t *lanes)
+{
+    permute24(lanes)
+}
+
+#if (LANES == 4) && (defined(__x86_64__) || defined(__i386__))
+/* Same code built for AVX2, selected at run time when the CPU has it. */
+#define KeccakP1600times4_useAVX2Dispatch
+__attribute__((target("avx2")))
+static void KeccakP1600times4_Permute24_AVX2(uint64_t *lanes)
+{
+    permute24(lanes)
+}
+
+/* Called from worker threads. Every thread computes the same value, so a
+ * relaxed atomic is enough to make the lazy initialization race free. */
+static int KeccakP1600times4_hasAVX2(void)
+{
+    static int hasAVX2 = -1;
+    int value = __atomic_load_n(&hasAVX2, __ATOMIC_RELAXED);
+    if (value < 0) {
+        __builtin_cpu_init();
+        value = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&hasAVX2, value, __ATOMIC_RELAXED);
+    }
+    return value;
+}
+#endif
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600times4_PermuteAll_24rounds(void *states)
+{
+#if defined(KeccakP1600times4_useAVX2Dispatch)
+    if (KeccakP1600times4_hasAVX2())
+        KeccakP1600times4_Permute24_AVX2((uint64_t*)states);
+    else
+        KeccakP1600times4_Permute24((uint64_t*)states);
+#elif (LANES == 4)
+    KeccakP1600times4_Permute24((uint64_t*)states);
+#else
+    uint64_t state[25];
+    unsigned int i, j;
+    for(j = 0; j < 4; j++) {
+        for(i = 0; i < 25; i++)
+            state[i] = ((uint64_t*)states)[i*4 + j];
+        KeccakP1600times4_Permute24(state);
+        for(i = 0; i < 25; i++)
+            ((uint64_t*)states)[i*4 + j] = state[i];
+    }
+#endif
+}
@@ -0,0 +1,37 @@
+#ifndef _SECP256K1_PUBKEY_BATCH_
+# define _SECP256K1_PUBKEY_BATCH_
+
+# include "secp256k1.h"
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/** Compute the serialized public keys of several secret keys.
+ *
+ *  Same result as secp256k1_ec_pubkey_create followed by
+ *  secp256k1_ec_pubkey_serialize for each key, but the conversion to affine
+ *  coordinates is shared: one field inversion per group of keys instead of
+ *  one per key.
+ *
+ *  Returns: 1 when every secret key was valid, 0 otherwise. The output of an
+ *           invalid key is all zero, the other keys are still computed.
+ *  Args:   ctx:     pointer to a context object, initialized for signing (cannot be NULL)
+ *  Out:    output:  pointer to count * 65 bytes (count * 33 when compressed)
+ *  In:     seckeys: pointer to count 32-byte secret keys
+ *          count:   the number of keys
+ *          flags:   SECP256K1_EC_COMPRESSED or SECP256K1_EC_UNCOMPRESSED
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create_batch(
+    const secp256k1_context* ctx,
+    unsigned char *output,
+    const unsigned char *seckeys,
+    size_t count,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif
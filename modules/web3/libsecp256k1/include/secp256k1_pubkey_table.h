@@ -0,0 +1,60 @@
+#ifndef _SECP256K1_PUBKEY_TABLE_
+# define _SECP256K1_PUBKEY_TABLE_
+
+# include "secp256k1.h"
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/** Opaque data structure that holds precomputed multiples of a public key,
+ *  so that verifying signatures made by that key does not have to build the
+ *  per-call table secp256k1_ecdsa_verify uses.
+ *
+ *  The table is allocated by the caller, with secp256k1_pubkey_table_size()
+ *  bytes of memory aligned as returned by malloc. Its contents are
+ *  implementation defined and only valid for the library that built it. A
+ *  built table is only read, so one table can be used by several threads.
+ */
+typedef struct secp256k1_pubkey_table_struct secp256k1_pubkey_table;
+
+/** Returns the number of bytes a secp256k1_pubkey_table needs. */
+SECP256K1_API size_t secp256k1_pubkey_table_size(void);
+
+/** Fill a table with the precomputed multiples of a public key.
+ *
+ *  Returns: 1 when the table was built, 0 otherwise.
+ *  Args: ctx:    a secp256k1 context object
+ *  Out:  table:  a pointer to secp256k1_pubkey_table_size() bytes
+ *  In:   pubkey: the public key the table is built for
+ */
+SECP256K1_API int secp256k1_pubkey_table_build(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_table *table,
+    const secp256k1_pubkey *pubkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Verify an ECDSA signature with the table of the signer's public key.
+ *
+ *  Same result as secp256k1_ecdsa_verify with the public key the table was
+ *  built from, lower-S form is required.
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect or unparseable signature
+ *  Args:    ctx:   a secp256k1 context object, initialized for verification.
+ *  In:      sig:   the signature being verified (cannot be NULL)
+ *           msg32: the 32-byte message hash being verified (cannot be NULL)
+ *           table: the table of the public key to verify with (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_with_table(
+    const secp256k1_context* ctx,
+    const secp256k1_ecdsa_signature *sig,
+    const unsigned char *msg32,
+    const secp256k1_pubkey_table *table
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif
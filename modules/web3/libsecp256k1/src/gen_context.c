@@ -0,0 +1,153 @@
+/**********************************************************************
+ * Copyright (c) 2013, 2014, 2015 Thomas Daede, Cory Fields           *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+/* Host tool writing src/ecmult_static_context.h, the tables used when the
+ * library is built with USE_ECMULT_STATIC_PRECOMPUTATION. Build it with the
+ * same configuration as the library (see secp256k1_wrapper.h) and run it from
+ * the libsecp256k1 directory:
+ *
+ *   cc -O2 -DUSE_NUM_NONE -DUSE_FIELD_INV_BUILTIN -DUSE_SCALAR_INV_BUILTIN \
+ *      -DUSE_FIELD_10X26 -DUSE_SCALAR_8X32 -DUSE_ENDOMORPHISM \
+ *      -Iinclude -Isrc src/gen_context.c -o gen_context && ./gen_context
+ *
+ * The points are written as 32-bit words, so one header serves both field
+ * implementations. */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "secp256k1.h"
+#include "util.h"
+#include "num_impl.h"
+#include "field_impl.h"
+#include "scalar_impl.h"
+#include "group_impl.h"
+#include "ecmult_impl.h"
+#include "ecmult_gen_impl.h"
+
+/* Window of the 2^64 * G and 2^192 * G tables, at most WINDOW_G. */
+#define STATIC_G_64_WINDOW 12
+
+static void default_error_callback_fn(const char* str, void* data) {
+    (void)data;
+    fprintf(stderr, "[libsecp256k1] internal consistency check failed: %s\n", str);
+    abort();
+}
+
+static const secp256k1_callback default_error_callback = {
+    default_error_callback_fn,
+    NULL
+};
+
+static void print_ge_storage(FILE *fp, const secp256k1_ge_storage *ge) {
+    secp256k1_ge_storage s = *ge;
+    uint32_t w[16];
+    int i;
+    secp256k1_fe x, y;
+
+    secp256k1_fe_from_storage(&x, &s.x);
+    secp256k1_fe_from_storage(&y, &s.y);
+    {
+        unsigned char bx[32], by[32];
+        secp256k1_fe_normalize_var(&x);
+        secp256k1_fe_normalize_var(&y);
+        secp256k1_fe_get_b32(bx, &x);
+        secp256k1_fe_get_b32(by, &y);
+        for (i = 0; i < 8; i++) {
+            w[i] = (uint32_t)bx[4*i] << 24 | (uint32_t)bx[4*i+1] << 16 | (uint32_t)bx[4*i+2] << 8 | bx[4*i+3];
+            w[8 + i] = (uint32_t)by[4*i] << 24 | (uint32_t)by[4*i+1] << 16 | (uint32_t)by[4*i+2] << 8 | by[4*i+3];
+        }
+    }
+    fprintf(fp, "SC(");
+    for (i = 0; i < 16; i++) {
+        fprintf(fp, "%" PRIx32 "%s", w[i], i == 15 ? ")" : ",");
+    }
+}
+
+static void print_table(FILE *fp, const char *name, const secp256k1_ge_storage *table, int n) {
+    int i;
+
+    fprintf(fp, "static const secp256k1_ge_storage %s[%d] = {\n", name, n);
+    for (i = 0; i < n; i++) {
+        print_ge_storage(fp, &table[i]);
+        fprintf(fp, "%s\n", i == n - 1 ? "" : ",");
+    }
+    fprintf(fp, "};\n");
+}
+
+int main(int argc, char **argv) {
+    secp256k1_ecmult_gen_context gen_ctx;
+    secp256k1_ecmult_context ctx;
+    const char *path = argc > 1 ? argv[1] : "src/ecmult_static_context.h";
+    int inner, outer;
+    FILE* fp;
+
+    fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "Could not open %s for writing!\n", path);
+        return -1;
+    }
+
+    fprintf(fp, "/* This file was automatically generated by gen_context.c, do not edit. */\n");
+    fprintf(fp, "#ifndef _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
+    fprintf(fp, "#define _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
+    fprintf(fp, "#include \"group.h\"\n");
+    fprintf(fp, "#define SC(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p) SECP256K1_GE_STORAGE_CONST(0x##a##u,0x##b##u,0x##c##u,0x##d##u,0x##e##u,0x##f##u,0x##g##u,0x##h##u,0x##i##u,0x##j##u,0x##k##u,0x##l##u,0x##m##u,0x##n##u,0x##o##u,0x##p##u)\n");
+    fprintf(fp, "#if WINDOW_G != %d\n", WINDOW_G);
+    fprintf(fp, "#error configuration mismatch, regenerate ecmult_static_context.h with gen_context.c\n");
+    fprintf(fp, "#endif\n");
+
+    /* secp256k1_ecmult_gen: 16^j * G combined with the nothing-up-my-sleeve point. */
+    secp256k1_ecmult_gen_context_init(&gen_ctx);
+    secp256k1_ecmult_gen_context_build(&gen_ctx, &default_error_callback);
+    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[64][16] = {\n");
+    for (outer = 0; outer != 64; outer++) {
+        fprintf(fp, "{\n");
+        for (inner = 0; inner != 16; inner++) {
+            print_ge_storage(fp, &(*gen_ctx.prec)[outer][inner]);
+            fprintf(fp, "%s\n", inner == 15 ? "" : ",");
+        }
+        fprintf(fp, "}%s\n", outer == 63 ? "" : ",");
+    }
+    fprintf(fp, "};\n");
+    secp256k1_ecmult_gen_context_clear(&gen_ctx);
+
+    /* secp256k1_ecmult: odd multiples of G (and of 2^128 * G with the endomorphism). */
+    secp256k1_ecmult_context_init(&ctx);
+    secp256k1_ecmult_context_build(&ctx, &default_error_callback);
+    print_table(fp, "secp256k1_ecmult_static_pre_g", *ctx.pre_g, ECMULT_TABLE_SIZE(WINDOW_G));
+#ifdef USE_ENDOMORPHISM
+    print_table(fp, "secp256k1_ecmult_static_pre_g_128", *ctx.pre_g_128, ECMULT_TABLE_SIZE(WINDOW_G));
+#endif
+    secp256k1_ecmult_context_clear(&ctx);
+
+    /* Odd multiples of 2^64 * G and 2^192 * G for the pubkey_table module,
+     * which also takes the multiples of G and 2^128 * G from the tables above. */
+    {
+        secp256k1_ge_storage pre[ECMULT_TABLE_SIZE(STATIC_G_64_WINDOW)];
+        secp256k1_gej gj;
+        int i;
+
+        fprintf(fp, "#define STATIC_G_64_WINDOW %d\n", STATIC_G_64_WINDOW);
+        secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
+        for (i = 0; i < 64; i++) {
+            secp256k1_gej_double_var(&gj, &gj, NULL);
+        }
+        secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(STATIC_G_64_WINDOW), pre, &gj, &default_error_callback);
+        print_table(fp, "secp256k1_ecmult_static_pre_g_64", pre, ECMULT_TABLE_SIZE(STATIC_G_64_WINDOW));
+        for (i = 0; i < 128; i++) {
+            secp256k1_gej_double_var(&gj, &gj, NULL);
+        }
+        secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(STATIC_G_64_WINDOW), pre, &gj, &default_error_callback);
+        print_table(fp, "secp256k1_ecmult_static_pre_g_192", pre, ECMULT_TABLE_SIZE(STATIC_G_64_WINDOW));
+    }
+
+    fprintf(fp, "#undef SC\n");
+    fprintf(fp, "#endif\n");
+    fclose(fp);
+
+    return 0;
+}
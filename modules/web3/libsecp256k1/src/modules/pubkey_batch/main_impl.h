@@ -0,0 +1,84 @@
+/**********************************************************************
+ * Copyright (c) 2013-2015 Pieter Wuille                              *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_MODULE_PUBKEY_BATCH_MAIN_
+#define _SECP256K1_MODULE_PUBKEY_BATCH_MAIN_
+
+#include "secp256k1_pubkey_batch.h"
+
+/** Keys sharing one inversion, the Jacobian points and products are kept on
+ *  the stack. Past 64 the saved inversions are small next to ecmult_gen. */
+#define PUBKEY_BATCH_SIZE 64
+
+static int secp256k1_ec_pubkey_create_group(const secp256k1_context* ctx, unsigned char *output, size_t outlen, const unsigned char *seckeys, size_t count) {
+    secp256k1_gej pj[PUBKEY_BATCH_SIZE];
+    secp256k1_fe prod[PUBKEY_BATCH_SIZE];
+    int valid[PUBKEY_BATCH_SIZE];
+    secp256k1_scalar sec;
+    secp256k1_fe inv, zi;
+    secp256k1_ge p;
+    size_t i, len;
+    int overflow;
+    int ret = 1;
+
+    /* Running products of the Z coordinates, Montgomery's trick. An invalid
+     * key is replaced by one so that the chain never contains zero. */
+    for (i = 0; i < count; i++) {
+        secp256k1_scalar_set_b32(&sec, seckeys + 32 * i, &overflow);
+        valid[i] = (!overflow) & (!secp256k1_scalar_is_zero(&sec));
+        if (!valid[i]) {
+            secp256k1_scalar_set_int(&sec, 1);
+            ret = 0;
+        }
+        secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pj[i], &sec);
+        if (i == 0) {
+            prod[0] = pj[0].z;
+        } else {
+            secp256k1_fe_mul(&prod[i], &prod[i - 1], &pj[i].z);
+        }
+    }
+    secp256k1_scalar_clear(&sec);
+
+    /* The Z coordinates depend on the secret keys, so the single inversion is
+     * the constant time one. */
+    secp256k1_fe_inv(&inv, &prod[count - 1]);
+    for (i = count; i-- > 0;) {
+        if (i > 0) {
+            secp256k1_fe_mul(&zi, &inv, &prod[i - 1]);
+            secp256k1_fe_mul(&inv, &inv, &pj[i].z);
+        } else {
+            zi = inv;
+        }
+        secp256k1_ge_set_gej_zinv(&p, &pj[i], &zi);
+        if (valid[i]) {
+            secp256k1_eckey_pubkey_serialize(&p, output + outlen * i, &len, outlen == 33);
+        } else {
+            memset(output + outlen * i, 0, outlen);
+        }
+    }
+    memset(pj, 0, sizeof(pj));
+    memset(prod, 0, sizeof(prod));
+    return ret;
+}
+
+int secp256k1_ec_pubkey_create_batch(const secp256k1_context* ctx, unsigned char *output, const unsigned char *seckeys, size_t count, unsigned int flags) {
+    size_t outlen, i, n;
+    int ret = 1;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(seckeys != NULL);
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_COMPRESSION);
+
+    outlen = (flags & SECP256K1_FLAGS_BIT_COMPRESSION) ? 33 : 65;
+    for (i = 0; i < count; i += n) {
+        n = count - i < PUBKEY_BATCH_SIZE ? count - i : PUBKEY_BATCH_SIZE;
+        ret &= secp256k1_ec_pubkey_create_group(ctx, output + outlen * i, outlen, seckeys + 32 * i, n);
+    }
+    return ret;
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**********************************************************************
+ * Copyright (c) 2013-2015 Pieter Wuille                              *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_MODULE_PUBKEY_TABLE_MAIN_
+#define _SECP256K1_MODULE_PUBKEY_TABLE_MAIN_
+
+#include "secp256k1_pubkey_table.h"
+
+#if !defined(USE_ECMULT_STATIC_PRECOMPUTATION) || !defined(STATIC_G_64_WINDOW)
+#error the pubkey_table module needs the G tables of ecmult_static_context.h
+#endif
+
+/** Window of the public key tables: 4 * 2^(w-2) points, 64 KiB with w = 10. */
+#define PUBKEY_TABLE_WINDOW 10
+
+/* Odd multiples of 2^(64*k) * P for k = 0..3. A scalar is then applied with
+ * 64 doublings instead of the ~129 of secp256k1_ecmult: the digit at bit i of
+ * its wNAF is taken from table i / 64 at doubling i % 64. G is split the same
+ * way, its tables are in ecmult_static_context.h. */
+struct secp256k1_pubkey_table_struct {
+    secp256k1_ge_storage pre[4][ECMULT_TABLE_SIZE(PUBKEY_TABLE_WINDOW)];
+};
+
+size_t secp256k1_pubkey_table_size(void) {
+    return sizeof(secp256k1_pubkey_table);
+}
+
+int secp256k1_pubkey_table_build(const secp256k1_context* ctx, secp256k1_pubkey_table *table, const secp256k1_pubkey *pubkey) {
+    secp256k1_ge q;
+    secp256k1_gej qj;
+    int i, k;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(table != NULL);
+    ARG_CHECK(pubkey != NULL);
+
+    if (!secp256k1_pubkey_load(ctx, &q, pubkey)) {
+        return 0;
+    }
+    secp256k1_gej_set_ge(&qj, &q);
+    for (k = 0; k < 4; k++) {
+        if (k > 0) {
+            for (i = 0; i < 64; i++) {
+                secp256k1_gej_double_var(&qj, &qj, NULL);
+            }
+        }
+        secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(PUBKEY_TABLE_WINDOW), table->pre[k], &qj, &ctx->error_callback);
+    }
+    return 1;
+}
+
+/** r = na*P + ng*G, P given by its table. Every table holds affine points, so
+ *  unlike secp256k1_ecmult no common Z is tracked. */
+static void secp256k1_pubkey_table_ecmult(secp256k1_gej *r, const secp256k1_pubkey_table *table, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
+    /* The multiples of G and 2^128 * G are a prefix of the WINDOW_G tables. */
+    const secp256k1_ge_storage *pre_g[4] = {
+        secp256k1_ecmult_static_pre_g,
+        secp256k1_ecmult_static_pre_g_64,
+        secp256k1_ecmult_static_pre_g_128,
+        secp256k1_ecmult_static_pre_g_192
+    };
+    secp256k1_ge tmpa;
+    int wnaf_na[256];
+    int wnaf_ng[256];
+    int bits_na;
+    int bits_ng;
+    int i, k;
+
+    bits_na = secp256k1_ecmult_wnaf(wnaf_na, 256, na, PUBKEY_TABLE_WINDOW);
+    bits_ng = secp256k1_ecmult_wnaf(wnaf_ng, 256, ng, STATIC_G_64_WINDOW);
+    (void)bits_na;
+    (void)bits_ng;
+
+    secp256k1_gej_set_infinity(r);
+
+    for (i = 63; i >= 0; i--) {
+        int n;
+        secp256k1_gej_double_var(r, r, NULL);
+        for (k = 0; k < 4; k++) {
+            if ((n = wnaf_na[k * 64 + i])) {
+                ECMULT_TABLE_GET_GE_STORAGE(&tmpa, table->pre[k], n, PUBKEY_TABLE_WINDOW);
+                secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+            }
+            if ((n = wnaf_ng[k * 64 + i])) {
+                ECMULT_TABLE_GET_GE_STORAGE(&tmpa, pre_g[k], n, STATIC_G_64_WINDOW);
+                secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+            }
+        }
+    }
+}
+
+int secp256k1_ecdsa_verify_with_table(const secp256k1_context* ctx, const secp256k1_ecdsa_signature *sig, const unsigned char *msg32, const secp256k1_pubkey_table *table) {
+    unsigned char c[32];
+    secp256k1_scalar r, s, m;
+    secp256k1_scalar sn, u1, u2;
+    secp256k1_fe xr;
+    secp256k1_gej pr;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(table != NULL);
+
+    secp256k1_scalar_set_b32(&m, msg32, NULL);
+    secp256k1_ecdsa_signature_load(ctx, &r, &s, sig);
+    if (secp256k1_scalar_is_high(&s) || secp256k1_scalar_is_zero(&r) || secp256k1_scalar_is_zero(&s)) {
+        return 0;
+    }
+
+    /* From here on the same steps as secp256k1_ecdsa_sig_verify. */
+    secp256k1_scalar_inverse_var(&sn, &s);
+    secp256k1_scalar_mul(&u1, &sn, &m);
+    secp256k1_scalar_mul(&u2, &sn, &r);
+    secp256k1_pubkey_table_ecmult(&pr, table, &u2, &u1);
+    if (secp256k1_gej_is_infinity(&pr)) {
+        return 0;
+    }
+
+    secp256k1_scalar_get_b32(c, &r);
+    secp256k1_fe_set_b32(&xr, c);
+    if (secp256k1_gej_eq_x_var(&xr, &pr)) {
+        return 1;
+    }
+    if (secp256k1_fe_cmp_var(&xr, &secp256k1_ecdsa_const_p_minus_order) >= 0) {
+        return 0;
+    }
+    secp256k1_fe_add(&xr, &secp256k1_ecdsa_const_order_as_fe);
+    if (secp256k1_gej_eq_x_var(&xr, &pr)) {
+        return 1;
+    }
+    return 0;
+}
+
+#endif
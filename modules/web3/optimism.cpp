@@ -1,8 +1,8 @@
 #include "optimism.h"
 
 Optimism::Optimism() {
-	m_secp256k1 = Ref<Secp256k1Wrapper>(memnew(Secp256k1Wrapper));
-	m_keccak = Ref<KeccakWrapper>(memnew(KeccakWrapper));
+	// The crypto wrappers are created on first use, a client that only
+	// makes rpc calls never needs them.
 	m_jsonrpc_helper = Ref<JsonrpcHelper>(memnew(JsonrpcHelper));
 
 	m_req_id = 0;
@@ -13,14 +13,20 @@ Optimism::~Optimism() {
 }
 
 bool Optimism::init_secp256k1_instance() {
-	return m_secp256k1->initialize();
+	return get_secp256k1_wrapper()->initialize();
 }
 
 Ref<Secp256k1Wrapper> Optimism::get_secp256k1_wrapper() {
+	if (m_secp256k1.is_null()) {
+		m_secp256k1 = Ref<Secp256k1Wrapper>(memnew(Secp256k1Wrapper));
+	}
 	return m_secp256k1;
 }
 
 Ref<KeccakWrapper> Optimism::get_keccak_wrapper() {
+	if (m_keccak.is_null()) {
+		m_keccak = Ref<KeccakWrapper>(memnew(KeccakWrapper));
+	}
 	return m_keccak;
 }
 
@@ -74,39 +80,41 @@ void Optimism::set_rpc_url(const String &url) {
     m_rpc_url = url;
 
     if (m_rpc_url != "" && m_jsonrpc_helper != NULL) {
-        std::regex url_regex(R"(^(https?:\/\/[^\/:]+)(:\d+)?(\/.*)?$)");
-        std::smatch url_match_result;
-
-        std::string rpc_url_str = m_rpc_url.utf8().get_data();
-
-        if (std::regex_match(rpc_url_str, url_match_result, url_regex)) {
-            std::string protocol_and_host = url_match_result[1].str();
-            std::string port_str = url_match_result[2].str();
-            std::string path_url = url_match_result[3].str();
-
-            int port = 80;
-            if (protocol_and_host.find("https://") == 0) {
-                port = 443;
-            }
-            print_line("port_str: " + String(port_str.c_str()));
-
-            if (!port_str.empty()) {
-                port = std::stoi(port_str.substr(1));
-            }
-
-            std::string full_hostname = protocol_and_host;
-            m_jsonrpc_helper->set_hostname(full_hostname.c_str());
-            m_jsonrpc_helper->set_port(port);
-
-            if (!path_url.empty()) {
-                m_jsonrpc_helper->set_path_url(path_url.c_str());
-            } else {
-                m_jsonrpc_helper->set_path_url("/");
-            }
-        } else {
+        if (!TxBroadcaster::configure_helper(m_jsonrpc_helper, m_rpc_url)) {
             ERR_PRINT("Invalid RPC URL format: " + m_rpc_url);
         }
     }
+    _update_broadcaster();
+}
+
+PackedStringArray Optimism::get_broadcast_urls() const {
+	return m_broadcast_urls;
+}
+
+void Optimism::set_broadcast_urls(const PackedStringArray &urls) {
+	m_broadcast_urls = urls;
+	_update_broadcaster();
+}
+
+// The broadcaster sends to the rpc url and every broadcast url.
+void Optimism::_update_broadcaster() {
+	if (m_broadcast_urls.is_empty()) {
+		m_broadcaster.unref();
+		return;
+	}
+	PackedStringArray urls;
+	if (m_rpc_url != "") {
+		urls.push_back(m_rpc_url);
+	}
+	for (int i = 0; i < m_broadcast_urls.size(); i++) {
+		if (!urls.has(m_broadcast_urls[i])) {
+			urls.push_back(m_broadcast_urls[i]);
+		}
+	}
+	if (m_broadcaster.is_null()) {
+		m_broadcaster = Ref<TxBroadcaster>(memnew(TxBroadcaster));
+	}
+	m_broadcaster->set_urls(urls);
 }
 
 String Optimism::sign_transaction(const Dictionary &transaction) {
@@ -545,7 +553,14 @@ uint64_t Optimism::nonce_at(const String &account, const Ref<BigInt> &block_numb
 // contract address after the transaction has been mined.
 //
 // signed_tx: The signed transaction data encode as a hex string with 0x prefix.
+//
+// When broadcast urls are set, the transaction is sent to all endpoints concurrently
+// and the first one that accepts it (or reports it as already known) wins.
 Dictionary Optimism::send_transaction(const String &signed_tx, const Variant &id) {
+	if (m_broadcaster.is_valid()) {
+		return m_broadcaster->broadcast(signed_tx, id);
+	}
+
 	Variant req_id = id;
 	m_req_id++;
 	if (id == "") {
@@ -913,6 +928,8 @@ void Optimism::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_keccak_wrapper"), &Optimism::get_keccak_wrapper);
     ClassDB::bind_method(D_METHOD("get_rpc_url"), &Optimism::get_rpc_url);
     ClassDB::bind_method(D_METHOD("set_rpc_url", "url"), &Optimism::set_rpc_url);
+    ClassDB::bind_method(D_METHOD("get_broadcast_urls"), &Optimism::get_broadcast_urls);
+    ClassDB::bind_method(D_METHOD("set_broadcast_urls", "urls"), &Optimism::set_broadcast_urls);
 	ClassDB::bind_method(D_METHOD("get_eth_account"), &Optimism::get_eth_account);
 	ClassDB::bind_method(D_METHOD("set_eth_account", "account"), &Optimism::set_eth_account);
 
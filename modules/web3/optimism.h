@@ -23,6 +23,7 @@
 #include "eth_abi_wrapper.h"
 #include "eth_account_wrapper.h"
 #include "legacy_tx.h"
+#include "tx_broadcaster.h"
 
 class Optimism : public RefCounted {
 	GDCLASS(Optimism, RefCounted);
@@ -35,6 +36,12 @@ class Optimism : public RefCounted {
 	String m_rpc_url;
 	uint32_t m_req_id;
 
+	// Extra endpoints for send_transaction, see set_broadcast_urls.
+	PackedStringArray m_broadcast_urls;
+	Ref<TxBroadcaster> m_broadcaster;
+
+	void _update_broadcaster();
+
 protected:
 	static void _bind_methods();
 
@@ -51,6 +58,14 @@ public:
 	String get_rpc_url() const;
 	void set_rpc_url(const String &url);
 
+	/**
+	 * @brief Endpoints send_transaction broadcasts to in addition to the rpc url.
+	 *
+	 *        Empty (the default) sends to the rpc url only.
+	 */
+	PackedStringArray get_broadcast_urls() const;
+	void set_broadcast_urls(const PackedStringArray &urls);
+
 	/**
 	 * @brief Sign a transaction by eth account which is set by set_eth_account method.
 	 *
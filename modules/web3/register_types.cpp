@@ -6,8 +6,23 @@
 #include "secp256k1_wrapper.h"
 #include "web3.h"
 #include "optimism.h"
+#include "keccak_hasher.h"
 #include "legacy_tx.h"
+#include "transaction_decoder.h"
+#include "typed_transaction.h"
+#include "access_list_tx.h"
+#include "dynamic_fee_tx.h"
+#include "batch_signer.h"
+#include "tx_batch.h"
+#include "presign_queue.h"
+#include "tx_broadcaster.h"
+#include "merkle_patricia_trie.h"
+#include "header_chain.h"
+#include "eip712.h"
 #include "big_int.h"
+#include "u256.h"
+#include "big_int_expr.h"
+#include "eth_units.h"
 #include "jsonrpc_helper.h"
 #include "eth_abi_wrapper.h"
 #include "abi_helper.h"
@@ -18,12 +33,30 @@ void initialize_web3_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 			return;
 	}
+	Secp256k1Wrapper::init_shared_context();
+
 	ClassDB::register_class<Web3>();
 	ClassDB::register_class<Optimism>();
 	ClassDB::register_class<Secp256k1Wrapper>();
 	ClassDB::register_class<KeccakWrapper>();
+	ClassDB::register_class<KeccakHasher>();
 	ClassDB::register_class<LegacyTx>();
+	ClassDB::register_abstract_class<TypedTransaction>();
+	ClassDB::register_class<AccessListTx>();
+	ClassDB::register_class<DynamicFeeTx>();
+	ClassDB::register_class<TransactionDecoder>();
+	ClassDB::register_class<BatchSigner>();
+	ClassDB::register_class<TxBatch>();
+	ClassDB::register_class<PresignQueue>();
+	ClassDB::register_class<TxBroadcaster>();
+	ClassDB::register_class<MerklePatriciaTrie>();
+	ClassDB::register_class<HeaderChain>();
+	ClassDB::register_class<TypedDataEncoder>();
 	ClassDB::register_class<BigInt>();
+	ClassDB::register_class<U256>();
+	ClassDB::register_class<I256>();
+	ClassDB::register_class<BigIntExpr>();
+	ClassDB::register_class<EthUnits>();
 	ClassDB::register_class<JsonrpcHelper>();
 	ClassDB::register_class<EthABIWrapper>();
 	ClassDB::register_class<ABIHelper>();
@@ -37,7 +70,9 @@ void uninitialize_web3_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 			return;
 	}
-   // Nothing to do here in this example.
+	Secp256k1Wrapper::clear_public_key_cache();
+	Secp256k1Wrapper::clear_signer_cache();
+	Secp256k1Wrapper::free_shared_context();
 }
 
 
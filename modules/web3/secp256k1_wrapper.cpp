@@ -3,35 +3,149 @@
 #include "libsecp256k1/src/secp256k1.c"
 #include "libsecp256k1/src/modules/recovery/main_impl.h"
 #include "libsecp256k1/include/ext.h"
+#include "libsecp256k1/src/modules/pubkey_table/main_impl.h"
+#include "libsecp256k1/src/modules/pubkey_batch/main_impl.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/rw_lock.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include "eth_ecdsa.h"
+#include "keccak256.h"
+#include "signer_cache.h"
+
+namespace {
+
+// Borrows the shared context for the lifetime of a call.
+struct SharedContext {
+	const secp256k1_context *ctx;
+
+	SharedContext() { ctx = eth_ecdsa_context_acquire(); }
+	~SharedContext() { eth_ecdsa_context_release(ctx); }
+};
+
+// A cached table. The cache holds one reference and each verification using
+// the entry another, so an entry evicted meanwhile is freed by the last one.
+struct PubkeyTableEntry {
+	uint8_t key[65];
+	secp256k1_pubkey_table *table = nullptr;
+	SafeNumeric<uint32_t> refs;
+	// Clock value of the last use, the smallest is evicted first.
+	SafeNumeric<uint64_t> last_used;
+};
+
+// Verifications only take the read lock and bump the use stamp of their
+// entry, the least recently used entry is looked for when evicting.
+RWLock table_cache_lock;
+LocalVector<PubkeyTableEntry *> table_cache;
+SafeNumeric<uint64_t> table_cache_clock;
+int64_t table_cache_budget = 4 * 1024 * 1024;
+
+void _unref_table_entry(PubkeyTableEntry *p_entry) {
+	if (p_entry->refs.decrement() == 0) {
+		memfree(p_entry->table);
+		memdelete(p_entry);
+	}
+}
 
-Secp256k1Wrapper::Secp256k1Wrapper() {
-	m_ctx = nullptr;
+// Called with table_cache_lock held.
+int _find_table_entry(const uint8_t *p_key) {
+	for (uint32_t i = 0; i < table_cache.size(); i++) {
+		if (memcmp(table_cache[i]->key, p_key, 65) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
 
-	initialize();
+// Called with table_cache_lock held for writing.
+void _evict_table_entry(uint32_t p_index) {
+	PubkeyTableEntry *entry = table_cache[p_index];
+	table_cache.remove_at_unordered(p_index);
+	_unref_table_entry(entry);
 }
 
-Secp256k1Wrapper::~Secp256k1Wrapper() {
-	if (m_ctx != nullptr) {
-		secp256k1_context_destroy(m_ctx);
+// Called with table_cache_lock held for writing.
+void _trim_table_cache() {
+	int64_t table_size = secp256k1_pubkey_table_size();
+	while (!table_cache.is_empty() && (int64_t)table_cache.size() * table_size > table_cache_budget) {
+		uint32_t oldest = 0;
+		for (uint32_t i = 1; i < table_cache.size(); i++) {
+			if (table_cache[i]->last_used.get() < table_cache[oldest]->last_used.get()) {
+				oldest = i;
+			}
+		}
+		_evict_table_entry(oldest);
+	}
+}
+
+PubkeyTableEntry *_acquire_table_entry(const uint8_t *p_key) {
+	RWLockRead lock(table_cache_lock);
+	int index = _find_table_entry(p_key);
+	if (index < 0) {
+		return nullptr;
+	}
+	PubkeyTableEntry *entry = table_cache[index];
+	entry->refs.increment();
+	entry->last_used.set(table_cache_clock.increment());
+	return entry;
+}
+
+// Same result as secp256k1_ext_ecdsa_verify, with the cached table of the key
+// when there is one.
+int _verify_signature(const secp256k1_context *p_ctx, const uint8_t *p_signature, const uint8_t *p_hash, const uint8_t *p_public_key, size_t p_public_key_len) {
+	if (p_public_key_len == 65) {
+		PubkeyTableEntry *entry = _acquire_table_entry(p_public_key);
+		if (entry != nullptr) {
+			secp256k1_ecdsa_signature sig;
+			int valid = secp256k1_ecdsa_signature_parse_compact(p_ctx, &sig, p_signature) &&
+					secp256k1_ecdsa_verify_with_table(p_ctx, &sig, p_hash, entry->table);
+			_unref_table_entry(entry);
+			return valid;
+		}
 	}
+	return secp256k1_ext_ecdsa_verify(p_ctx, p_signature, p_hash, p_public_key, p_public_key_len);
+}
+
+// Uncompressed 65-byte form of a 33 or 65-byte public key, the cache key.
+bool _normalize_public_key(const secp256k1_context *p_ctx, const PackedByteArray &p_public_key, uint8_t *r_key, secp256k1_pubkey &r_pubkey) {
+	size_t len = 65;
+	return secp256k1_ec_pubkey_parse(p_ctx, &r_pubkey, p_public_key.ptr(), p_public_key.size()) == 1 &&
+			secp256k1_ec_pubkey_serialize(p_ctx, r_key, &len, &r_pubkey, SECP256K1_EC_UNCOMPRESSED) == 1;
+}
+
+} // namespace
+
+Secp256k1Wrapper::Secp256k1Wrapper() {
+}
+
+Secp256k1Wrapper::~Secp256k1Wrapper() {
 }
 
 bool Secp256k1Wrapper::initialize() {
-	m_ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	return init_shared_context();
+}
 
-	unsigned char randomize[32];
+bool Secp256k1Wrapper::init_shared_context() {
+	unsigned char seed[32];
 
 	ERR_FAIL_COND_V_MSG(
-		fill_random(randomize, sizeof(randomize)) != true,
+		fill_random(seed, sizeof(seed)) != true,
 		false,
 		"Failed to generate randomness"
 	);
 
-	int return_val = secp256k1_context_randomize(m_ctx, randomize);
-	ERR_FAIL_COND_V_MSG(return_val != 1, FAILED, "Failed to randomize context");
+	int return_val = eth_ecdsa_context_init(seed);
+	memset(seed, 0, sizeof(seed));
+	ERR_FAIL_COND_V_MSG(return_val != 1, false, "Failed to create secp256k1 context");
 	return true;
 }
 
+void Secp256k1Wrapper::free_shared_context() {
+	eth_ecdsa_context_free();
+}
+
 bool Secp256k1Wrapper::set_secret_key(const String &key) {
 	std::string hex_key = key.utf8().get_data();
 	if (hex_key.substr(0, 2) == "0x") {
@@ -127,6 +241,9 @@ Error Secp256k1Wrapper::save_secret_key(const String &path) {
 }
 
 bool Secp256k1Wrapper::generate_key_pair() {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, false, "Failed to create secp256k1 context");
+
 	unsigned char seckey[32];
 	secp256k1_pubkey pubkey;
 
@@ -136,18 +253,18 @@ bool Secp256k1Wrapper::generate_key_pair() {
 	while (1) {
 		ERR_FAIL_COND_V_MSG(!fill_random(seckey, sizeof(seckey)), false, "Failed to generate randomness");
 
-		if (secp256k1_ec_seckey_verify(m_ctx, seckey)) {
+		if (secp256k1_ec_seckey_verify(shared.ctx, seckey)) {
 			break;
 		}
 	}
 
 	/* Compute the public key from a secret key. */
-	ERR_FAIL_COND_V_MSG(!secp256k1_ec_pubkey_create(m_ctx, &pubkey, seckey), false, "Failed to create public key");
+	ERR_FAIL_COND_V_MSG(!secp256k1_ec_pubkey_create(shared.ctx, &pubkey, seckey), false, "Failed to create public key");
 
 	// serialize the public key
 	unsigned char serialize_pubkey[65];
 	size_t outputlen = 65;
-	secp256k1_ec_pubkey_serialize(m_ctx, serialize_pubkey, &outputlen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+	secp256k1_ec_pubkey_serialize(shared.ctx, serialize_pubkey, &outputlen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
 
 	// save to class member
 	m_secret_key.clear();
@@ -164,6 +281,9 @@ bool Secp256k1Wrapper::generate_key_pair() {
 }
 
 bool Secp256k1Wrapper::compute_public_key_from_seckey() {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, false, "Failed to create secp256k1 context");
+
 	ERR_FAIL_COND_V_MSG(m_secret_key.size() != 32, false, "Invalid secret key size: " + itos(m_secret_key.size()) + " expected 32 bytes");
 
 	unsigned char seckey[32];
@@ -171,10 +291,10 @@ bool Secp256k1Wrapper::compute_public_key_from_seckey() {
 		seckey[i] = m_secret_key[i];
 	}
 
-	ERR_FAIL_COND_V_MSG(!secp256k1_ec_seckey_verify(m_ctx, seckey), false, "Invalid secret key");
+	ERR_FAIL_COND_V_MSG(!secp256k1_ec_seckey_verify(shared.ctx, seckey), false, "Invalid secret key");
 
 	secp256k1_pubkey pubkey;
-	if (!secp256k1_ec_pubkey_create(m_ctx, &pubkey, seckey)) {
+	if (!secp256k1_ec_pubkey_create(shared.ctx, &pubkey, seckey)) {
 		ERR_PRINT("Failed to create public key");
 		return false;
 	}
@@ -182,7 +302,7 @@ bool Secp256k1Wrapper::compute_public_key_from_seckey() {
 	// serialize the public key
 	unsigned char serialize_pubkey[65];
 	size_t outputlen = 65;
-	secp256k1_ec_pubkey_serialize(m_ctx, serialize_pubkey, &outputlen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
+	secp256k1_ec_pubkey_serialize(shared.ctx, serialize_pubkey, &outputlen, &pubkey, SECP256K1_EC_UNCOMPRESSED);
 
 	m_public_key.clear();
 	for (size_t i = 0; i < sizeof(serialize_pubkey); ++i) {
@@ -194,6 +314,9 @@ bool Secp256k1Wrapper::compute_public_key_from_seckey() {
 
 
 PackedByteArray Secp256k1Wrapper::sign(const PackedByteArray &message) {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, PackedByteArray(), "Failed to create secp256k1 context");
+
 	ERR_FAIL_COND_V_MSG(m_secret_key.size() != 32, PackedByteArray(), "Invalid secret key size: " + itos(m_secret_key.size()) + " expected 32 bytes");
 	ERR_FAIL_COND_V_MSG(message.size() != 32, PackedByteArray(), "Invalid message size: " + itos(message.size()) + " expected 32 bytes");
 
@@ -202,7 +325,7 @@ PackedByteArray Secp256k1Wrapper::sign(const PackedByteArray &message) {
 		seckey[i] = m_secret_key[i];
 	}
 
-	ERR_FAIL_COND_V_MSG(secp256k1_ec_seckey_verify(m_ctx, seckey) != 1, PackedByteArray(), "Invalid secret key");
+	ERR_FAIL_COND_V_MSG(secp256k1_ec_seckey_verify(shared.ctx, seckey) != 1, PackedByteArray(), "Invalid secret key");
 
 	// convert PackedByteArray data to unsigned char
 	unsigned char sign_msg[32];
@@ -212,14 +335,14 @@ PackedByteArray Secp256k1Wrapper::sign(const PackedByteArray &message) {
 
 	secp256k1_ecdsa_recoverable_signature signature_output;
 
-	int return_val = secp256k1_ecdsa_sign_recoverable(m_ctx, &signature_output, sign_msg, seckey, NULL, NULL);
+	int return_val = secp256k1_ecdsa_sign_recoverable(shared.ctx, &signature_output, sign_msg, seckey, NULL, NULL);
 	ERR_FAIL_COND_V_MSG(return_val != 1, PackedByteArray(), "Failed to sign message");
 
 	// compact signature output
 	int recid;
 	unsigned char compact_sig[65];
 	unsigned char *sigdata = &compact_sig[0];
-	secp256k1_ecdsa_recoverable_signature_serialize_compact(m_ctx, sigdata, &recid, &signature_output);
+	secp256k1_ecdsa_recoverable_signature_serialize_compact(shared.ctx, sigdata, &recid, &signature_output);
 	compact_sig[64] = recid;
 
 	// convert compact signature data to PackedByteArray
@@ -233,6 +356,9 @@ PackedByteArray Secp256k1Wrapper::sign(const PackedByteArray &message) {
 }
 
 bool Secp256k1Wrapper::verify(const PackedByteArray &message, const PackedByteArray &signature) {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, false, "Failed to create secp256k1 context");
+
 	ERR_FAIL_COND_V_MSG(message.size() != 32, false, "Invalid message size: " + itos(message.size()) + " expected 32 bytes");
 	ERR_FAIL_COND_V_MSG(signature.size() != 65, false, "Invalid signature size: "+ itos(signature.size()) + " expected 65 bytes");
 
@@ -254,13 +380,16 @@ bool Secp256k1Wrapper::verify(const PackedByteArray &message, const PackedByteAr
 		key_data[i] = m_public_key[i];
 	}
 
-	int return_val = secp256k1_ext_ecdsa_verify(m_ctx, sign_data, msg_data, key_data, m_public_key.size());
+	int return_val = _verify_signature(shared.ctx, sign_data, msg_data, key_data, m_public_key.size());
 	ERR_FAIL_COND_V_MSG(return_val != 1, false, "Signature verification failed");
 
 	return true;
 }
 
 PackedByteArray Secp256k1Wrapper::recover_pubkey(const PackedByteArray &message, const PackedByteArray &signature) {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, PackedByteArray(), "Failed to create secp256k1 context");
+
 	ERR_FAIL_COND_V_MSG(message.size() != 32, PackedByteArray(), "Invalid message size: " + itos(message.size()) + " expected 32 bytes");
 	ERR_FAIL_COND_V_MSG(signature.size() != 65, PackedByteArray(), "Invalid signature size: "+ itos(signature.size()) + " expected 65 bytes");
 	ERR_FAIL_COND_V_MSG(signature[64] >= 4, PackedByteArray(), "Invalid recover id: "+ itos(signature[64]));
@@ -277,9 +406,14 @@ PackedByteArray Secp256k1Wrapper::recover_pubkey(const PackedByteArray &message,
 		sig_data[i] = signature[i];
 	}
 
+	eth_ecdsa_signature signer_sig;
+	memcpy(signer_sig.r, sig_data, 32);
+	memcpy(signer_sig.s, sig_data + 32, 32);
+	signer_sig.recid = sig_data[64];
+
 	unsigned char pubkey_out[65];
-	int ret_val = secp256k1_ext_ecdsa_recover(m_ctx, pubkey_out, sig_data, msg_data);
-	if (ret_val != 1) {
+	pubkey_out[0] = 0x04;
+	if (!SignerCache::recover(shared.ctx, msg_data, signer_sig, pubkey_out + 1, nullptr)) {
 		ERR_PRINT("Failed to recover public key");
 		return PackedByteArray();
 	}
@@ -293,6 +427,211 @@ PackedByteArray Secp256k1Wrapper::recover_pubkey(const PackedByteArray &message,
 	return return_public_key;
 }
 
+// Batch below which verifying inline is cheaper than dispatching to the pool.
+static const int PARALLEL_VERIFY_THRESHOLD = 8;
+
+struct SignatureBatch {
+	const secp256k1_context *ctx = nullptr;
+	const uint8_t *hashes = nullptr;
+	const uint8_t *signatures = nullptr;
+	const uint8_t *public_keys = nullptr;
+	uint8_t *out = nullptr;
+};
+
+static void _verify_one(void *p_userdata, uint32_t p_index) {
+	SignatureBatch *batch = static_cast<SignatureBatch *>(p_userdata);
+	batch->out[p_index] = _verify_signature(batch->ctx, batch->signatures + p_index * 65, batch->hashes + p_index * 32, batch->public_keys + p_index * 65, 65) == 1 ? 1 : 0;
+}
+
+static void _recover_one(void *p_userdata, uint32_t p_index) {
+	SignatureBatch *batch = static_cast<SignatureBatch *>(p_userdata);
+	const uint8_t *sig = batch->signatures + p_index * 65;
+	eth_ecdsa_signature signature;
+	memcpy(signature.r, sig, 32);
+	memcpy(signature.s, sig + 32, 32);
+	signature.recid = sig[64];
+	// Left zero when the signature does not recover.
+	SignerCache::recover(batch->ctx, batch->hashes + p_index * 32, signature, nullptr, batch->out + p_index * 20);
+}
+
+static void _run_signature_batch(SignatureBatch &p_batch, uint32_t p_count, void (*p_func)(void *, uint32_t), const char *p_description) {
+	if (p_count < (uint32_t)PARALLEL_VERIFY_THRESHOLD) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_func(&p_batch, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(p_func, &p_batch, p_count, -1, true, p_description);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+}
+
+PackedByteArray Secp256k1Wrapper::verify_batch(const PackedByteArray &hashes, const PackedByteArray &signatures, const PackedByteArray &public_keys) {
+	ERR_FAIL_COND_V_MSG(hashes.size() % 32 != 0, PackedByteArray(), "Invalid hashes size: " + itos(hashes.size()) + " expected a multiple of 32 bytes");
+	uint32_t count = hashes.size() / 32;
+	ERR_FAIL_COND_V_MSG(signatures.size() != (int64_t)count * 65, PackedByteArray(), "Invalid signatures size: " + itos(signatures.size()) + " expected " + itos(count * 65) + " bytes");
+	ERR_FAIL_COND_V_MSG(public_keys.size() != (int64_t)count * 65, PackedByteArray(), "Invalid public keys size: " + itos(public_keys.size()) + " expected " + itos(count * 65) + " bytes");
+
+	PackedByteArray result;
+	result.resize(count);
+	if (count == 0) {
+		return result;
+	}
+
+	// The shared context is only read by the workers.
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, PackedByteArray(), "Failed to create secp256k1 context");
+
+	SignatureBatch batch;
+	batch.ctx = shared.ctx;
+	batch.hashes = hashes.ptr();
+	batch.signatures = signatures.ptr();
+	batch.public_keys = public_keys.ptr();
+	batch.out = result.ptrw();
+	_run_signature_batch(batch, count, &_verify_one, "Verify signatures");
+	return result;
+}
+
+PackedByteArray Secp256k1Wrapper::recover_addresses_batch(const PackedByteArray &hashes, const PackedByteArray &signatures) {
+	ERR_FAIL_COND_V_MSG(hashes.size() % 32 != 0, PackedByteArray(), "Invalid hashes size: " + itos(hashes.size()) + " expected a multiple of 32 bytes");
+	uint32_t count = hashes.size() / 32;
+	ERR_FAIL_COND_V_MSG(signatures.size() != (int64_t)count * 65, PackedByteArray(), "Invalid signatures size: " + itos(signatures.size()) + " expected " + itos(count * 65) + " bytes");
+
+	PackedByteArray result;
+	result.resize(count * 20);
+	if (count == 0) {
+		return result;
+	}
+	memset(result.ptrw(), 0, count * 20);
+
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, PackedByteArray(), "Failed to create secp256k1 context");
+
+	SignatureBatch batch;
+	batch.ctx = shared.ctx;
+	batch.hashes = hashes.ptr();
+	batch.signatures = signatures.ptr();
+	batch.out = result.ptrw();
+	_run_signature_batch(batch, count, &_recover_one, "Recover signers");
+	return result;
+}
+
+bool Secp256k1Wrapper::cache_public_key(const PackedByteArray &public_key) {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, false, "Failed to create secp256k1 context");
+
+	uint8_t key[65];
+	secp256k1_pubkey pubkey;
+	ERR_FAIL_COND_V_MSG(!_normalize_public_key(shared.ctx, public_key, key, pubkey), false, "Invalid public key");
+	ERR_FAIL_COND_V_MSG((int64_t)secp256k1_pubkey_table_size() > get_public_key_cache_budget(), false, "Public key cache budget is smaller than one table (" + itos(secp256k1_pubkey_table_size()) + " bytes)");
+	if (is_public_key_cached(public_key)) {
+		return true;
+	}
+
+	// Built outside the lock, it takes about as long as a few verifications.
+	PubkeyTableEntry *entry = memnew(PubkeyTableEntry);
+	memcpy(entry->key, key, 65);
+	entry->refs.set(1);
+	entry->table = (secp256k1_pubkey_table *)memalloc(secp256k1_pubkey_table_size());
+	if (secp256k1_pubkey_table_build(shared.ctx, entry->table, &pubkey) != 1) {
+		_unref_table_entry(entry);
+		ERR_FAIL_V_MSG(false, "Failed to build public key table");
+	}
+
+	RWLockWrite lock(table_cache_lock);
+	if (_find_table_entry(key) >= 0) {
+		// Another thread cached it meanwhile.
+		_unref_table_entry(entry);
+		return true;
+	}
+	entry->last_used.set(table_cache_clock.increment());
+	table_cache.push_back(entry);
+	_trim_table_cache();
+	return true;
+}
+
+bool Secp256k1Wrapper::uncache_public_key(const PackedByteArray &public_key) {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, false, "Failed to create secp256k1 context");
+
+	uint8_t key[65];
+	secp256k1_pubkey pubkey;
+	ERR_FAIL_COND_V_MSG(!_normalize_public_key(shared.ctx, public_key, key, pubkey), false, "Invalid public key");
+
+	RWLockWrite lock(table_cache_lock);
+	int index = _find_table_entry(key);
+	if (index < 0) {
+		return false;
+	}
+	_evict_table_entry(index);
+	return true;
+}
+
+bool Secp256k1Wrapper::is_public_key_cached(const PackedByteArray &public_key) {
+	SharedContext shared;
+	ERR_FAIL_NULL_V_MSG(shared.ctx, false, "Failed to create secp256k1 context");
+
+	uint8_t key[65];
+	secp256k1_pubkey pubkey;
+	if (!_normalize_public_key(shared.ctx, public_key, key, pubkey)) {
+		return false;
+	}
+
+	RWLockRead lock(table_cache_lock);
+	return _find_table_entry(key) >= 0;
+}
+
+void Secp256k1Wrapper::clear_public_key_cache() {
+	RWLockWrite lock(table_cache_lock);
+	while (!table_cache.is_empty()) {
+		_evict_table_entry(table_cache.size() - 1);
+	}
+}
+
+int Secp256k1Wrapper::get_cached_public_key_count() {
+	RWLockRead lock(table_cache_lock);
+	return table_cache.size();
+}
+
+void Secp256k1Wrapper::set_public_key_cache_budget(int64_t bytes) {
+	ERR_FAIL_COND_MSG(bytes < 0, "Public key cache budget must not be negative");
+	RWLockWrite lock(table_cache_lock);
+	table_cache_budget = bytes;
+	_trim_table_cache();
+}
+
+int64_t Secp256k1Wrapper::get_public_key_cache_budget() {
+	RWLockRead lock(table_cache_lock);
+	return table_cache_budget;
+}
+
+int64_t Secp256k1Wrapper::get_public_key_table_size() {
+	return secp256k1_pubkey_table_size();
+}
+
+void Secp256k1Wrapper::set_signer_cache_capacity(int capacity) {
+	SignerCache::set_capacity(capacity);
+}
+
+int Secp256k1Wrapper::get_signer_cache_capacity() {
+	return SignerCache::get_capacity();
+}
+
+int Secp256k1Wrapper::get_signer_cache_size() {
+	return SignerCache::get_size();
+}
+
+int64_t Secp256k1Wrapper::get_signer_cache_hits() {
+	return SignerCache::get_hits();
+}
+
+int64_t Secp256k1Wrapper::get_signer_cache_misses() {
+	return SignerCache::get_misses();
+}
+
+void Secp256k1Wrapper::clear_signer_cache() {
+	SignerCache::clear();
+}
+
 int Secp256k1Wrapper::fill_random(unsigned char* data, size_t size) {
 	#if defined(_WIN32)
 		NTSTATUS res = BCryptGenRandom(NULL, data, size, BCRYPT_USE_SYSTEM_PREFERRED_RNG);
@@ -340,4 +679,23 @@ void Secp256k1Wrapper::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("sign", "message"), &Secp256k1Wrapper::sign);
 	ClassDB::bind_method(D_METHOD("verify", "message", "signature"), &Secp256k1Wrapper::verify);
+
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("verify_batch", "hashes", "signatures", "public_keys"), &Secp256k1Wrapper::verify_batch);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("recover_addresses_batch", "hashes", "signatures"), &Secp256k1Wrapper::recover_addresses_batch);
+
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("cache_public_key", "public_key"), &Secp256k1Wrapper::cache_public_key);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("uncache_public_key", "public_key"), &Secp256k1Wrapper::uncache_public_key);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("is_public_key_cached", "public_key"), &Secp256k1Wrapper::is_public_key_cached);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("clear_public_key_cache"), &Secp256k1Wrapper::clear_public_key_cache);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_cached_public_key_count"), &Secp256k1Wrapper::get_cached_public_key_count);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("set_public_key_cache_budget", "bytes"), &Secp256k1Wrapper::set_public_key_cache_budget);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_public_key_cache_budget"), &Secp256k1Wrapper::get_public_key_cache_budget);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_public_key_table_size"), &Secp256k1Wrapper::get_public_key_table_size);
+
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("set_signer_cache_capacity", "capacity"), &Secp256k1Wrapper::set_signer_cache_capacity);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_signer_cache_capacity"), &Secp256k1Wrapper::get_signer_cache_capacity);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_signer_cache_size"), &Secp256k1Wrapper::get_signer_cache_size);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_signer_cache_hits"), &Secp256k1Wrapper::get_signer_cache_hits);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("get_signer_cache_misses"), &Secp256k1Wrapper::get_signer_cache_misses);
+	ClassDB::bind_static_method("Secp256k1Wrapper", D_METHOD("clear_signer_cache"), &Secp256k1Wrapper::clear_signer_cache);
 }
@@ -0,0 +1,243 @@
+#include "tx_broadcaster.h"
+
+#include <regex>
+#include <string>
+
+#include "core/io/json.h"
+
+#include "keccak256.h"
+
+struct TxBroadcaster::Job {
+	struct Call {
+		Job *job = nullptr;
+		int index = 0;
+	};
+
+	Mutex mutex;
+	Semaphore semaphore;
+
+	// Read only while the calls run.
+	LocalVector<Ref<JsonrpcHelper>> helpers;
+	LocalVector<Call> calls;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	Vector<Variant> params;
+	Variant id;
+	int timeout_ms = 0;
+
+	// Guarded by mutex.
+	int pending = 0;
+	int accepted = -1;
+	bool already_known = false;
+	LocalVector<String> errors;
+};
+
+static void _send_raw_transaction(void *p_userdata) {
+	TxBroadcaster::Job::Call *call = static_cast<TxBroadcaster::Job::Call *>(p_userdata);
+	TxBroadcaster::Job *job = call->job;
+
+	Dictionary result = job->helpers[call->index]->call_method("eth_sendRawTransaction", job->params, job->id, job->timeout_ms);
+	String error;
+	bool already_known = false;
+	if (bool(result["success"]) == false) {
+		error = result["errmsg"];
+	} else if (result["response_body"] == "") {
+		error = "response body is empty.";
+	} else {
+		Ref<JSON> json = Ref<JSON>(memnew(JSON));
+		Dictionary res = json->parse_string(result["response_body"]);
+		if (res.has("error")) {
+			Dictionary rpc_error = res["error"];
+			error = rpc_error.get("message", "unknown error");
+			already_known = TxBroadcaster::is_already_known(error);
+		} else if (!res.has("result")) {
+			error = "invalid response: " + String(result["response_body"]);
+		}
+	}
+
+	{
+		MutexLock lock(job->mutex);
+		job->errors[call->index] = error;
+		if ((error.is_empty() || already_known) && job->accepted < 0) {
+			job->accepted = call->index;
+			job->already_known = already_known;
+		}
+		job->pending--;
+	}
+	job->semaphore.post();
+}
+
+TxBroadcaster::~TxBroadcaster() {
+	_collect(true);
+}
+
+void TxBroadcaster::_collect(bool p_wait) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (uint32_t i = 0; i < m_running.size();) {
+		Job *job = m_running[i];
+		bool done = true;
+		for (uint32_t t = 0; t < job->tasks.size() && done && !p_wait; t++) {
+			done = pool->is_task_completed(job->tasks[t]);
+		}
+		if (!done) {
+			i++;
+			continue;
+		}
+		for (uint32_t t = 0; t < job->tasks.size(); t++) {
+			pool->wait_for_task_completion(job->tasks[t]);
+		}
+		memdelete(job);
+		m_running.remove_at_unordered(i);
+	}
+}
+
+bool TxBroadcaster::configure_helper(const Ref<JsonrpcHelper> &helper, const String &url) {
+	ERR_FAIL_COND_V(helper.is_null(), false);
+
+	std::regex url_regex(R"(^(https?:\/\/[^\/:]+)(:\d+)?(\/.*)?$)");
+	std::smatch url_match_result;
+	std::string rpc_url_str = url.utf8().get_data();
+	if (!std::regex_match(rpc_url_str, url_match_result, url_regex)) {
+		return false;
+	}
+
+	std::string protocol_and_host = url_match_result[1].str();
+	std::string port_str = url_match_result[2].str();
+	std::string path_url = url_match_result[3].str();
+
+	int port = 80;
+	if (protocol_and_host.find("https://") == 0) {
+		port = 443;
+	}
+	if (!port_str.empty()) {
+		port = std::stoi(port_str.substr(1));
+	}
+
+	helper->set_hostname(protocol_and_host.c_str());
+	helper->set_port(port);
+	helper->set_path_url(path_url.empty() ? "/" : path_url.c_str());
+	return true;
+}
+
+bool TxBroadcaster::is_already_known(const String &message) {
+	// geth "already known", erigon "ALREADY_EXISTS: already known", older geth
+	// and besu "known transaction: <hash>", nethermind "AlreadyKnown".
+	String lower = message.to_lower();
+	return lower.contains("already known") || lower.contains("alreadyknown") || lower.contains("known transaction") || lower.contains("already imported");
+}
+
+void TxBroadcaster::set_urls(const PackedStringArray &urls) {
+	m_urls.clear();
+	m_helpers.clear();
+	for (int i = 0; i < urls.size(); i++) {
+		Ref<JsonrpcHelper> helper = Ref<JsonrpcHelper>(memnew(JsonrpcHelper));
+		if (!configure_helper(helper, urls[i])) {
+			ERR_PRINT("Invalid RPC URL format: " + urls[i]);
+			continue;
+		}
+		m_urls.push_back(urls[i]);
+		m_helpers.push_back(helper);
+	}
+}
+
+PackedStringArray TxBroadcaster::get_urls() const {
+	return m_urls;
+}
+
+void TxBroadcaster::set_timeout_ms(int timeout_ms) {
+	m_timeout_ms = timeout_ms;
+}
+
+int TxBroadcaster::get_timeout_ms() const {
+	return m_timeout_ms;
+}
+
+Dictionary TxBroadcaster::broadcast(const String &signed_tx, const Variant &id) {
+	_collect(false);
+
+	Dictionary ret = Dictionary();
+	ret["success"] = false;
+	ret["errmsg"] = "";
+
+	if (m_helpers.is_empty()) {
+		ERR_PRINT("No broadcast endpoint set.");
+		ret["errmsg"] = "no broadcast endpoint set.";
+		return ret;
+	}
+
+	// The hash is known locally, nodes that answer "already known" do not return it.
+	PackedByteArray raw = (signed_tx.begins_with("0x") ? signed_tx.substr(2) : signed_tx).hex_decode();
+	if (raw.is_empty()) {
+		ERR_PRINT("Invalid signed transaction: " + signed_tx);
+		ret["errmsg"] = "invalid signed transaction.";
+		return ret;
+	}
+	PackedByteArray tx_hash;
+	tx_hash.resize(32);
+	eth_keccak256(tx_hash.ptrw(), raw.ptr(), raw.size());
+
+	int count = m_helpers.size();
+	Job *job = memnew(Job);
+	job->helpers = m_helpers;
+	job->params.push_back(signed_tx);
+	m_req_id++;
+	job->id = id == "" ? Variant(String::num_int64(m_req_id)) : id;
+	job->timeout_ms = m_timeout_ms;
+	job->pending = count;
+	job->errors.resize(count);
+	job->calls.resize(count);
+	job->tasks.resize(count);
+	for (int i = 0; i < count; i++) {
+		job->calls[i].job = job;
+		job->calls[i].index = i;
+	}
+	// High priority, the calls block on the network and must start right away.
+	for (int i = 0; i < count; i++) {
+		job->tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(&_send_raw_transaction, &job->calls[i], true, "Broadcast transaction");
+	}
+
+	bool finished = false;
+	while (true) {
+		job->semaphore.wait();
+		MutexLock lock(job->mutex);
+		if (job->accepted >= 0 || job->pending == 0) {
+			finished = job->pending == 0;
+			break;
+		}
+	}
+
+	{
+		MutexLock lock(job->mutex);
+		if (job->accepted >= 0) {
+			ret["success"] = true;
+			ret["txhash"] = "0x" + String::hex_encode_buffer(tx_hash.ptr(), 32);
+			ret["endpoint"] = m_urls[job->accepted];
+			ret["already_known"] = job->already_known;
+		} else {
+			String errmsg;
+			for (int i = 0; i < count; i++) {
+				errmsg += (i > 0 ? "; " : "") + m_urls[i] + ": " + job->errors[i];
+			}
+			ERR_PRINT("Failed with broadcasting eth_sendRawTransaction. errmsg: " + errmsg);
+			ret["errmsg"] = errmsg;
+		}
+	}
+
+	if (finished) {
+		for (int i = 0; i < count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(job->tasks[i]);
+		}
+		memdelete(job);
+	} else {
+		m_running.push_back(job);
+	}
+	return ret;
+}
+
+void TxBroadcaster::_bind_methods() {
+	ClassDB::bind_static_method("TxBroadcaster", D_METHOD("is_already_known", "message"), &TxBroadcaster::is_already_known);
+	ClassDB::bind_method(D_METHOD("set_urls", "urls"), &TxBroadcaster::set_urls);
+	ClassDB::bind_method(D_METHOD("get_urls"), &TxBroadcaster::get_urls);
+	ClassDB::bind_method(D_METHOD("set_timeout_ms", "timeout_ms"), &TxBroadcaster::set_timeout_ms);
+	ClassDB::bind_method(D_METHOD("get_timeout_ms"), &TxBroadcaster::get_timeout_ms);
+	ClassDB::bind_method(D_METHOD("broadcast", "signed_tx", "id"), &TxBroadcaster::broadcast, DEFVAL(""));
+}
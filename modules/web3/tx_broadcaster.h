@@ -0,0 +1,78 @@
+#ifndef TX_BROADCASTER_H
+#define TX_BROADCASTER_H
+
+#include "core/error/error_macros.h"
+#include "core/object/ref_counted.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+#include "jsonrpc_helper.h"
+
+/**
+ * @brief Sends a signed transaction to several JSON-RPC endpoints at once.
+ *
+ *        Every endpoint gets its own eth_sendRawTransaction call on the
+ *        WorkerThreadPool, broadcast() returns as soon as one of them accepts
+ *        the transaction. An "already known" error counts as accepted: the
+ *        node has the transaction, most likely from another endpoint.
+ *        Calls still running are collected by later broadcasts or on
+ *        destruction.
+ */
+class TxBroadcaster : public RefCounted {
+	GDCLASS(TxBroadcaster, RefCounted);
+
+public:
+	struct Job;
+
+private:
+	PackedStringArray m_urls;
+	LocalVector<Ref<JsonrpcHelper>> m_helpers;
+	int m_timeout_ms = 20000;
+	uint32_t m_req_id = 0;
+
+	// Jobs that returned before all their calls finished.
+	LocalVector<Job *> m_running;
+
+	void _collect(bool p_wait);
+
+protected:
+	static void _bind_methods();
+
+public:
+	TxBroadcaster() {}
+	~TxBroadcaster();
+
+	/**
+	 * @brief Parses an RPC url into a JsonrpcHelper (host, port and path).
+	 * @return False if the url is not http(s)://host[:port][/path].
+	 */
+	static bool configure_helper(const Ref<JsonrpcHelper> &helper, const String &url);
+
+	/**
+	 * @brief True if a JSON-RPC error message means the node already has the transaction.
+	 */
+	static bool is_already_known(const String &message);
+
+	void set_urls(const PackedStringArray &urls);
+	PackedStringArray get_urls() const;
+
+	void set_timeout_ms(int timeout_ms);
+	int get_timeout_ms() const;
+
+	/**
+	 * @brief Broadcasts a signed transaction.
+	 * @param signed_tx Signed transaction hex string with 0x prefix.
+	 * @param id JSON-RPC request id, a counter value when empty.
+	 * @return Same keys as Optimism.send_transaction ("success", "errmsg",
+	 *         "txhash") plus "endpoint", the url that accepted it, and
+	 *         "already_known". On failure "errmsg" lists the error of every endpoint.
+	 */
+	Dictionary broadcast(const String &signed_tx, const Variant &id = "");
+};
+
+#endif // TX_BROADCASTER_H
@@ -2,6 +2,9 @@
 
 
 Ref<Optimism> Web3::get_op_instance() {
+	if (m_op.is_null()) {
+		m_op = Ref<Optimism>(memnew(Optimism));
+	}
 	return m_op;
 }
 
@@ -10,7 +13,6 @@ void Web3::_bind_methods() {
 }
 
 Web3::Web3() {
-    m_op = Ref<Optimism>(memnew(Optimism));
 }
 
 Web3::~Web3() {
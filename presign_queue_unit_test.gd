@@ -0,0 +1,88 @@
+extends Label
+
+const PRIVATE_KEY = "37e17f7c0e6d14ad7bf694051b84b2572d638d875b0bb745bb151754de838d00"
+
+func _big(value: String) -> BigInt:
+	var number = BigInt.new()
+	number.from_string(value)
+	return number
+
+func _new_queue(account: EthAccount) -> PresignQueue:
+	var queue = PresignQueue.new()
+	queue.set_account(account)
+	queue.set_chain_id(_big("31337"))
+	queue.set_to_address("0x3535353535353535353535353535353535353535")
+	queue.set_value(_big("1000000000000000000"))
+	queue.set_gas_price(_big("20000000000"))
+	queue.set_gas_limit(21000)
+	queue.set_depth(4)
+	queue.set_nonce_base(1000)
+	return queue
+
+func _expected_raw(account: EthAccount, nonce: int, gas_price: String) -> String:
+	var tx = LegacyTx.new()
+	tx.set_nonce(nonce)
+	tx.set_gas_price(_big(gas_price))
+	tx.set_gas_limit(21000)
+	tx.set_value(_big("1000000000000000000"))
+	tx.set_chain_id(_big("31337"))
+	tx.set_to_address("0x3535353535353535353535353535353535353535")
+	tx.sign_tx_by_account(account)
+	return tx.signedtx_marshal_binary()
+
+# The test case
+func test_expected_behavior():
+	print("------> start test presign queue <------")
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var queue = _new_queue(account)
+
+	assert(queue.refill() == 4, "refill should sign the whole window")
+	var entry = queue.take()
+	assert(entry["nonce"] == 1000, "take nonce incorrect")
+	assert(entry["raw"] == _expected_raw(account, 1000, "20000000000"), "presigned transaction differs from LegacyTx")
+	assert(queue.get_nonce_base() == 1001, "take should advance the nonce base")
+	assert(queue.get_ready_count() == 3, "ready count incorrect after take")
+	print("pass: refill and take")
+
+	# Fee change: everything is signed again at the new price.
+	queue.set_gas_price(_big("30000000000"))
+	assert(queue.get_ready_count() == 0, "gas price change should drop the signed entries")
+	queue.refill()
+	assert(queue.take()["raw"] == _expected_raw(account, 1001, "30000000000"), "entry not re-signed with the new gas price")
+
+	# Nonce base moved by a transaction sent elsewhere: entries in the window stay.
+	queue.refill()
+	queue.set_nonce_base(1004)
+	assert(queue.get_ready_count() == 2, "entries still in the window should be kept")
+	print("pass: invalidation")
+
+	assert(queue.start() == OK, "start failed")
+	var deadline = Time.get_ticks_msec() + 5000
+	while queue.get_ready_count() < 4 and Time.get_ticks_msec() < deadline:
+		OS.delay_msec(1)
+	assert(queue.get_ready_count() == 4, "background thread did not fill the window")
+	queue.stop()
+	assert(not queue.is_running(), "stop failed")
+	print("pass: background signing")
+	print("------> test presign queue done <------")
+	pass
+
+func test_unexpected_behavior():
+	var queue = PresignQueue.new()
+	assert(queue.take().is_empty(), "empty queue should not hand out transactions")
+	assert(queue.refill() == 0, "queue without account should not sign")
+	queue.set_account(EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode()))
+	queue.set_nonce_base(0)
+	assert(queue.refill() == 0, "queue without chain id should not sign")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
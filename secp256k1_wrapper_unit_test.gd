@@ -53,11 +53,102 @@ func test_expected_behavior():
 	var verify_result = secp256k1.verify(data.sha256_buffer(), signature)
 	assert(verify_result, "verify failed!")
 	print("pass: verify success!")
+
+	# all wrappers share one context, its blinding is refreshed while signing
+	var other = Secp256k1Wrapper.new()
+	other.set_secret_key(set_sec_key)
+	for i in range(2100):
+		signature = other.sign(data.sha256_buffer())
+		assert(signature.hex_encode() == right_sign, "sign changed after context re-randomization!")
+	assert(secp256k1.verify(data.sha256_buffer(), signature), "verify with shared context failed!")
+	print("pass: shared context sign stable across re-randomization!")
+
+	# batch verify and recover, large enough to run on the worker pool
+	var hashes = PackedByteArray()
+	var sigs = PackedByteArray()
+	var pubkeys = PackedByteArray()
+	for i in range(32):
+		var h = ("move " + str(i)).sha256_buffer()
+		hashes.append_array(h)
+		sigs.append_array(secp256k1.sign(h))
+		pubkeys.append_array(secp256k1.get_public_key())
+	var flags = Secp256k1Wrapper.verify_batch(hashes, sigs, pubkeys)
+	assert(flags.size() == 32 and flags.count(1) == 32, "verify_batch failed!")
+	var addresses = Secp256k1Wrapper.recover_addresses_batch(hashes, sigs)
+	assert(addresses.size() == 32 * 20, "recover_addresses_batch size wrong!")
+	for i in range(32):
+		assert(addresses.slice(i * 20, i * 20 + 20).hex_encode() == "5aad065de89d41a925ca5839efd0e4567ceef933", "recover_addresses_batch address wrong!")
+	print("pass: verify_batch and recover_addresses_batch success!")
+
+	# cached public key table gives the same results
+	assert(Secp256k1Wrapper.cache_public_key(secp256k1.get_public_key()), "cache_public_key failed!")
+	assert(Secp256k1Wrapper.is_public_key_cached(secp256k1.get_public_key()), "public key not cached!")
+	flags = Secp256k1Wrapper.verify_batch(hashes, sigs, pubkeys)
+	assert(flags.count(1) == 32, "verify_batch with cached table failed!")
+	assert(secp256k1.verify(data.sha256_buffer(), right_sign.hex_decode()), "verify with cached table failed!")
+	assert(Secp256k1Wrapper.uncache_public_key(secp256k1.get_public_key()), "uncache_public_key failed!")
+	assert(Secp256k1Wrapper.get_cached_public_key_count() == 0, "cache not empty!")
+	print("pass: cached public key table verify success!")
+
+	# repeated recoveries are served by the signer cache
+	Secp256k1Wrapper.clear_signer_cache()
+	Secp256k1Wrapper.recover_addresses_batch(hashes, sigs)
+	assert(Secp256k1Wrapper.get_signer_cache_misses() == 32 and Secp256k1Wrapper.get_signer_cache_hits() == 0, "signer cache counted wrong on first pass!")
+	assert(Secp256k1Wrapper.recover_addresses_batch(hashes, sigs) == addresses, "cached recover_addresses_batch differs!")
+	assert(Secp256k1Wrapper.get_signer_cache_hits() == 32, "signer cache missed repeated signatures!")
+	assert(secp256k1.recover_pubkey(hashes.slice(0, 32), sigs.slice(0, 65)) == secp256k1.get_public_key(), "cached recover_pubkey differs!")
+	assert(Secp256k1Wrapper.get_signer_cache_hits() == 33, "recover_pubkey did not use the signer cache!")
+	Secp256k1Wrapper.set_signer_cache_capacity(8)
+	assert(Secp256k1Wrapper.get_signer_cache_size() == 8, "signer cache over capacity!")
+	Secp256k1Wrapper.set_signer_cache_capacity(0)
+	Secp256k1Wrapper.recover_addresses_batch(hashes, sigs)
+	assert(Secp256k1Wrapper.get_signer_cache_hits() == 33, "disabled signer cache still hit!")
+	Secp256k1Wrapper.set_signer_cache_capacity(4096)
+	Secp256k1Wrapper.clear_signer_cache()
+	print("pass: signer cache hit and miss counters!")
 	print("------> test secp256kq wrapper expected behavior done <------")
 	pass
 
 func test_unexpected_behavior():
-	pass
+	print("------> start test secp256k1 wrapper unexpected behavior <------")
+	var secp256k1 = Secp256k1Wrapper.new()
+	secp256k1.set_secret_key("37e17f7c0e6d14ad7bf694051b84b2572d638d875b0bb745bb151754de838d00")
+	secp256k1.compute_public_key_from_seckey()
+	var h1 = "a".sha256_buffer()
+	var h2 = "b".sha256_buffer()
+	var hashes = h1 + h2
+	var sigs = secp256k1.sign(h1) + secp256k1.sign(h1)
+	var flags = Secp256k1Wrapper.verify_batch(hashes, sigs, secp256k1.get_public_key() + secp256k1.get_public_key())
+	assert(flags[0] == 1 and flags[1] == 0, "verify_batch accepted a signature over another hash!")
+	sigs[129] = 7
+	var addresses = Secp256k1Wrapper.recover_addresses_batch(hashes, sigs)
+	assert(addresses.slice(20, 40).count(0) == 20, "bad recovery id not rejected!")
+	assert(Secp256k1Wrapper.verify_batch(hashes, sigs, PackedByteArray()).is_empty(), "mismatched sizes not rejected!")
+	print("pass: batch apis reject bad input!")
+
+	# cached table rejects what the generic path rejects
+	var pub = secp256k1.get_public_key()
+	Secp256k1Wrapper.cache_public_key(pub)
+	flags = Secp256k1Wrapper.verify_batch(hashes, secp256k1.sign(h1) + secp256k1.sign(h1), pub + pub)
+	assert(flags[0] == 1 and flags[1] == 0, "cached table accepted a signature over another hash!")
+	assert(not Secp256k1Wrapper.cache_public_key("04aa".hex_decode()), "invalid public key cached!")
+
+	# least recently used tables are dropped over budget
+	var budget = Secp256k1Wrapper.get_public_key_cache_budget()
+	Secp256k1Wrapper.set_public_key_cache_budget(Secp256k1Wrapper.get_public_key_table_size() * 2)
+	var other = Secp256k1Wrapper.new()
+	for i in range(3):
+		other.generate_key_pair()
+		other.compute_public_key_from_seckey()
+		Secp256k1Wrapper.cache_public_key(other.get_public_key())
+	assert(Secp256k1Wrapper.get_cached_public_key_count() == 2, "cache over budget!")
+	assert(not Secp256k1Wrapper.is_public_key_cached(pub), "least recently used key not evicted!")
+	Secp256k1Wrapper.set_public_key_cache_budget(0)
+	assert(Secp256k1Wrapper.get_cached_public_key_count() == 0, "zero budget keeps tables!")
+	assert(not Secp256k1Wrapper.cache_public_key(pub), "table cached over budget!")
+	Secp256k1Wrapper.set_public_key_cache_budget(budget)
+	print("pass: public key cache budget respected!")
+	print("------> test secp256k1 wrapper unexpected behavior done <------")
 
 # Run the test case
 func _ready() -> void:
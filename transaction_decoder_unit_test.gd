@@ -0,0 +1,59 @@
+extends Label
+
+const SIGNED_LEGACY_TX = "f8708203e88504a817c800825204943535353535353535353535353535353535353535880de0b6b3a76400000182f4f6a06564d364f0e020e351466f4005209a376d15dfba0234e712a8f7fffe801247a8a025bede6451fd2a5a6f44ae791e1729bd4e46cb05bc4e62028c23e541b9b84f8b"
+const EIP155_EXAMPLE_TX = "f86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83"
+
+# The test case
+func test_expected_behavior():
+	print("------> start test transaction decoder <------")
+	var tx = LegacyTx.from_raw(SIGNED_LEGACY_TX.hex_decode())
+	assert(tx != null, "from_raw failed!")
+	assert(tx.get_nonce() == 1000, "from_raw nonce incorrect")
+	assert(tx.get_gas_price().get_string() == "20000000000", "from_raw gas price incorrect")
+	assert(tx.get_gas_limit() == 20996, "from_raw gas limit incorrect")
+	assert(tx.get_to_address() == "0x3535353535353535353535353535353535353535", "from_raw to address incorrect")
+	assert(tx.get_chain_id().get_string() == "31337", "from_raw chain id incorrect")
+	assert(tx.signedtx_marshal_binary() == "0x" + SIGNED_LEGACY_TX, "from_raw round trip failed!")
+	assert(tx.recover_sender() == "0x5aad065de89d41a925ca5839efd0e4567ceef933", "recover_sender failed!")
+	print("pass: LegacyTx.from_raw")
+
+	var decoded = TransactionDecoder.decode(EIP155_EXAMPLE_TX.hex_decode(), true)
+	assert(decoded["type"] == 0, "decode type incorrect")
+	assert(decoded["nonce"] == 9, "decode nonce incorrect")
+	assert(decoded["chainId"].get_string() == "1", "decode chain id incorrect")
+	assert(decoded["value"].get_string() == "1000000000000000000", "decode value incorrect")
+	assert(decoded["from"] == "0x9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f", "decode sender incorrect")
+	print("pass: decode")
+
+	var raws = []
+	for i in range(16):
+		raws.append(SIGNED_LEGACY_TX.hex_decode() if i % 2 == 0 else EIP155_EXAMPLE_TX.hex_decode())
+	var senders = TransactionDecoder.recover_senders(raws)
+	assert(senders.size() == 16, "recover_senders size incorrect")
+	assert(senders[0] == "0x5aad065de89d41a925ca5839efd0e4567ceef933", "recover_senders failed!")
+	assert(senders[15] == "0x9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f", "recover_senders failed!")
+	print("pass: recover_senders")
+
+	print("------> test transaction decoder done <------")
+	pass
+
+func test_unexpected_behavior():
+	assert(LegacyTx.from_raw("c0".hex_decode()) == null, "empty list should fail")
+	assert(TransactionDecoder.recover_sender("8105".hex_decode()) == "", "non-canonical encoding should fail")
+	# 0x00 is not a transaction type, bare or wrapped in an RLP string
+	var type_zero = "00" + EIP155_EXAMPLE_TX
+	assert(TransactionDecoder.decode(type_zero.hex_decode()).is_empty(), "type 0x00 envelope should fail")
+	assert(TransactionDecoder.recover_sender(type_zero.hex_decode()) == "", "type 0x00 envelope should not recover")
+	assert(TransactionDecoder.decode(("b86f" + type_zero).hex_decode()).is_empty(), "wrapped type 0x00 envelope should fail")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
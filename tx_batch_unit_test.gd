@@ -0,0 +1,85 @@
+extends Label
+
+const PRIVATE_KEY = "37e17f7c0e6d14ad7bf694051b84b2572d638d875b0bb745bb151754de838d00"
+
+func _big(value: String) -> BigInt:
+	var number = BigInt.new()
+	number.from_string(value)
+	return number
+
+func _new_batch() -> TxBatch:
+	var batch = TxBatch.new()
+	batch.set_chain_id(_big("31337"))
+	batch.set_gas_price(_big("20000000000"))
+	batch.set_gas_limit(21000)
+	return batch
+
+func _build_tx(nonce: int) -> LegacyTx:
+	var tx = LegacyTx.new()
+	tx.set_nonce(nonce)
+	tx.set_gas_price(_big("20000000000"))
+	tx.set_gas_limit(21000)
+	tx.set_value(_big("1000000000000000000"))
+	tx.set_chain_id(_big("31337"))
+	tx.set_to_address("0x3535353535353535353535353535353535353535")
+	return tx
+
+# The test case
+func test_expected_behavior():
+	print("------> start test tx batch <------")
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var batch = _new_batch()
+
+	var addresses = PackedStringArray()
+	var values = []
+	for i in range(1000):
+		addresses.append("0x3535353535353535353535353535353535353535")
+		values.append(_big("1000000000000000000"))
+	assert(batch.add_transfers(addresses, values, 1000) == 1000, "add_transfers count incorrect")
+	assert(batch.size() == 1000, "batch size incorrect")
+	assert(batch.get_nonce(999) == 1999, "nonces should be consecutive")
+
+	assert(batch.sign(account) == 1000, "sign count incorrect")
+	for i in [0, 500, 999]:
+		var expected = _build_tx(1000 + i)
+		assert(expected.sign_tx_by_account(account) == 0, "sign_tx_by_account failed!")
+		assert(batch.get_raw(i) == expected.signedtx_marshal_binary(), "batch encoding differs from LegacyTx")
+		assert(batch.get_hash(i) == expected.hash(), "batch hash differs from LegacyTx")
+		assert(batch.get_transaction(i).signedtx_marshal_binary() == expected.signedtx_marshal_binary(), "get_transaction round trip failed")
+	print("pass: add_transfers and sign")
+
+	var clone = batch.clone_with_nonce(0, 5000)
+	assert(batch.get_nonce(clone) == 5000, "clone nonce incorrect")
+	assert(not batch.is_signed(clone), "clone should not keep the signature")
+	assert(batch.get_to_address(clone) == batch.get_to_address(0), "clone fields incorrect")
+	assert(batch.sign(account) == 1, "only the clone should be signed")
+	var senders = TransactionDecoder.recover_senders([batch.get_raw(clone).substr(2).hex_decode()])
+	assert(senders[0] == "0x" + account.get_address().hex_encode(), "clone sender incorrect")
+	print("pass: clone_with_nonce")
+
+	var index = batch.add_transaction(_build_tx(42))
+	assert(batch.get_nonce(index) == 42, "add_transaction nonce incorrect")
+	assert(batch.get_raw_transactions().size() == batch.size(), "get_raw_transactions size incorrect")
+	batch.clear()
+	assert(batch.size() == 0 and batch.get_memory_usage() == 0, "clear should release the arena")
+	print("------> test tx batch done <------")
+	pass
+
+func test_unexpected_behavior():
+	var batch = _new_batch()
+	assert(batch.add("0x1234", _big("1"), 0) == -1, "invalid address should be rejected")
+	assert(batch.add_transfers(PackedStringArray(["0x3535353535353535353535353535353535353535"]), [], 0) == 0, "mismatched values should be rejected")
+	assert(batch.get_raw(0) == "", "out of range index should return empty")
+	assert(batch.add_transaction(LegacyTx.new()) == -1, "transaction without fields should be rejected")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
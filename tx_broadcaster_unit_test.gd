@@ -0,0 +1,48 @@
+extends Label
+
+const SIGNED_TX = "0xf8708203e88504a817c800825204943535353535353535353535353535353535353535880de0b6b3a76400000182f4f6a06564d364f0e020e351466f4005209a376d15dfba0234e712a8f7fffe801247a8a025bede6451fd2a5a6f44ae791e1729bd4e46cb05bc4e62028c23e541b9b84f8b"
+
+# The test case
+func test_expected_behavior():
+	print("------> start test tx broadcaster <------")
+	assert(TxBroadcaster.is_already_known("already known"), "geth message not recognized")
+	assert(TxBroadcaster.is_already_known("ALREADY_EXISTS: already known"), "erigon message not recognized")
+	assert(TxBroadcaster.is_already_known("known transaction: 0x1234"), "besu message not recognized")
+	assert(TxBroadcaster.is_already_known("AlreadyKnown"), "nethermind message not recognized")
+	assert(not TxBroadcaster.is_already_known("nonce too low"), "nonce too low is not already known")
+	print("pass: is_already_known")
+
+	var broadcaster = TxBroadcaster.new()
+	broadcaster.set_urls(PackedStringArray(["https://optimism.llamarpc.com", "http://127.0.0.1:8545/rpc", "not a url"]))
+	assert(broadcaster.get_urls().size() == 2, "invalid url should be skipped")
+
+	var op = Optimism.new()
+	op.set_rpc_url("https://optimism.llamarpc.com")
+	op.set_broadcast_urls(PackedStringArray(["https://mainnet.optimism.io", "https://optimism.llamarpc.com"]))
+	assert(op.get_broadcast_urls().size() == 2, "broadcast urls not stored")
+	print("------> test tx broadcaster done <------")
+	pass
+
+func test_unexpected_behavior():
+	var broadcaster = TxBroadcaster.new()
+	assert(broadcaster.broadcast(SIGNED_TX)["success"] == false, "broadcast without endpoints should fail")
+
+	# Nothing listens on these ports, every endpoint fails and reports its error.
+	broadcaster.set_urls(PackedStringArray(["http://127.0.0.1:1", "http://127.0.0.1:2"]))
+	broadcaster.set_timeout_ms(2000)
+	var result = broadcaster.broadcast(SIGNED_TX)
+	assert(result["success"] == false, "unreachable endpoints should fail")
+	assert(result["errmsg"].contains("127.0.0.1:1") and result["errmsg"].contains("127.0.0.1:2"), "errmsg should list every endpoint")
+	assert(broadcaster.broadcast("0xzz")["success"] == false, "invalid hex should fail")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
@@ -0,0 +1,142 @@
+extends Label
+
+const PRIVATE_KEY = "37e17f7c0e6d14ad7bf694051b84b2572d638d875b0bb745bb151754de838d00"
+# go-ethereum's signed EIP-2930 test transaction (TestEIP2718TransactionEncode).
+const GETH_ACCESS_LIST_TX = "01f8630103018261a894b94f5374fce5edbc8e2a8697c15331677e6ebf0b0a825544c001a0c9519f4f2b30335884581971573fadf60c6204f59a911df35ee8a540456b2660a032f1e8e2c5dd761f9e4f88f41c8310aeaba26a8bfcdacfedfa12ec3862d37521"
+# EIP-1559 transaction signed with go-ethereum's test key by an independent
+# implementation of the specification (RFC 6979 nonces).
+const GETH_TEST_KEY = "b71c71a67e1177ad4e901695e1b4b9ee17ae16c6668d313eac2f96dbcda3f291"
+const REFERENCE_DYNAMIC_FEE_TX = "02f8ad0103843b9aca008506fc23ac0082520894b94f5374fce5edbc8e2a8697c15331677e6ebf0b872386f26fc10000825544f838f794b94f5374fce5edbc8e2a8697c15331677e6ebf0be1a0000000000000000000000000000000000000000000000000000000000000000180a09de9c03c2257dc40d4b2e278112dd324c59dfc08b5d6c165fa0f711dcf469a4ba072ebab12d285315cca690cb90d8fdf8e1c4750f208188f55ce1cfb4ce8ffa550"
+
+const ACCESS_LIST = [{
+	"address": "0x1111111111111111111111111111111111111111",
+	"storageKeys": ["0x0000000000000000000000000000000000000000000000000000000000000001"],
+}]
+
+func _big(value: String) -> BigInt:
+	var number = BigInt.new()
+	number.from_string(value)
+	return number
+
+func _fill_common(tx):
+	tx.set_chain_id(_big("10"))
+	tx.set_nonce(7)
+	tx.set_gas_limit(50000)
+	tx.set_to_address("0x3535353535353535353535353535353535353535")
+	tx.set_value(_big("1000000000000000000"))
+	tx.set_data("a9059cbb".hex_decode())
+	tx.set_access_list(ACCESS_LIST)
+
+# The test case
+func test_expected_behavior():
+	print("------> start test typed transaction <------")
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var sender = "0x" + account.get_address().hex_encode()
+
+	var dynamic_tx = DynamicFeeTx.new()
+	_fill_common(dynamic_tx)
+	dynamic_tx.set_max_priority_fee_per_gas(_big("1000000"))
+	dynamic_tx.set_max_fee_per_gas(_big("2000000000"))
+	assert(dynamic_tx.get_tx_type() == 2, "DynamicFeeTx type incorrect")
+	assert(dynamic_tx.rlp_encode()[0] == 2, "signing payload should start with the type byte")
+	assert(dynamic_tx.sign_tx_by_account(account) == 0, "sign_tx_by_account failed!")
+	assert(dynamic_tx.recover_sender() == sender, "DynamicFeeTx sender incorrect")
+
+	var raw = dynamic_tx.signedtx_marshal_binary()
+	var decoded = DynamicFeeTx.from_raw(raw.substr(2).hex_decode())
+	assert(decoded.signedtx_marshal_binary() == raw, "DynamicFeeTx round trip failed")
+	assert(decoded.get_max_fee_per_gas().get_string() == "2000000000", "max fee per gas incorrect")
+	assert(decoded.get_access_list() == ACCESS_LIST, "access list round trip failed")
+	assert(decoded.hash() == dynamic_tx.hash(), "tx hash differs after decoding")
+
+	var fields = TransactionDecoder.decode(raw.substr(2).hex_decode(), true)
+	assert(fields["type"] == 2, "decoder type incorrect")
+	assert(fields["from"] == sender, "decoder sender incorrect")
+	print("pass: DynamicFeeTx")
+
+	var access_tx = AccessListTx.new()
+	_fill_common(access_tx)
+	access_tx.set_gas_price(_big("20000000000"))
+	assert(access_tx.sign_tx_by_account(account) == 0, "sign_tx_by_account failed!")
+	raw = access_tx.signedtx_marshal_binary()
+	assert(raw.begins_with("0x01"), "AccessListTx envelope type incorrect")
+	decoded = AccessListTx.from_raw(raw.substr(2).hex_decode())
+	assert(decoded.signedtx_marshal_binary() == raw, "AccessListTx round trip failed")
+	assert(TransactionDecoder.recover_sender(raw.substr(2).hex_decode()) == sender, "AccessListTx sender incorrect")
+	print("pass: AccessListTx")
+
+	# Changing a field must drop the cached encodings and the signature.
+	var signing_hash = decoded.rlp_hash()
+	decoded.set_nonce(8)
+	assert(decoded.rlp_hash() != signing_hash, "signing hash not updated after set_nonce")
+	assert(decoded.signedtx_marshal_binary() == "", "stale signature kept after set_nonce")
+	assert(decoded.hash().is_empty(), "unsigned transaction has a hash")
+	assert(decoded.get_sign_r().get_string() == "0" and decoded.get_sign_s().get_string() == "0", "stale r, s kept after set_nonce")
+	assert(decoded.sign_tx_by_account(account) == 0, "re-signing failed!")
+	assert(decoded.recover_sender() == sender, "re-signed sender incorrect")
+	print("pass: field change drops the signature")
+
+	# External vectors
+	var geth_tx = AccessListTx.from_raw(GETH_ACCESS_LIST_TX.hex_decode())
+	assert(geth_tx != null, "go-ethereum AccessListTx not decoded")
+	assert(geth_tx.get_chain_id().get_string() == "1" and geth_tx.get_nonce() == 3, "go-ethereum AccessListTx fields incorrect")
+	assert(geth_tx.get_gas_price().get_string() == "1" and geth_tx.get_gas_limit() == 25000, "go-ethereum AccessListTx gas incorrect")
+	assert(geth_tx.get_to_address() == "0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b", "go-ethereum AccessListTx to incorrect")
+	assert(geth_tx.get_value().get_string() == "10" and geth_tx.get_data().hex_encode() == "5544", "go-ethereum AccessListTx value incorrect")
+	assert(geth_tx.rlp_hash().hex_encode() == "49b486f0ec0a60dfbbca2d30cb07c9e8ffb2a2ff41f29a1ab6737475f6ff69f3", "go-ethereum AccessListTx signing hash incorrect")
+	assert(geth_tx.signedtx_marshal_binary() == "0x" + GETH_ACCESS_LIST_TX, "go-ethereum AccessListTx round trip failed")
+	assert(geth_tx.hash().hex_encode() == "d900408d8fec1ffdb3e360685f94400b2ef6e1211ac0f98abbaa140e1a73683a", "go-ethereum AccessListTx hash incorrect")
+	assert(geth_tx.recover_sender() == "0x27cf7d8449c9da59189427619ba59f985cee9c0f", "go-ethereum AccessListTx sender incorrect")
+
+	var reference_tx = DynamicFeeTx.from_raw(REFERENCE_DYNAMIC_FEE_TX.hex_decode())
+	assert(reference_tx != null, "reference DynamicFeeTx not decoded")
+	assert(reference_tx.get_max_priority_fee_per_gas().get_string() == "1000000000", "reference priority fee incorrect")
+	assert(reference_tx.get_max_fee_per_gas().get_string() == "30000000000", "reference fee cap incorrect")
+	assert(reference_tx.get_value().get_string() == "10000000000000000", "reference value incorrect")
+	assert(reference_tx.get_access_list().size() == 1, "reference access list incorrect")
+	assert(reference_tx.rlp_hash().hex_encode() == "f41a6fd93e6987e5f13b45cf9bfa88647f398b16002212bbd610ccbbca306977", "reference signing hash incorrect")
+	assert(reference_tx.hash().hex_encode() == "08723e6af619f8f4b67d3d2a761fba45cc5150e0a97e3b061647a9eb69d0a65f", "reference hash incorrect")
+	assert(reference_tx.recover_sender() == "0x71562b71999873db5b286df957af199ec94617f7", "reference sender incorrect")
+
+	# Signing the same fields here gives the same bytes.
+	var rebuilt = DynamicFeeTx.new()
+	rebuilt.set_chain_id(_big("1"))
+	rebuilt.set_nonce(3)
+	rebuilt.set_max_priority_fee_per_gas(_big("1000000000"))
+	rebuilt.set_max_fee_per_gas(_big("30000000000"))
+	rebuilt.set_gas_limit(21000)
+	rebuilt.set_to_address("0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b")
+	rebuilt.set_value(_big("10000000000000000"))
+	rebuilt.set_data("5544".hex_decode())
+	rebuilt.set_access_list([{
+		"address": "0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b",
+		"storageKeys": ["0x0000000000000000000000000000000000000000000000000000000000000001"],
+	}])
+	assert(rebuilt.sign_tx_by_account(EthAccountManager.privateKeyToAccount(GETH_TEST_KEY.hex_decode())) == 0, "signing reference fields failed")
+	assert(rebuilt.signedtx_marshal_binary() == "0x" + REFERENCE_DYNAMIC_FEE_TX, "signed DynamicFeeTx differs from the reference")
+	print("pass: external vectors")
+	print("------> test typed transaction done <------")
+	pass
+
+func test_unexpected_behavior():
+	var account = EthAccountManager.privateKeyToAccount(PRIVATE_KEY.hex_decode())
+	var dynamic_tx = DynamicFeeTx.new()
+	assert(dynamic_tx.sign_tx_by_account(account) != 0, "zero chain id should not be signed")
+	dynamic_tx.set_access_list([{"address": "0x1234", "storageKeys": []}])
+	assert(dynamic_tx.get_access_list().is_empty(), "invalid access list should be rejected")
+
+	var legacy = "f8708203e88504a817c800825204943535353535353535353535353535353535353535880de0b6b3a76400000182f4f6a06564d364f0e020e351466f4005209a376d15dfba0234e712a8f7fffe801247a8a025bede6451fd2a5a6f44ae791e1729bd4e46cb05bc4e62028c23e541b9b84f8b"
+	assert(DynamicFeeTx.from_raw(legacy.hex_decode()) == null, "legacy transaction decoded as DynamicFeeTx")
+	assert(AccessListTx.from_raw(PackedByteArray([1, 0xc0])) == null, "truncated AccessListTx decoded")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass
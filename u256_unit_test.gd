@@ -0,0 +1,78 @@
+extends Label
+
+# The test case
+func test_expected_behavior():
+	print("------> start test u256 operations <------")
+	var a = U256.new()
+	a.from_string("12345678901234567890")
+	var b = U256.new()
+	b.from_string("98765432109876543210")
+
+	var sum = a.add(b)
+	assert(sum.get_string() == "111111111011111111100", "sum operation failed!")
+	print("pass: sum operation")
+
+	var mul = a.mul(b)
+	assert(mul.get_string() == "1219326311370217952237463801111263526900", "mul operation failed!")
+	print("pass: mul operation")
+
+	var mod = b.mod(a)
+	assert(mod.get_string() == "900000000090", "mod operation failed!")
+	print("pass: mod operation")
+
+	# wrapping and checked arithmetic
+	var max = U256.new()
+	max.from_hex("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff")
+	var one = U256.new()
+	one.from_int(1)
+	assert(max.add(one).is_zero(), "wrapping add failed!")
+	assert(max.checked_add(one) == null, "checked add failed!")
+	assert(a.checked_sub(b) == null, "checked sub failed!")
+	print("pass: wrapping and checked operations")
+
+	# 32-byte big-endian import/export
+	var bytes = one.to_bytes()
+	assert(bytes.size() == 32 && bytes[31] == 1, "to_bytes failed!")
+	var c = U256.new()
+	c.set_bytes(bytes)
+	assert(c.cmp(one) == 0, "set_bytes failed!")
+	print("pass: bytes round trip")
+
+	# BigInt interop
+	var big = a.to_big_int()
+	assert(big.get_string() == a.get_string(), "to_big_int failed!")
+	var d = U256.new()
+	d.from_big_int(big)
+	assert(d.cmp(a) == 0, "from_big_int failed!")
+	print("pass: BigInt interop")
+
+	# signed values
+	var x = I256.new()
+	x.from_string("-7")
+	var y = I256.new()
+	y.from_int(2)
+	assert(x.div(y).get_string() == "-3", "signed div failed!")
+	assert(x.mod(y).get_string() == "-1", "signed mod failed!")
+	assert(x.to_bytes()[0] == 0xff, "signed to_bytes failed!")
+	assert(x.to_big_int().get_string() == "-7", "signed to_big_int failed!")
+	print("pass: signed operations")
+
+	print("------> test u256 operations done <------")
+	pass
+
+func test_unexpected_behavior():
+	var a = U256.new()
+	assert(a.from_string("-1") == false, "negative string should fail")
+	assert(a.from_string("115792089237316195423570985008687907853269984665640564039457584007913129639936") == false, "overflow should fail")
+	pass
+
+
+# Called when the node enters the scene tree for the first time.
+func _ready() -> void:
+	test_expected_behavior()
+	test_unexpected_behavior()
+	pass
+
+# Called every frame. 'delta' is the elapsed time since the previous frame.
+func _process(delta: float) -> void:
+	pass